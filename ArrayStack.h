@@ -11,20 +11,63 @@
 #include "StackADT.h"
 
 //Unless spesificed by the stack user, the default size is 100
+//the array doubles its size whenever it becomes full, so push only fails when memory runs out
 template<typename T>
 class ArrayStack : public StackADT<T>
 {
 	enum { MAX_SIZE = 100 };
 private:
-	T items[MAX_SIZE];		// Array of stack items
+	T* items;				// Array of stack items
+	int capacity;			// Current size of the array
 	int top;                // Index to top of stack
-	
+
+	//doubles the array size, keeping the current entries
+	void grow()
+	{
+		T* bigger = new T[capacity * 2]{};
+		for (int i = 0; i <= top; i++)
+			bigger[i] = items[i];
+
+		delete[] items;
+		items = bigger;
+		capacity *= 2;
+	}
+
 public:
 
-	ArrayStack() : items{} ,top(-1)
+	ArrayStack(int size = MAX_SIZE) : capacity((size > 0) ? size : MAX_SIZE), top(-1)
 	{
+		items = new T[capacity]{};
 	}  // end default constructor
 
+	ArrayStack(const ArrayStack<T>& other) : capacity(other.capacity), top(other.top)
+	{
+		items = new T[capacity]{};
+		for (int i = 0; i <= top; i++)
+			items[i] = other.items[i];
+	}  // end copy constructor
+
+	ArrayStack<T>& operator=(const ArrayStack<T>& other)
+	{
+		if (this == &other)
+			return *this;
+
+		T* copy = new T[other.capacity]{};
+		for (int i = 0; i <= other.top; i++)
+			copy[i] = other.items[i];
+
+		delete[] items;
+		items = copy;
+		capacity = other.capacity;
+		top = other.top;
+		return *this;
+	}  // end assignment
+
+	~ArrayStack()
+	{
+		delete[] items;
+	}  // end destructor
+
 	bool isEmpty() const
 	{
 		return (top == -1)? true : false;
@@ -32,30 +75,39 @@ public:
 
 	bool push(const T& newEntry)
 	{
-		if( top == MAX_SIZE-1 ) return false;	//Stack is FULL
+		if( top == capacity-1 ) grow();	//Stack is FULL
 
 		top++;
-		items[top] = newEntry;   
+		items[top] = newEntry;
 		return true;
 	}  // end push
 
 	bool pop(T& TopEntry)
 	{
 		if (isEmpty()) return false;
-		
-		TopEntry = items[top];		 
+
+		TopEntry = items[top];
 		top--;
 		return true;
 	}  // end pop
-	
+
 	bool peek(T& TopEntry) const
 	{
 		if (isEmpty()) return false;
-		
-		TopEntry = items[top];		 
+
+		TopEntry = items[top];
 		return true;
 	}  // end peek
 
+	//reads the entry at a given depth without popping, index 0 is the bottom (first pushed) entry
+	bool peekAt(int index, T& Entry) const
+	{
+		if (index < 0 || index > top) return false;
+
+		Entry = items[index];
+		return true;
+	}  // end peekAt
+
 	int getCount() const
 	{
 		return (top + 1);
@@ -0,0 +1,80 @@
+#include "ArrivalList.h"
+#include "Patient.h"
+
+ArrivalList::ArrivalList() : runBack(0), nextSeq(0)
+{
+}
+
+bool ArrivalList::heapFirst() const
+{
+	ArrivalEntry front;
+	if (!run.peek(front))
+		return !heap.empty();
+	return !heap.empty() && later(front, heap.front());
+}
+
+bool ArrivalList::enqueue(Patient* const& myPatient)
+{
+	ArrivalEntry entry = { myPatient->getArrivalTime(), nextSeq++, myPatient };
+
+	//in order: the run stays sorted, no comparison with the heap is needed
+	if (run.isEmpty() || entry.arrival >= runBack)
+	{
+		run.enqueue(entry);
+		runBack = entry.arrival;
+		return true;
+	}
+
+	heap.push_back(entry);
+	push_heap(heap.begin(), heap.end(), later);
+	return true;
+}
+
+bool ArrivalList::dequeue(Patient*& myPatient)
+{
+	if (heapFirst())
+	{
+		myPatient = heap.front().patient;
+		pop_heap(heap.begin(), heap.end(), later);
+		heap.pop_back();
+		return true;
+	}
+
+	ArrivalEntry front;
+	if (!run.dequeue(front))
+		return false;
+	myPatient = front.patient;
+	return true;
+}
+
+bool ArrivalList::peek(Patient*& myPatient) const
+{
+	if (heapFirst())
+	{
+		myPatient = heap.front().patient;
+		return true;
+	}
+
+	ArrivalEntry front;
+	if (!run.peek(front))
+		return false;
+	myPatient = front.patient;
+	return true;
+}
+
+bool ArrivalList::isEmpty() const
+{
+	return run.isEmpty() && heap.empty();
+}
+
+int ArrivalList::getCount() const
+{
+	return run.getCount() + (int)heap.size();
+}
+
+LinkedQueue<Patient*> ArrivalList::toQueue() const
+{
+	LinkedQueue<Patient*> all;
+	Traverse([&](Patient* myPatient) { all.enqueue(myPatient); });
+	return all;
+}
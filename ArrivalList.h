@@ -0,0 +1,103 @@
+/**
+ * @file ArrivalList.h
+ * @brief Declares the ArrivalList class, the all list of a schedular ordered by arrival time.
+ *
+ * Patients leave the all list by arrival time (VT), patients arriving at the same time in
+ * the order they were added. Most patients are added in arrival order (the input file is
+ * sorted, streamed input too), so they are appended to a linked run in O(1) without any
+ * sorting. A rescheduled patient usually arrives before the last patient of the run; it goes
+ * into a binary heap instead, in O(log n), where the sorted list used to be drained and
+ * copied back for every one of them. The front of the list is the earlier of the two fronts.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "LinkedQueue.h"
+using namespace std;
+
+class Patient;
+
+/**
+ * @struct ArrivalEntry
+ * @brief A patient with the key it is ordered by.
+ */
+struct ArrivalEntry
+{
+    int arrival;            ///< Arrival time of the patient, fixed while they are in the list
+    long long seq;          ///< Order of addition, breaks the ties between equal arrival times
+    Patient* patient;
+};
+
+/**
+ * @class ArrivalList
+ * @brief Queue of patients by arrival time, O(1) in-order appends and O(log n) out-of-order inserts.
+ */
+class ArrivalList
+{
+private:
+    LinkedQueue<ArrivalEntry> run;      ///< Patients added in arrival order
+    int runBack;                        ///< Arrival time of the last patient of the run
+    vector<ArrivalEntry> heap;          ///< Patients added behind the run, a min heap on (arrival, seq)
+    long long nextSeq;                  ///< Sequence of the next added patient
+
+    /** @brief Heap order: true if a leaves after b. */
+    static bool later(const ArrivalEntry& a, const ArrivalEntry& b)
+    {
+        return (a.arrival != b.arrival) ? (a.arrival > b.arrival) : (a.seq > b.seq);
+    }
+
+    /** @brief True if the front of the heap leaves before the front of the run. */
+    bool heapFirst() const;
+
+public:
+    /** @brief Constructs an empty list. */
+    ArrivalList();
+
+    /**
+     * @brief Adds a patient after every patient arriving at or before them.
+     * @param myPatient Patient to add, their arrival time must not change while listed.
+     * @return Always true.
+     */
+    bool enqueue(Patient* const& myPatient);
+
+    /**
+     * @brief Removes the patient arriving first.
+     * @param myPatient Receives the patient.
+     * @return false if the list is empty.
+     */
+    bool dequeue(Patient*& myPatient);
+
+    /**
+     * @brief Reads the patient arriving first without removing them.
+     * @param myPatient Receives the patient.
+     * @return false if the list is empty.
+     */
+    bool peek(Patient*& myPatient) const;
+
+    bool isEmpty() const;
+    int getCount() const;
+
+    /** @brief The patients in leaving order, as a plain queue (for display). */
+    LinkedQueue<Patient*> toQueue() const;
+
+    /** @brief Calls visit(patient) for every patient in leaving order (sorts a copy of the heap). */
+    template <typename Visitor>
+    void Traverse(Visitor visit) const
+    {
+        vector<ArrivalEntry> early = heap;
+        sort(early.begin(), early.end(), [](const ArrivalEntry& a, const ArrivalEntry& b) { return later(b, a); });
+
+        size_t next = 0;
+        run.Traverse([&](const ArrivalEntry& entry)
+        {
+            while (next < early.size() && later(entry, early[next]))
+                visit(early[next++].patient);
+            visit(entry.patient);
+        });
+        while (next < early.size())
+            visit(early[next++].patient);
+    }
+};
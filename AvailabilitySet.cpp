@@ -0,0 +1,186 @@
+#include "AvailabilitySet.h"
+#include "Resource.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//index of the lowest set bit of a word that is not 0
+static int LowestBit(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return (int)index;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+AvailabilitySet::AvailabilitySet() : count(0), order(ALLOC_FIFO), ringHead(0), firstWord(0)
+{
+}
+
+void AvailabilitySet::Register(Resource* resource)
+{
+	if (resource->slot >= 0)
+		return;
+
+	resource->slot = (int)units.size();
+	units.push_back(resource);
+	if (units.size() > bits.size() * 64)
+		bits.push_back(0);
+
+	//the ring holds every free slot at once, it doubles and starts again at 0
+	if (units.size() > ring.size())
+	{
+		vector<int> grown(max((size_t)8, ring.size() * 2));
+		for (int i = 0; i < count && order == ALLOC_FIFO; i++)
+			grown[i] = ring[(ringHead + i) % ring.size()];
+		ring.swap(grown);
+		ringHead = 0;
+	}
+}
+
+void AvailabilitySet::setOrder(AllocationOrder newOrder)
+{
+	order = newOrder;
+	ringHead = 0;
+	firstWord = 0;
+	heap.clear();
+
+	int n = 0;
+	for (int slot = 0; slot < (int)units.size(); slot++)
+	{
+		if (!isSet(slot))
+			continue;
+		if (order == ALLOC_FIFO)
+			ring[n] = slot;
+		else if (order == ALLOC_LEAST_USED)
+			heap.push_back({ units[slot]->usage.sessions, slot });
+		n++;
+	}
+	make_heap(heap.begin(), heap.end(), later);
+}
+
+AllocationOrder AvailabilitySet::getOrder() const { return order; }
+
+void AvailabilitySet::Clear()
+{
+	fill(bits.begin(), bits.end(), 0);
+	count = 0;
+	ringHead = 0;
+	firstWord = 0;
+	heap.clear();
+}
+
+int AvailabilitySet::front() const
+{
+	if (count == 0)
+		return -1;
+
+	switch (order)
+	{
+	case ALLOC_FIFO:
+		return ring[ringHead];
+	case ALLOC_LOWEST_ID:
+		for (int w = firstWord; w < (int)bits.size(); w++)
+		{
+			if (bits[w])
+				return w * 64 + LowestBit(bits[w]);
+		}
+		return -1;
+	default:
+		return heap.front().slot;
+	}
+}
+
+void AvailabilitySet::push(int slot)
+{
+	switch (order)
+	{
+	case ALLOC_FIFO:
+		ring[(ringHead + count) % ring.size()] = slot;
+		break;
+	case ALLOC_LOWEST_ID:
+		firstWord = min(firstWord, slot >> 6);
+		break;
+	case ALLOC_LEAST_USED:
+		heap.push_back({ units[slot]->usage.sessions, slot });
+		push_heap(heap.begin(), heap.end(), later);
+		break;
+	}
+}
+
+bool AvailabilitySet::enqueue(Resource* const& resource)
+{
+	Register(resource);
+
+	int slot = resource->slot;
+	if (isSet(slot))
+		return true;
+
+	push(slot);
+	bits[slot >> 6] |= (uint64_t)1 << (slot & 63);
+	count++;
+	return true;
+}
+
+bool AvailabilitySet::peek(Resource*& resource) const
+{
+	int slot = front();
+	if (slot < 0)
+		return false;
+
+	resource = units[slot];
+	return true;
+}
+
+bool AvailabilitySet::dequeue(Resource*& resource)
+{
+	int slot = front();
+	if (slot < 0)
+		return false;
+
+	resource = units[slot];
+	bits[slot >> 6] &= ~((uint64_t)1 << (slot & 63));
+	count--;
+
+	switch (order)
+	{
+	case ALLOC_FIFO:
+		ringHead = (ringHead + 1) % ring.size();
+		break;
+	case ALLOC_LOWEST_ID:
+		while (firstWord < (int)bits.size() && !bits[firstWord])
+			firstWord++;
+		break;
+	case ALLOC_LEAST_USED:
+		pop_heap(heap.begin(), heap.end(), later);
+		heap.pop_back();
+		break;
+	}
+	return true;
+}
+
+void AvailabilitySet::Used(Resource* resource)
+{
+	//the other orders do not depend on the use of a resource
+	if (order != ALLOC_LEAST_USED || heap.empty() || heap.front().slot != resource->slot)
+		return;
+
+	pop_heap(heap.begin(), heap.end(), later);
+	heap.back().sessions = resource->usage.sessions;
+	push_heap(heap.begin(), heap.end(), later);
+}
+
+bool AvailabilitySet::contains(const Resource* resource) const
+{
+	int slot = resource->slot;
+	return slot >= 0 && slot < (int)units.size() && units[slot] == resource && isSet(slot);
+}
+
+bool AvailabilitySet::isEmpty() const { return count == 0; }
+
+int AvailabilitySet::getCount() const { return count; }
+
+int AvailabilitySet::getSize() const { return (int)units.size(); }
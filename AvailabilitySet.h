@@ -0,0 +1,144 @@
+/**
+ * @file AvailabilitySet.h
+ * @brief Declares the AvailabilitySet class, the free devices or rooms of one lane.
+ *
+ * Every resource of a lane gets a slot, in the order it joined the lane (the order of its
+ * id), and a bitmap holds one bit per slot, set while the resource is free. Freeing and
+ * taking a resource set and clear a bit, nothing is allocated and no list is walked.
+ * Which free resource is handed out next is the allocation order of the set:
+ *
+ * - ALLOC_FIFO: the one free the longest, like the linked queue the lanes used to hold;
+ *   the free slots are kept in a ring in the order they were freed. O(1).
+ * - ALLOC_LOWEST_ID: the free resource with the lowest id, the first set bit, found a word
+ *   at a time from the first word that can hold one.
+ * - ALLOC_LEAST_USED: the free resource with the fewest sessions, ties by id, kept in a
+ *   binary heap of slots. O(log n). A room stays free while it has a slot, so the schedular
+ *   calls Used after each assignment to move it down the heap.
+ *
+ * The set keeps the interface of the queue it replaces (enqueue, peek, dequeue of the
+ * front), so the schedular paths are the same for every order.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+class Resource;
+
+/** @enum AllocationOrder
+ *  Which free resource of a lane is taken first.
+ */
+enum AllocationOrder : int8_t
+{
+    ALLOC_FIFO,             ///< Free the longest first (the original order)
+    ALLOC_LOWEST_ID,        ///< Lowest id first
+    ALLOC_LEAST_USED        ///< Fewest sessions first
+};
+
+/**
+ * @class AvailabilitySet
+ * @brief Bitmap of the free resources of a lane, handed out in a selectable order.
+ */
+class AvailabilitySet
+{
+private:
+    /** @brief A free slot in the least used heap, with its sessions. */
+    struct UsageKey
+    {
+        int sessions;
+        int slot;
+    };
+
+    vector<Resource*> units;        ///< Resources of the lane, by slot
+    vector<uint64_t> bits;          ///< Bit of a slot set while the resource is free
+    int count;                      ///< Free resources
+    AllocationOrder order;
+
+    vector<int> ring;               ///< ALLOC_FIFO: free slots in the order they were freed, from ringHead
+    int ringHead;
+    int firstWord;                  ///< ALLOC_LOWEST_ID: no bit is set in the words before it
+    vector<UsageKey> heap;          ///< ALLOC_LEAST_USED: free slots, a min heap on (sessions, slot)
+
+    /** @brief Heap order: true if a is taken after b. */
+    static bool later(const UsageKey& a, const UsageKey& b)
+    {
+        return (a.sessions != b.sessions) ? (a.sessions > b.sessions) : (a.slot > b.slot);
+    }
+
+    bool isSet(int slot) const { return (bits[slot >> 6] >> (slot & 63)) & 1; }
+
+    /** @brief Slot of the resource handed out next, -1 if none is free. */
+    int front() const;
+
+    /** @brief Adds a free slot to the structure of the order. */
+    void push(int slot);
+
+public:
+    /** @brief Constructs an empty set taking resources in FIFO order. */
+    AvailabilitySet();
+
+    /**
+     * @brief Gives a resource of the lane its slot, without freeing it.
+     * Resources are registered in id order so slots follow ids (enqueue registers too).
+     */
+    void Register(Resource* resource);
+
+    /**
+     * @brief Changes the allocation order, the free resources are ordered again.
+     * With ALLOC_FIFO they are then in slot order.
+     */
+    void setOrder(AllocationOrder newOrder);
+    AllocationOrder getOrder() const;
+
+    /** @brief Takes every resource, they stay registered with their slots. */
+    void Clear();
+
+    /** @brief Marks a resource free, registering it first if needed. Nothing if already free. */
+    bool enqueue(Resource* const& resource);
+
+    /** @brief Reads the resource handed out next. @return false if none is free. */
+    bool peek(Resource*& resource) const;
+
+    /** @brief Takes the resource handed out next. @return false if none is free. */
+    bool dequeue(Resource*& resource);
+
+    /** @brief The resource handed out next got a patient and stays free (a room), orders it again. */
+    void Used(Resource* resource);
+
+    bool contains(const Resource* resource) const;  ///< True if the resource is free
+    bool isEmpty() const;
+    int getCount() const;                           ///< Free resources
+    int getSize() const;                            ///< Resources registered, free or not
+
+    /** @brief Calls visit(resource) for every free resource, in the order they would be handed out. */
+    template <typename Visitor>
+    void Traverse(Visitor visit) const
+    {
+        switch (order)
+        {
+        case ALLOC_FIFO:
+            for (int i = 0; i < count; i++)
+                visit(units[ring[(ringHead + i) % ring.size()]]);
+            break;
+        case ALLOC_LOWEST_ID:
+            for (int slot = 0; slot < (int)units.size(); slot++)
+            {
+                if (isSet(slot))
+                    visit(units[slot]);
+            }
+            break;
+        case ALLOC_LEAST_USED:
+        {
+            vector<UsageKey> sorted = heap;
+            sort(sorted.begin(), sorted.end(), [](const UsageKey& a, const UsageKey& b) { return later(b, a); });
+            for (const UsageKey& key : sorted)
+                visit(units[key.slot]);
+            break;
+        }
+        }
+    }
+};
@@ -0,0 +1,228 @@
+#include "BinaryRoster.h"
+#include "MappedFile.h"
+#include "TextScanner.h"
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static_assert(sizeof(RosterHeader) == 48, "RosterHeader layout changed, bump ROSTER_VERSION");
+static_assert(sizeof(RosterPatient) == 16, "RosterPatient layout changed, bump ROSTER_VERSION");
+
+bool BinaryRoster::ConvertToBinary(const string& textFile, const string& binaryFile)
+{
+	MappedFile inMap;
+	if (!inMap.Open(textFile))
+	{
+		cout << "Error: Unable to open file " << textFile << endl;
+		return false;
+	}
+	TextScanner inFile(inMap.begin(), inMap.end());
+
+	RosterHeader header = {};
+	memcpy(header.magic, "PCRS", 4);
+	header.version = ROSTER_VERSION;
+	header.recordSize = sizeof(RosterPatient);
+
+	if (!(inFile >> header.numEDevices >> header.numUDevices >> header.numXRooms) || header.numXRooms < 0)
+	{
+		cout << "Error: Failed to read device counts." << endl;
+		return false;
+	}
+
+	vector<int32_t> capacities(header.numXRooms);
+	for (int32_t& capacity : capacities)
+	{
+		if (!(inFile >> capacity))
+		{
+			cout << "Error: Failed to read gym room capacity." << endl;
+			return false;
+		}
+	}
+
+	//two bits per treatment type only hold E, U and X
+	if (isalpha((unsigned char)inFile.peek()))
+	{
+		cout << "Error: Treatment lanes other than E, U and X can't be stored in a roster." << endl;
+		return false;
+	}
+
+	if (!(inFile >> header.pCancel >> header.pResc >> header.pFreeFailure >> header.pBusyFailure))
+	{
+		cout << "Error: Failed to read probabilities." << endl;
+		return false;
+	}
+
+	int numPatients = 0;
+	if (!(inFile >> numPatients) || numPatients < 0)
+	{
+		cout << "Error: Failed to read the number of patients." << endl;
+		return false;
+	}
+
+	vector<RosterPatient> patients;
+	patients.reserve(numPatients);
+
+	for (int i = 0; i < numPatients; i++)
+	{
+		char patientTypeChar;
+		int numTreatments;
+		RosterPatient record = {};
+
+		if (!(inFile >> patientTypeChar >> record.PT >> record.VT >> numTreatments))
+		{
+			cout << "Error: Failed to read patient data at entry " << i + 1 << endl;
+			return false;
+		}
+
+		if (patientTypeChar != 'N')
+			record.flags |= 1;
+
+		//only the treatments Patient::addTreatment would keep
+		int kept = 0;
+		bool seen[3] = { false, false, false };
+		for (int j = 0; j < numTreatments; j++)
+		{
+			char treatmentType;
+			int duration;
+			if (!(inFile >> treatmentType >> duration))
+			{
+				cout << "Error: Failed to read treatment data at entry " << i + 1 << endl;
+				return false;
+			}
+
+			int type = (treatmentType == 'E') ? E_THERAPY : (treatmentType == 'U') ? U_THERAPY : (treatmentType == 'X') ? X_THERAPY : -1;
+			if (type < 0 || seen[type] || kept == ROSTER_MAX_TREATMENTS)
+				continue;
+
+			if (duration < 0 || duration > ROSTER_MAX_DURATION)
+			{
+				cout << "Error: Treatment duration out of range at entry " << i + 1 << endl;
+				return false;
+			}
+
+			seen[type] = true;
+			record.flags |= (uint16_t)(type << (3 + 2 * kept));
+			record.durations[kept] = (uint16_t)duration;
+			kept++;
+		}
+		record.flags |= (uint16_t)(kept << 1);
+
+		if (kept == 0)
+		{
+			cout << "Error: Patient has no E, U or X treatment at entry " << i + 1 << endl;
+			return false;
+		}
+
+		patients.push_back(record);
+	}
+	header.numPatients = (uint32_t)patients.size();
+
+	ofstream outFile(binaryFile, ios::binary);
+	if (!outFile)
+	{
+		cout << "Error: Unable to open file " << binaryFile << endl;
+		return false;
+	}
+
+	outFile.write((const char*)&header, sizeof(header));
+	outFile.write((const char*)capacities.data(), capacities.size() * sizeof(int32_t));
+	outFile.write((const char*)patients.data(), patients.size() * sizeof(RosterPatient));
+	return (bool)outFile;
+}
+
+bool BinaryRoster::ConvertToText(const string& binaryFile, const string& textFile)
+{
+	MappedFile inMap;
+	if (!inMap.Open(binaryFile))
+	{
+		cout << "Error: Unable to open file " << binaryFile << endl;
+		return false;
+	}
+
+	const RosterHeader* header = nullptr;
+	const int32_t* capacities = nullptr;
+	const RosterPatient* patients = nullptr;
+	if (!Open(inMap, header, capacities, patients))
+		return false;
+
+	ofstream outFile(textFile);
+	if (!outFile)
+	{
+		cout << "Error: Unable to open file " << textFile << endl;
+		return false;
+	}
+
+	const char typeChars[3] = { 'E', 'U', 'X' };
+
+	outFile << header->numEDevices << " " << header->numUDevices << " " << header->numXRooms << "\n";
+	for (int i = 0; i < header->numXRooms; i++)
+		outFile << (i ? " " : "") << capacities[i];
+	outFile << "\n" << header->pCancel << " " << header->pResc << " " << header->pFreeFailure << " " << header->pBusyFailure << "\n";
+	outFile << header->numPatients << "\n";
+
+	for (uint32_t i = 0; i < header->numPatients; i++)
+	{
+		const RosterPatient& record = patients[i];
+		outFile << (record.isRecovering() ? 'R' : 'N') << " " << record.PT << " " << record.VT << " " << record.getTreatmentCount();
+		for (int j = 0; j < record.getTreatmentCount(); j++)
+			outFile << " " << typeChars[record.getTreatmentType(j)] << " " << record.durations[j];
+		outFile << "\n";
+	}
+
+	return (bool)outFile;
+}
+
+bool BinaryRoster::Open(const MappedFile& file, const RosterHeader*& header, const int32_t*& capacities,
+	const RosterPatient*& patients)
+{
+	size_t size = file.getSize();
+	header = (const RosterHeader*)file.begin();
+
+	if (size < sizeof(RosterHeader) || memcmp(header->magic, "PCRS", 4) != 0)
+	{
+		cout << "Error: Not a roster file." << endl;
+		return false;
+	}
+
+	if (header->version != ROSTER_VERSION || header->recordSize != sizeof(RosterPatient))
+	{
+		cout << "Error: Unsupported roster version " << header->version << "." << endl;
+		return false;
+	}
+
+	size_t expected = sizeof(RosterHeader) + (size_t)header->numXRooms * sizeof(int32_t)
+		+ (size_t)header->numPatients * sizeof(RosterPatient);
+	if (header->numXRooms < 0 || size < expected)
+	{
+		cout << "Error: Roster file is truncated." << endl;
+		return false;
+	}
+
+	capacities = (const int32_t*)(file.begin() + sizeof(RosterHeader));
+	patients = (const RosterPatient*)(capacities + header->numXRooms);
+
+	//the loader and the converter index by these bits, so a bad record fails here and not there
+	for (uint32_t i = 0; i < header->numPatients; i++)
+	{
+		const RosterPatient& record = patients[i];
+		int count = record.getTreatmentCount();
+		bool valid = count > 0 && count <= ROSTER_MAX_TREATMENTS;
+		bool seen[3] = { false, false, false };
+		for (int j = 0; valid && j < count; j++)
+		{
+			int type = record.getTreatmentType(j);
+			valid = type <= X_THERAPY && !seen[type];
+			if (valid)
+				seen[type] = true;
+		}
+
+		if (!valid)
+		{
+			cout << "Error: Invalid treatments in roster record " << i + 1 << "." << endl;
+			return false;
+		}
+	}
+	return true;
+}
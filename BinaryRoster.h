@@ -0,0 +1,105 @@
+/**
+ * @file BinaryRoster.h
+ * @brief Versioned binary form of the input file and its converters.
+ *
+ * A roster file (.bin) holds the same data as the text input (.txt) in fixed-width records:
+ *
+ *  - RosterHeader     : magic "PCRS", version, device counts, probabilities, patient count
+ *  - int32_t[numX]    : capacity of every gym room
+ *  - RosterPatient[n] : one 16 byte record per patient, treatments inline
+ *
+ * Records are host-endian and 4 byte aligned, so a memory mapped roster is used in place
+ * without any parsing (see Load::LoadDataFromRoster). Only the treatments a patient can
+ * actually hold are stored: at most 3, the first one of each type, like Patient::addTreatment.
+ * Input files that declare treatment lanes besides E, U and X, or patients with none of them,
+ * have no roster form.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Treatment.h"
+using namespace std;
+
+class MappedFile;
+
+#define ROSTER_VERSION 1
+#define ROSTER_MAX_TREATMENTS 3
+#define ROSTER_MAX_DURATION 65535
+
+/**
+ * @struct RosterHeader
+ * @brief First record of a roster file.
+ */
+struct RosterHeader
+{
+    char magic[4];              ///< "PCRS"
+    uint32_t version;           ///< ROSTER_VERSION
+    uint32_t recordSize;        ///< sizeof(RosterPatient), rejects files from an incompatible build
+    int32_t numEDevices;        ///< Number of E devices
+    int32_t numUDevices;        ///< Number of U devices
+    int32_t numXRooms;          ///< Number of gym rooms (capacities follow the header)
+    int32_t pCancel;            ///< Cancellation probability
+    int32_t pResc;              ///< Rescheduling probability
+    int32_t pFreeFailure;       ///< Free device failure probability
+    int32_t pBusyFailure;       ///< Busy device failure probability
+    uint32_t numPatients;       ///< Number of patient records
+    uint32_t reserved;          ///< Zero, keeps the header a multiple of 8 bytes
+};
+
+/**
+ * @struct RosterPatient
+ * @brief One patient with its treatments inline.
+ *
+ * flags: bit 0 = recovering patient, bits 1-2 = number of treatments,
+ * bits 3-4, 5-6, 7-8 = type of treatment 0, 1, 2 (E_THERAPY, U_THERAPY, X_THERAPY).
+ */
+struct RosterPatient
+{
+    int32_t PT;                                     ///< Appointment time
+    int32_t VT;                                     ///< Arrival time
+    uint16_t flags;                                 ///< Patient type, treatment count and types
+    uint16_t durations[ROSTER_MAX_TREATMENTS];      ///< Duration of each treatment
+
+    bool isRecovering() const { return flags & 1; }
+    int getTreatmentCount() const { return (flags >> 1) & 3; }
+    TreatmentType getTreatmentType(int i) const { return (TreatmentType)((flags >> (3 + 2 * i)) & 3); }
+};
+
+/**
+ * @class BinaryRoster
+ * @brief Converts between text input files and roster files, and validates mapped rosters.
+ */
+class BinaryRoster
+{
+public:
+    /**
+     * @brief Converts a text input file into a roster file.
+     * @param textFile Path of the text input.
+     * @param binaryFile Path of the roster to write.
+     * @return false if the text is malformed or the roster could not be written.
+     */
+    static bool ConvertToBinary(const string& textFile, const string& binaryFile);
+
+    /**
+     * @brief Converts a roster file back into a text input file.
+     * @param binaryFile Path of the roster.
+     * @param textFile Path of the text input to write.
+     * @return false if the roster is invalid or the text could not be written.
+     */
+    static bool ConvertToText(const string& binaryFile, const string& textFile);
+
+    /**
+     * @brief Checks a mapped roster and locates its sections, nothing is copied.
+     * @param file The mapped roster.
+     * @param header Receives the header.
+     * @param capacities Receives the gym room capacities.
+     * @param patients Receives the first patient record.
+     * @return false if the file is not a roster of this version, is truncated or has a record
+     *         whose treatment count or types are invalid.
+     */
+    static bool Open(const MappedFile& file, const RosterHeader*& header, const int32_t*& capacities,
+        const RosterPatient*& patients);
+};
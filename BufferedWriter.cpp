@@ -0,0 +1,93 @@
+#include "BufferedWriter.h"
+#include <charconv>
+#include <cstring>
+
+BufferedWriter::BufferedWriter() : buffer(WRITER_BUFFER_SIZE), used(0) {}
+
+BufferedWriter::~BufferedWriter()
+{
+	Close();
+}
+
+bool BufferedWriter::Open(const string& fileName, bool binary)
+{
+	Close();
+	outFile.clear();
+	outFile.open(fileName, binary ? (ios::out | ios::binary | ios::trunc) : (ios::out | ios::trunc));
+	return outFile.is_open();
+}
+
+bool BufferedWriter::Close()
+{
+	if (!outFile.is_open())
+		return good();
+
+	Flush();
+	outFile.close();
+	return good();
+}
+
+void BufferedWriter::Flush()
+{
+	if (used && outFile.is_open())
+	{
+		outFile.write(buffer.data(), used);
+		outFile.flush();
+	}
+	used = 0;
+}
+
+void BufferedWriter::Write(const void* data, size_t count)
+{
+	Reserve(count);
+	memcpy(buffer.data() + used, data, count);
+	used += count;
+}
+
+void BufferedWriter::Put(const char* text)
+{
+	Write(text, strlen(text));
+}
+
+void BufferedWriter::Put(long long value)
+{
+	Reserve(24);
+	to_chars_result result = to_chars(buffer.data() + used, buffer.data() + used + 24, value);
+	used = result.ptr - buffer.data();
+}
+
+void BufferedWriter::Put(double value)
+{
+	Reserve(32);
+	to_chars_result result = to_chars(buffer.data() + used, buffer.data() + used + 32, value, chars_format::general, 6);
+	used = result.ptr - buffer.data();
+}
+
+void BufferedWriter::PutLeft(long long value, int width)
+{
+	//reserve for the number and its padding at once, so no flush can happen in between
+	Reserve(24 + (width > 0 ? width : 0));
+
+	to_chars_result result = to_chars(buffer.data() + used, buffer.data() + used + 24, value);
+	int written = (int)(result.ptr - (buffer.data() + used));
+	used += written;
+
+	if (written < width)
+	{
+		memset(buffer.data() + used, ' ', width - written);
+		used += width - written;
+	}
+}
+
+void BufferedWriter::PutLeft(const char* text, int width)
+{
+	size_t length = strlen(text);
+	Write(text, length);
+
+	if ((int)length < width)
+	{
+		Reserve(width - length);
+		memset(buffer.data() + used, ' ', width - length);
+		used += width - length;
+	}
+}
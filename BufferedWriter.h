@@ -0,0 +1,97 @@
+/**
+ * @file BufferedWriter.h
+ * @brief Output file writer formatting numbers with std::to_chars into a large buffer.
+ *
+ * Everything written goes into one memory buffer that reaches the file in large blocks,
+ * there is no per-field stream formatting and no flush per line. Numbers are formatted
+ * with std::to_chars, doubles in the same "%g, 6 digits" form as the default ostream.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+#define WRITER_BUFFER_SIZE (1 << 20)    // bytes collected before a block is written
+
+/**
+ * @class BufferedWriter
+ * @brief Append-only text/binary file writer with a large user-space buffer.
+ */
+class BufferedWriter
+{
+private:
+    ofstream outFile;       ///< Destination file
+    vector<char> buffer;    ///< Pending bytes
+    size_t used;            ///< Number of pending bytes
+
+    /** @brief Makes sure at least count bytes fit in the buffer, writing it out if needed. */
+    void Reserve(size_t count)
+    {
+        if (used + count > buffer.size())
+        {
+            Flush();
+            if (count > buffer.size())
+                buffer.resize(count);
+        }
+    }
+
+public:
+    BufferedWriter();
+
+    /** @brief Flushes and closes the file. */
+    ~BufferedWriter();
+
+    /**
+     * @brief Opens (and truncates) the destination file.
+     * @param binary If false, the file is opened in text mode (line endings follow the platform).
+     * @return false if the file could not be opened.
+     */
+    bool Open(const string& fileName, bool binary = true);
+
+    /**
+     * @brief Writes the pending bytes and closes the file.
+     * @return false if any write failed.
+     */
+    bool Close();
+
+    /** @brief Writes the pending bytes to the file (and out of the stream buffer). */
+    void Flush();
+
+    /** @brief Appends raw bytes. */
+    void Write(const void* data, size_t count);
+
+    /** @brief Appends one character. */
+    void Put(char c)
+    {
+        Reserve(1);
+        buffer[used++] = c;
+    }
+
+    /** @brief Appends a C string. */
+    void Put(const char* text);
+
+    /** @brief Appends a string. */
+    void Put(const string& text) { Write(text.data(), text.size()); }
+
+    /** @brief Appends an integer in decimal. */
+    void Put(long long value);
+    void Put(int value) { Put((long long)value); }
+
+    /** @brief Appends a double like an ostream with default settings would ("%g", 6 digits). */
+    void Put(double value);
+
+    /**
+     * @brief Appends an integer left aligned in a field of at least width characters, like setw + left.
+     */
+    void PutLeft(long long value, int width);
+
+    /** @brief Appends a string left aligned in a field of at least width characters, like setw + left. */
+    void PutLeft(const char* text, int width);
+
+    /** @brief Returns true while every write so far succeeded. */
+    bool good() const { return (bool)outFile; }
+};
@@ -0,0 +1,294 @@
+#include "CapacityOptimizer.h"
+#include "Schedular.h"
+#include "Load.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+CapacityOptimizer::CapacityOptimizer(string fileName, SLOMetric slo, double targetWait) :
+	_fileName(fileName),
+	metric(slo),
+	target(targetWait),
+	minConfig{ 1, 1, 1, 1 },
+	maxConfig{ 10, 10, 5, 10 },
+	costE(1),
+	costU(1),
+	costRoom(1),
+	costSlot(0.25),
+	workers(1),
+	maxExtraTimeSteps(10000),
+	seed(1),
+	simulationsRun(0)
+{
+	unsigned int hardware = thread::hardware_concurrency();
+	workers = (hardware > 0) ? (int)hardware : 1;
+}
+
+void CapacityOptimizer::setSearchBounds(const CapacityConfig& lower, const CapacityConfig& upper)
+{
+	for (int d = 0; d < 4; d++)
+	{
+		int lo = getDimension(lower, d);
+		int hi = getDimension(upper, d);
+
+		//at least one unit of each resource, otherwise patients needing it never finish
+		Dimension(minConfig, d) = (lo > 0) ? lo : 1;
+		Dimension(maxConfig, d) = (hi >= Dimension(minConfig, d)) ? hi : Dimension(minConfig, d);
+	}
+}
+
+void CapacityOptimizer::setCosts(double E, double U, double room, double slot)
+{
+	costE = E;
+	costU = U;
+	costRoom = room;
+	costSlot = slot;
+}
+
+void CapacityOptimizer::setWorkers(int count) { workers = (count > 0) ? count : 1; }
+
+void CapacityOptimizer::setMaxExtraTimeSteps(int timeSteps) { maxExtraTimeSteps = (timeSteps > 0) ? timeSteps : 1; }
+
+void CapacityOptimizer::setSeed(unsigned long long randomSeed) { seed = randomSeed; }
+
+double CapacityOptimizer::getCost(const CapacityConfig& config) const
+{
+	return costE * config.numE + costU * config.numU
+		+ costRoom * config.numX + costSlot * config.numX * config.gymCapacity;
+}
+
+int CapacityOptimizer::getSimulationsRun() const { return simulationsRun; }
+
+int& CapacityOptimizer::Dimension(CapacityConfig& config, int dimension)
+{
+	switch (dimension)
+	{
+	case 0:  return config.numE;
+	case 1:  return config.numU;
+	case 2:  return config.numX;
+	default: return config.gymCapacity;
+	}
+}
+
+int CapacityOptimizer::getDimension(const CapacityConfig& config, int dimension)
+{
+	CapacityConfig copy = config;
+	return Dimension(copy, dimension);
+}
+
+bool CapacityOptimizer::Dominates(const CapacityConfig& b, const CapacityConfig& a)
+{
+	return a.numE <= b.numE && a.numU <= b.numU && a.numX <= b.numX && a.gymCapacity <= b.gymCapacity;
+}
+
+CandidateResult CapacityOptimizer::Evaluate(const CapacityConfig& config, const atomic<bool>* cheaperPassed) const
+{
+	simulationsRun++;
+
+	CandidateResult result = { config, false, false, false, 0, 0, 0 };
+
+	//runs on the same thread reuse the memory of the previous one (its schedular is gone by now)
+	static thread_local SimulationArena workerArena;
+	workerArena.Reset();
+
+	Schedular hospitalSystem;
+	hospitalSystem.setArena(&workerArena);
+	hospitalSystem.setSeed(seed);
+
+	Load loader(_fileName);
+
+	//same patients and probabilities as the file, but with the candidate resources
+	loader.LoadDataFromFile(hospitalSystem, false);
+
+	for (int i = 0; i < config.numE; i++)
+		hospitalSystem.CreateResource<Edevice>();
+	for (int i = 0; i < config.numU; i++)
+		hospitalSystem.CreateResource<Udevice>();
+	for (int i = 0; i < config.numX; i++)
+		hospitalSystem.CreateResource<GymRoom>(config.gymCapacity);
+
+	hospitalSystem.UpdateNumberResources();
+
+	int TotalPatients = hospitalSystem.getTotalPatients();
+	int lastAllowedTime = hospitalSystem.getLastArrivalTime() + maxExtraTimeSteps;
+
+	//for the p95 metric, the target is missed once more than this many patients waited longer than it
+	int allowedAbove = TotalPatients - (int)ceil(0.95 * TotalPatients);
+
+	vector<int> waits;
+	waits.reserve(TotalPatients);
+	long long TotalWait = 0;
+	int aboveTarget = 0;
+
+	while (!hospitalSystem.SimulationEnded())
+	{
+		hospitalSystem.SimulateTimeStep();
+		hospitalSystem.IncrementTime();
+
+		//collect the patients finished during this time step
+		for (int i = (int)waits.size(); i < hospitalSystem.getFinishedCount(); i++)
+		{
+			int wait = hospitalSystem.getFinishedPatient(i)->getTotalWaitingTime();
+			waits.push_back(wait);
+			TotalWait += wait;
+			if (wait > target)
+				aboveTarget++;
+		}
+
+		//finished patients only add waiting time, so once they break the target nothing can fix it
+		bool missed = (metric == AVERAGE_WAIT) ? (TotalWait > target * TotalPatients) : (aboveTarget > allowedAbove);
+
+		if (missed || hospitalSystem.getCurrentTime() > lastAllowedTime)
+		{
+			result.stoppedEarly = true;
+			result.timeSteps = hospitalSystem.getCurrentTime();
+			return result;
+		}
+
+		if (cheaperPassed && *cheaperPassed)
+		{
+			result.abandoned = true;
+			result.timeSteps = hospitalSystem.getCurrentTime();
+			return result;
+		}
+	}
+
+	result.timeSteps = hospitalSystem.getCurrentTime();
+
+	if (TotalPatients > 0)
+	{
+		result.avgWait = (double)TotalWait / TotalPatients;
+
+		//nearest rank percentile
+		int rank = (int)ceil(0.95 * TotalPatients) - 1;
+		nth_element(waits.begin(), waits.begin() + rank, waits.end());
+		result.p95Wait = waits[rank];
+	}
+
+	double achieved = (metric == AVERAGE_WAIT) ? result.avgWait : result.p95Wait;
+	result.meetsTarget = (achieved <= target);
+	return result;
+}
+
+void CapacityOptimizer::EvaluateBatch(const vector<CapacityConfig>& batch, vector<CandidateResult>& results) const
+{
+	int count = (int)batch.size();
+	results.assign(count, CandidateResult());
+
+	//passed[i] becomes true once any candidate cheaper than i met the target
+	vector<atomic<bool>> passed(count);
+	for (int i = 0; i < count; i++)
+		passed[i] = false;
+
+	vector<thread> threads;
+	for (int i = 0; i < count; i++)
+	{
+		threads.emplace_back([&, i]()
+		{
+			results[i] = Evaluate(batch[i], &passed[i]);
+			if (results[i].meetsTarget)
+			{
+				for (int j = i + 1; j < count; j++)
+					passed[j] = true;
+			}
+		});
+	}
+
+	for (thread& t : threads)
+		t.join();
+}
+
+int CapacityOptimizer::BisectDimension(int dimension) const
+{
+	//the upper bound is known to pass, look for the first passing value in [lo, hi]
+	int lo = getDimension(minConfig, dimension);
+	int hi = getDimension(maxConfig, dimension);
+
+	while (lo < hi)
+	{
+		int mid = lo + (hi - lo) / 2;
+
+		CapacityConfig candidate = maxConfig;
+		Dimension(candidate, dimension) = mid;
+
+		if (Evaluate(candidate, nullptr).meetsTarget)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	return lo;
+}
+
+bool CapacityOptimizer::Optimize(CandidateResult& best)
+{
+	// 1) if the most expensive configuration misses, nothing in the box meets the target
+	best = Evaluate(maxConfig, nullptr);
+	if (!best.meetsTarget)
+		return false;
+
+	// 2) per dimension bisection, all four in parallel
+	CapacityConfig lower = minConfig;
+	vector<thread> threads;
+	for (int d = 0; d < 4; d++)
+	{
+		threads.emplace_back([this, &lower, d]() { Dimension(lower, d) = BisectDimension(d); });
+	}
+	for (thread& t : threads)
+		t.join();
+
+	// 3) list every configuration left in the box, cheapest first
+	vector<CapacityConfig> candidates;
+	for (int e = lower.numE; e <= maxConfig.numE; e++)
+		for (int u = lower.numU; u <= maxConfig.numU; u++)
+			for (int x = lower.numX; x <= maxConfig.numX; x++)
+				for (int c = lower.gymCapacity; c <= maxConfig.gymCapacity; c++)
+					candidates.push_back({ e, u, x, c });
+
+	stable_sort(candidates.begin(), candidates.end(),
+		[this](const CapacityConfig& a, const CapacityConfig& b) { return getCost(a) < getCost(b); });
+
+	// 4) evaluate in cost order, the first candidate that passes is the cheapest one
+	vector<CapacityConfig> failed;
+	size_t next = 0;
+
+	while (next < candidates.size())
+	{
+		vector<CapacityConfig> batch;
+		while (next < candidates.size() && (int)batch.size() < workers)
+		{
+			const CapacityConfig& candidate = candidates[next++];
+
+			//if a bigger configuration already missed, this one misses too
+			bool pruned = false;
+			for (const CapacityConfig& f : failed)
+			{
+				if (Dominates(f, candidate))
+				{
+					pruned = true;
+					break;
+				}
+			}
+
+			if (!pruned)
+				batch.push_back(candidate);
+		}
+
+		vector<CandidateResult> results;
+		EvaluateBatch(batch, results);
+
+		for (const CandidateResult& result : results)
+		{
+			if (result.meetsTarget)
+			{
+				best = result;
+				return true;
+			}
+			if (!result.abandoned)
+				failed.push_back(result.config);
+		}
+	}
+
+	//only reached when more resources made waiting worse somewhere in the box, keep the upper bound from step 1
+	return true;
+}
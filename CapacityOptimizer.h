@@ -0,0 +1,150 @@
+/**
+ * @file CapacityOptimizer.h
+ * @brief Goal-seeking search for the cheapest resource mix that meets a waiting time target.
+ *
+ * The CapacityOptimizer replays one patient load (read with Load::LoadDataFromFile) against
+ * candidate resource configurations: number of E devices, U devices, gym rooms and the
+ * capacity of every room. It returns the cheapest configuration whose average or 95th
+ * percentile patient waiting time stays within the requested target.
+ *
+ * The search assumes that adding resources never makes waiting worse. It first bisects each
+ * dimension with the other ones at their upper bound, which gives a lower bound per dimension,
+ * then walks the remaining configurations in increasing cost and skips any configuration that
+ * is dominated by one that already missed the target. Candidates are simulated in parallel,
+ * and a run is abandoned as soon as its finished patients alone already break the target.
+ * Every candidate is simulated with the same seed, so configurations are compared on the same
+ * failures, cancellations and reschedulings rather than on luck.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+using namespace std;
+
+/** @enum SLOMetric
+ *  The waiting time statistic that has to stay within the target.
+ */
+enum SLOMetric { AVERAGE_WAIT, P95_WAIT };
+
+/**
+ * @struct CapacityConfig
+ * @brief One candidate resource mix, all gym rooms share the same capacity.
+ */
+struct CapacityConfig
+{
+    int numE;           ///< Number of E devices
+    int numU;           ///< Number of U devices
+    int numX;           ///< Number of gym rooms
+    int gymCapacity;    ///< Capacity of every gym room
+};
+
+/**
+ * @struct CandidateResult
+ * @brief Outcome of simulating one candidate configuration.
+ */
+struct CandidateResult
+{
+    CapacityConfig config;  ///< The simulated configuration
+    bool meetsTarget;       ///< True if the waiting time target was met
+    bool abandoned;         ///< True if the run was stopped because a cheaper candidate already passed
+    bool stoppedEarly;      ///< True if the run was stopped because it clearly missed the target
+    double avgWait;         ///< Average waiting time per patient (only valid for complete runs)
+    double p95Wait;         ///< 95th percentile waiting time (only valid for complete runs)
+    int timeSteps;          ///< Number of simulated time steps
+};
+
+/**
+ * @class CapacityOptimizer
+ * @brief Finds the cheapest CapacityConfig meeting a waiting time target for a given input file.
+ */
+class CapacityOptimizer
+{
+private:
+    string _fileName;               ///< Input file (without .txt) holding the patient load
+    SLOMetric metric;               ///< Statistic compared against the target
+    double target;                  ///< Maximum allowed value of the statistic
+
+    CapacityConfig minConfig;       ///< Lower search bound (inclusive)
+    CapacityConfig maxConfig;       ///< Upper search bound (inclusive)
+
+    double costE;                   ///< Cost of one E device
+    double costU;                   ///< Cost of one U device
+    double costRoom;                ///< Cost of one gym room
+    double costSlot;                ///< Cost of one gym room slot (capacity unit)
+
+    int workers;                    ///< Number of candidates simulated in parallel
+    int maxExtraTimeSteps;          ///< Time steps allowed after the last arrival before a run counts as a miss
+    unsigned long long seed;        ///< Random seed shared by all candidate simulations
+
+    mutable atomic<int> simulationsRun; ///< Number of simulations started so far
+
+    /**
+     * @brief Simulates the patient load with the given configuration.
+     * @param config Resource mix to simulate.
+     * @param cheaperPassed If not nullptr, the run is abandoned as soon as this flag becomes true.
+     * @return The outcome of the run.
+     */
+    CandidateResult Evaluate(const CapacityConfig& config, const atomic<bool>* cheaperPassed) const;
+
+    /**
+     * @brief Simulates a batch of candidates in parallel.
+     *
+     * The batch must be sorted by cost, a candidate is abandoned once a cheaper one in the same batch passed.
+     */
+    void EvaluateBatch(const vector<CapacityConfig>& batch, vector<CandidateResult>& results) const;
+
+    /**
+     * @brief Smallest value of one dimension that meets the target while the others stay at maxConfig.
+     * @param dimension 0 = E devices, 1 = U devices, 2 = gym rooms, 3 = gym capacity.
+     */
+    int BisectDimension(int dimension) const;
+
+    /** @brief Returns true if every dimension of a is less than or equal to the same dimension of b. */
+    static bool Dominates(const CapacityConfig& b, const CapacityConfig& a);
+
+    /** @brief Accesses one dimension of a configuration by index. */
+    static int& Dimension(CapacityConfig& config, int dimension);
+
+    /** @brief Reads one dimension of a configuration by index. */
+    static int getDimension(const CapacityConfig& config, int dimension);
+
+public:
+    /**
+     * @brief Constructs an optimizer for one patient load.
+     * @param fileName Name of the input file (excluding the .txt extension).
+     * @param slo Statistic compared against the target.
+     * @param targetWait Maximum allowed value of the statistic in time steps.
+     */
+    CapacityOptimizer(string fileName, SLOMetric slo, double targetWait);
+
+    /** @brief Sets the inclusive search box, every lower bound must be at least 1. */
+    void setSearchBounds(const CapacityConfig& lower, const CapacityConfig& upper);
+
+    /** @brief Sets the cost of each resource unit used to rank configurations. */
+    void setCosts(double E, double U, double room, double slot);
+
+    /** @brief Sets the number of candidates simulated in parallel (default: hardware threads). */
+    void setWorkers(int count);
+
+    /** @brief Sets how long after the last arrival a run may continue before it counts as a miss. */
+    void setMaxExtraTimeSteps(int timeSteps);
+
+    /** @brief Sets the random seed every candidate simulation starts from. */
+    void setSeed(unsigned long long randomSeed);
+
+    /** @brief Returns the cost of a configuration. */
+    double getCost(const CapacityConfig& config) const;
+
+    /** @brief Returns the number of simulations started by the last call(s) to Optimize. */
+    int getSimulationsRun() const;
+
+    /**
+     * @brief Searches the box for the cheapest configuration meeting the target.
+     * @param best Receives the cheapest passing configuration and its statistics.
+     * @return False if not even the upper bound of the box meets the target.
+     */
+    bool Optimize(CandidateResult& best);
+};
@@ -0,0 +1,853 @@
+#include "Checkpoint.h"
+#include "Schedular.h"
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#define CHECKPOINT_VERSION 9
+#define CHECKPOINT_STREAMED 0x1        // saved while a PatientStream was feeding the run
+
+//----------------------------------------------------------------------------------
+// SNAPSHOT RECORDS (fixed width, copied with memcpy)
+//----------------------------------------------------------------------------------
+
+struct CheckpointHeader
+{
+	char magic[4];              // "PCCK"
+	uint32_t version;
+	uint32_t resourceCount;
+	uint32_t patientCount;
+	uint32_t laneCount;
+	uint32_t flags;             // CHECKPOINT_* bits
+};
+
+struct SchedularRecord
+{
+	int32_t currentTime, lastArrivalTime;
+	int32_t pCancel, pResc, pFreeFailure, pBusyFailure;
+	int32_t allocationOrder, roomFit;
+	int32_t TotalTimeSteps, TotalPatients, N_patients, R_patients;
+	int32_t TotalEarly, TotalLate, TotalLatePenalty;
+	int32_t FinishedCount, TotalCancelled, TotalReschduled;
+	int64_t TotalWait, TotalWait_N, TotalWait_R;
+	int64_t TotalTreatment, TotalTreatment_N, TotalTreatment_R;
+	double AvgWaitTime_all, AvgWaitTime_N, AvgWaitTime_R;
+	double AvgTreatmentTime_all, AvgTreatmentTime_N, AvgTreatmentTime_R;
+	double perc_accepted_cancell, perc_accepted_resch;
+	double perc_early_patients, perc_late_patients, AvgLatePenalty;
+	double perc_freefail_E, perc_freefail_U, perc_Busyfail_E, perc_Busyfail_U;
+	uint64_t rngState[2];
+};
+
+struct LaneRecord
+{
+	int8_t code;
+	int8_t kind;
+	int16_t waitEvent;
+	int32_t numDevices, totalFreeFail, totalBusyFail;
+};
+
+struct ResourceRecord
+{
+	int32_t id;
+	int32_t type;
+	int32_t lane;
+	uint8_t status;
+	uint8_t working;
+	uint8_t failedOnce;
+	uint8_t underMaintenance;
+	int32_t maintainanceTime;
+	int32_t maintainanceCooldown;
+	int32_t currCap;
+	int32_t roomCapacity;
+	int32_t usageSince, occupants;
+	int32_t sessions, busyFailures, freeFailures;
+	int64_t busyTicks, idleTicks, maintenanceTicks, occupancyTicks;
+};
+
+struct PatientRecord
+{
+	int32_t PID;
+	int32_t pType;
+	int32_t PT;
+	int32_t VT;
+	int32_t status;
+	int32_t lastChange;
+	int32_t totalWaitingTime;
+	int32_t totalTreatmentTime;
+	int32_t finishTime;
+	uint8_t cancelled;
+	uint8_t rescheduled;
+	uint16_t treatmentCount;
+};
+
+struct TreatmentRecord
+{
+	int32_t type;
+	int32_t duration;
+	int32_t assignmentTime;
+	int32_t finishTime;
+	int32_t resource;           // handle of the resource (its index in the resource table), -1 if none
+	int32_t interrupted;
+};
+
+struct RegistryRecord
+{
+	int32_t PID;
+	int32_t index;              // index in the patient table, -1 once reclaimed
+	int32_t nextEvent, since, arrival, finishTime;
+	uint16_t transitions;
+	uint8_t interruptions, reschedules;
+	int8_t status, place, lane;
+	uint8_t flags;
+};
+
+struct QueueEntry
+{
+	int32_t index;              // index in the patient table, or resource handle
+	int32_t priority;           // 0 for queues without priorities
+};
+
+//----------------------------------------------------------------------------------
+// BUFFER HELPERS
+//----------------------------------------------------------------------------------
+
+template <typename T>
+static void Append(vector<char>& buffer, const T* items, size_t count)
+{
+	if (count == 0)
+		return;
+
+	size_t offset = buffer.size();
+	buffer.resize(offset + sizeof(T) * count);
+	memcpy(&buffer[offset], items, sizeof(T) * count);
+}
+
+template <typename T>
+static void Append(vector<char>& buffer, const T& item)
+{
+	Append(buffer, &item, 1);
+}
+
+/**
+ * @brief Reads fixed-width records from a snapshot, failing instead of reading past its end.
+ */
+class SnapshotReader
+{
+	const char* cursor;
+	const char* end;
+public:
+	SnapshotReader(const vector<char>& buffer) : cursor(buffer.data()), end(buffer.data() + buffer.size()) {}
+
+	template <typename T>
+	bool Get(T* items, size_t count)
+	{
+		size_t bytes = sizeof(T) * count;
+		if ((size_t)(end - cursor) < bytes)
+			return false;
+
+		if (bytes)
+			memcpy(items, cursor, bytes);
+		cursor += bytes;
+		return true;
+	}
+
+	template <typename T>
+	bool Get(T& item) { return Get(&item, 1); }
+};
+
+//----------------------------------------------------------------------------------
+// SAVE
+//----------------------------------------------------------------------------------
+
+void Checkpoint::SaveToBuffer(const Schedular& s, vector<char>& buffer)
+{
+	// 1) number every patient once, lists then refer to them by index and to resources by handle
+	unordered_map<const Patient*, int32_t> patientIndex;
+	vector<Patient*> patients;
+	auto addPatient = [&](Patient* p)
+	{
+		if (p && patientIndex.emplace(p, (int32_t)patients.size()).second)
+			patients.push_back(p);
+	};
+	auto addPrioritisedPatient = [&](Patient* p, int) { addPatient(p); };
+
+	//reclaimed patients only have a registry entry, so every list is visited
+	s.ALL_patients.Traverse(addPatient);
+	s.EARLY_patients.Traverse(addPrioritisedPatient);
+	s.LATE_patients.Traverse(addPrioritisedPatient);
+	for (int i = 0; i < s.laneCount; i++)
+		s.lanes[i].waiting.Traverse(addPatient);
+	s.interruptedPatients.Traverse(addPrioritisedPatient);
+	s.inTreatment.Traverse(addPrioritisedPatient);
+	for (int i = 0; i < s.Finished_patients.getCount(); i++)
+	{
+		Patient* p = nullptr;
+		s.Finished_patients.peekAt(i, p);
+		addPatient(p);
+	}
+
+	//every resource is in the pool, free, maintained or busy, so the table is the pool
+	vector<Resource*> resources;
+	resources.reserve(s.resources.getCount());
+	s.resources.Traverse([&](Resource* r) { resources.push_back(r); });
+
+	size_t treatmentCount = 0;
+	for (Patient* p : patients)
+		treatmentCount += p->treatmentCount;
+
+	// 2) reserve everything once, the rest are plain copies
+	size_t queueEntries = s.ALL_patients.getCount()
+		+ s.EARLY_patients.getCount() + s.LATE_patients.getCount()
+		+ s.interruptedPatients.getCount() + s.inTreatment.getCount() + s.Finished_patients.getCount();
+	for (int i = 0; i < s.laneCount; i++)
+		queueEntries += s.lanes[i].getFreeCount() + s.lanes[i].maintenance.getCount() + s.lanes[i].waiting.getCount();
+
+	buffer.clear();
+	buffer.reserve(sizeof(CheckpointHeader) + sizeof(SchedularRecord) + s.laneCount * sizeof(LaneRecord)
+		+ resources.size() * sizeof(ResourceRecord)
+		+ patients.size() * sizeof(PatientRecord) + treatmentCount * sizeof(TreatmentRecord)
+		+ s.registry.getCount() * sizeof(RegistryRecord)
+		+ (7 + 3 * s.laneCount) * sizeof(uint32_t) + queueEntries * sizeof(QueueEntry));
+
+	CheckpointHeader header = { { 'P', 'C', 'C', 'K' }, CHECKPOINT_VERSION, (uint32_t)resources.size(), (uint32_t)patients.size(), (uint32_t)s.laneCount,
+		s.patientStream ? (uint32_t)CHECKPOINT_STREAMED : 0u };
+	Append(buffer, header);
+
+	// 3) scalars, then one record per lane
+	SchedularRecord rec = {};
+	rec.currentTime = s.currentTime;
+	rec.lastArrivalTime = s.lastArrivalTime;
+	rec.pCancel = s.pCancel;
+	rec.pResc = s.pResc;
+	rec.pFreeFailure = s.pFreeFailure;
+	rec.pBusyFailure = s.pBusyFailure;
+	rec.allocationOrder = s.allocationOrder;
+	rec.roomFit = s.roomFit;
+	rec.TotalTimeSteps = s.TotalTimeSteps;
+	rec.TotalPatients = s.TotalPatients;
+	rec.N_patients = s.N_patients;
+	rec.R_patients = s.R_patients;
+	rec.TotalEarly = s.TotalEarly;
+	rec.TotalLate = s.TotalLate;
+	rec.TotalLatePenalty = s.TotalLatePenalty;
+	rec.FinishedCount = s.FinishedCount;
+	rec.TotalCancelled = s.TotalCancelled;
+	rec.TotalReschduled = s.TotalReschduled;
+	rec.TotalWait = s.TotalWait;
+	rec.TotalWait_N = s.TotalWait_N;
+	rec.TotalWait_R = s.TotalWait_R;
+	rec.TotalTreatment = s.TotalTreatment;
+	rec.TotalTreatment_N = s.TotalTreatment_N;
+	rec.TotalTreatment_R = s.TotalTreatment_R;
+	rec.AvgWaitTime_all = s.AvgWaitTime_all;
+	rec.AvgWaitTime_N = s.AvgWaitTime_N;
+	rec.AvgWaitTime_R = s.AvgWaitTime_R;
+	rec.AvgTreatmentTime_all = s.AvgTreatmentTime_all;
+	rec.AvgTreatmentTime_N = s.AvgTreatmentTime_N;
+	rec.AvgTreatmentTime_R = s.AvgTreatmentTime_R;
+	rec.perc_accepted_cancell = s.perc_accepted_cancell;
+	rec.perc_accepted_resch = s.perc_accepted_resch;
+	rec.perc_early_patients = s.perc_early_patients;
+	rec.perc_late_patients = s.perc_late_patients;
+	rec.AvgLatePenalty = s.AvgLatePenalty;
+	rec.perc_freefail_E = s.perc_freefail_E;
+	rec.perc_freefail_U = s.perc_freefail_U;
+	rec.perc_Busyfail_E = s.perc_Busyfail_E;
+	rec.perc_Busyfail_U = s.perc_Busyfail_U;
+	s.rng.getState(reinterpret_cast<unsigned long long*>(rec.rngState));
+	Append(buffer, rec);
+
+	for (int i = 0; i < s.laneCount; i++)
+	{
+		const TreatmentLane& lane = s.lanes[i];
+		LaneRecord lr = { (int8_t)lane.code, (int8_t)lane.kind, (int16_t)lane.waitEvent, lane.numDevices, lane.totalFreeFail, lane.totalBusyFail };
+		Append(buffer, lr);
+	}
+
+	// 4) resources
+	for (Resource* r : resources)
+	{
+		ResourceRecord rr = {};
+		rr.id = r->id;
+		rr.type = r->type;
+		rr.lane = r->lane;
+		rr.status = r->status ? 1 : 0;
+		rr.underMaintenance = r->underMaintenance;
+		rr.usageSince = r->usageSince;
+		rr.occupants = r->occupants;
+		rr.sessions = r->usage.sessions;
+		rr.busyFailures = r->usage.busyFailures;
+		rr.freeFailures = r->usage.freeFailures;
+		rr.busyTicks = r->usage.busyTicks;
+		rr.idleTicks = r->usage.idleTicks;
+		rr.maintenanceTicks = r->usage.maintenanceTicks;
+		rr.occupancyTicks = r->usage.occupancyTicks;
+
+		if (Device* dev = dynamic_cast<Device*>(r))
+		{
+			rr.working = dev->Working;
+			rr.failedOnce = dev->failedOnce;
+			rr.maintainanceTime = dev->maintainanceTime;
+			rr.maintainanceCooldown = dev->MaintainanceCooldown;
+		}
+		else if (GymRoom* room = dynamic_cast<GymRoom*>(r))
+		{
+			rr.currCap = room->curr_cap;
+			rr.roomCapacity = room->room_capacity;
+		}
+		Append(buffer, rr);
+	}
+
+	// 5) patients, each followed by its remaining treatments in queue order
+	for (Patient* p : patients)
+	{
+		PatientRecord pr;
+		pr.PID = p->PID;
+		pr.pType = p->pType;
+		pr.PT = p->PT;
+		pr.VT = p->VT;
+		pr.status = p->status;
+		pr.lastChange = p->LastChangeTimeStamp;
+		pr.totalWaitingTime = p->totalWaitingTime;
+		pr.totalTreatmentTime = p->totalTreatmentTime;
+		pr.finishTime = p->finishTime;
+		pr.cancelled = p->cancelled;
+		pr.rescheduled = p->rescheduled;
+		pr.treatmentCount = (uint16_t)p->treatmentCount;
+		Append(buffer, pr);
+
+		for (int j = 0; j < p->treatmentCount; j++)
+		{
+			const Treatment* t = &p->Required_Treatments[j];
+			TreatmentRecord tr;
+			tr.type = t->type;
+			tr.duration = t->duration;
+			tr.assignmentTime = t->assignmentTime;
+			tr.finishTime = t->finishTime;
+			tr.resource = t->Assigned_Resource ? (int32_t)t->Assigned_Resource->getHandle() : -1;
+			tr.interrupted = t->interrupted;
+			Append(buffer, tr);
+		}
+	}
+
+	// 6) registry, as a count followed by one record per registered PID
+	vector<RegistryRecord> registry;
+	registry.reserve(s.registry.getCount());
+	s.registry.Traverse([&](int PID, const PatientEntry& e)
+	{
+		auto found = e.patient ? patientIndex.find(e.patient) : patientIndex.end();
+		registry.push_back({ PID, found != patientIndex.end() ? found->second : -1, e.nextEvent, e.since, e.arrival, e.finishTime,
+			e.transitions, e.interruptions, e.reschedules, e.status, (int8_t)e.place, e.lane, e.flags });
+	});
+	uint32_t registryCount = (uint32_t)registry.size();
+	Append(buffer, registryCount);
+	Append(buffer, registry.data(), registry.size());
+
+	// 7) lists, in a fixed order, each as a count followed by its entries from front to back
+	vector<QueueEntry> entries;
+	auto flush = [&]()
+	{
+		uint32_t count = (uint32_t)entries.size();
+		Append(buffer, count);
+		Append(buffer, entries.data(), entries.size());
+		entries.clear();
+	};
+	auto patientEntry = [&](Patient* p) { entries.push_back({ patientIndex[p], 0 }); };
+	auto prioritisedPatientEntry = [&](Patient* p, int pri) { entries.push_back({ patientIndex[p], pri }); };
+	auto resourceEntry = [&](Resource* r) { entries.push_back({ (int32_t)r->getHandle(), 0 }); };
+	auto prioritisedResourceEntry = [&](Resource* r, int pri) { entries.push_back({ (int32_t)r->getHandle(), pri }); };
+
+	s.ALL_patients.Traverse(patientEntry);              flush();
+	for (int i = 0; i < s.laneCount; i++)
+	{
+		if (s.lanes[i].kind == ROOM_LANE)
+			s.lanes[i].rooms.Traverse(resourceEntry);
+		else
+			s.lanes[i].devices.Traverse(resourceEntry);
+		flush();
+		s.lanes[i].maintenance.Traverse(prioritisedResourceEntry);  flush();
+	}
+	s.EARLY_patients.Traverse(prioritisedPatientEntry); flush();
+	s.LATE_patients.Traverse(prioritisedPatientEntry);  flush();
+	for (int i = 0; i < s.laneCount; i++)
+	{
+		s.lanes[i].waiting.Traverse(patientEntry);      flush();
+	}
+	s.interruptedPatients.Traverse(prioritisedPatientEntry); flush();
+	s.inTreatment.Traverse(prioritisedPatientEntry);    flush();
+
+	//stack from bottom to top, so pushing in this order restores it
+	for (int i = 0; i < s.Finished_patients.getCount(); i++)
+	{
+		Patient* p = nullptr;
+		s.Finished_patients.peekAt(i, p);
+		patientEntry(p);
+	}
+	flush();
+}
+
+//----------------------------------------------------------------------------------
+// RESTORE
+//----------------------------------------------------------------------------------
+
+bool Checkpoint::RestoreFromBuffer(Schedular& s, const vector<char>& buffer)
+{
+	if (s.registry.getCount() || s.TotalPatients || s.resources.getCount())
+	{
+		cout << "Error: a checkpoint can only be restored into an empty Schedular." << endl;
+		return false;
+	}
+
+	//the stream position is not in the snapshot, the arrivals it has not read yet would be lost
+	if (s.patientStream)
+	{
+		cout << "Error: a checkpoint cannot be restored into a streamed Schedular." << endl;
+		return false;
+	}
+
+	//every record is read and checked first, the Schedular is only changed once the whole
+	//snapshot is known to be valid, so a bad snapshot leaves it empty
+	SnapshotReader reader(buffer);
+
+	CheckpointHeader header;
+	if (!reader.Get(header) || memcmp(header.magic, "PCCK", 4) != 0 || header.version != CHECKPOINT_VERSION)
+	{
+		cout << "Error: not a checkpoint of this version." << endl;
+		return false;
+	}
+
+	if (header.flags & CHECKPOINT_STREAMED)
+	{
+		cout << "Error: the checkpoint was saved from a streamed run, its later arrivals are not in it." << endl;
+		return false;
+	}
+
+	SchedularRecord rec;
+	vector<LaneRecord> laneRecords(header.laneCount);
+	vector<ResourceRecord> resourceRecords(header.resourceCount);
+	if (!reader.Get(rec) || !reader.Get(laneRecords.data(), laneRecords.size())
+		|| !reader.Get(resourceRecords.data(), resourceRecords.size()))
+	{
+		cout << "Error: checkpoint is truncated." << endl;
+		return false;
+	}
+
+	// 1) check the lanes, the built-in ones exist already and the declared ones follow them
+	bool ok = header.laneCount >= (uint32_t)s.laneCount && header.laneCount <= MAX_LANES;
+	for (uint32_t i = 0; ok && i < header.laneCount; i++)
+	{
+		const LaneRecord& lr = laneRecords[i];
+		if (i < (uint32_t)s.laneCount)
+		{
+			ok = s.lanes[i].code == lr.code && s.lanes[i].kind == lr.kind;
+			continue;
+		}
+
+		//a declared lane has a letter of its own
+		ok = (lr.kind == DEVICE_LANE || lr.kind == ROOM_LANE) && s.getLane((char)lr.code) == DUMMY_THERAPY;
+		for (uint32_t j = s.laneCount; ok && j < i; j++)
+			ok = laneRecords[j].code != lr.code;
+	}
+	if (!ok)
+	{
+		cout << "Error: invalid lane data in checkpoint." << endl;
+		return false;
+	}
+
+	if (rec.allocationOrder < ALLOC_FIFO || rec.allocationOrder > ALLOC_LEAST_USED)
+	{
+		cout << "Error: invalid allocation order in checkpoint." << endl;
+		return false;
+	}
+
+	if (rec.roomFit < ROOM_FIRST_FREE || rec.roomFit > ROOM_CONSOLIDATE)
+	{
+		cout << "Error: invalid room fit in checkpoint." << endl;
+		return false;
+	}
+
+	// 2) check the resources, rooms serve room lanes and devices the others
+	for (const ResourceRecord& rr : resourceRecords)
+	{
+		if (rr.lane < 0 || rr.lane >= (int32_t)header.laneCount)
+		{
+			cout << "Error: invalid resource lane in checkpoint." << endl;
+			return false;
+		}
+
+		bool room = laneRecords[rr.lane].kind == ROOM_LANE;
+		bool known = (rr.type == _Edevice || rr.type == _Udevice || rr.type == _Ldevice) ? !room
+			: (rr.type == _Xdevice && room);
+		if (!known)
+		{
+			cout << "Error: unknown resource type in checkpoint." << endl;
+			return false;
+		}
+	}
+
+	// 3) read and check the patients and their remaining treatments
+	vector<PatientRecord> patientRecords(header.patientCount);
+	vector<TreatmentRecord> treatmentRecords;
+	for (PatientRecord& pr : patientRecords)
+	{
+		if (!reader.Get(pr))
+		{
+			cout << "Error: checkpoint is truncated." << endl;
+			return false;
+		}
+
+		size_t first = treatmentRecords.size();
+		treatmentRecords.resize(first + pr.treatmentCount);
+		ok = pr.treatmentCount <= MAX_TREATMENTS && reader.Get(&treatmentRecords[first], pr.treatmentCount);
+		for (size_t j = first; ok && j < treatmentRecords.size(); j++)
+		{
+			const TreatmentRecord& tr = treatmentRecords[j];
+			ok = tr.resource >= -1 && tr.resource < (int32_t)resourceRecords.size()
+				&& tr.type >= 0 && tr.type < (int32_t)header.laneCount;
+
+			//a patient needs each treatment once
+			for (size_t k = first; ok && k < j; k++)
+				ok = treatmentRecords[k].type != tr.type;
+		}
+		if (!ok)
+		{
+			cout << "Error: invalid treatment data in checkpoint." << endl;
+			return false;
+		}
+	}
+
+	// 4) read and check the registry
+	uint32_t registryCount = 0;
+	vector<RegistryRecord> registry;
+	ok = reader.Get(registryCount);
+	if (ok)
+	{
+		registry.resize(registryCount);
+		ok = reader.Get(registry.data(), registry.size());
+	}
+	for (size_t i = 0; ok && i < registry.size(); i++)
+	{
+		const RegistryRecord& rr = registry[i];
+		ok = rr.index >= -1 && rr.index < (int32_t)patientRecords.size() && rr.place > PLACE_NONE && rr.place <= PLACE_FINISHED;
+	}
+	if (!ok)
+	{
+		cout << "Error: invalid registry data in checkpoint." << endl;
+		return false;
+	}
+
+	// 5) read and check the lists, in the same order they were saved
+	const int listCount = 7 + 3 * (int)header.laneCount;
+	vector<vector<QueueEntry>> lists(listCount);
+	int next = 0;
+
+	auto readList = [&](size_t tableSize, bool prioritised) -> bool
+	{
+		vector<QueueEntry>& entries = lists[next++];
+		uint32_t count = 0;
+		if (!reader.Get(count))
+			return false;
+		entries.resize(count);
+		if (!reader.Get(entries.data(), count))
+			return false;
+
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			if (entries[i].index < 0 || entries[i].index >= (int32_t)tableSize)
+				return false;
+
+			//priority lists are saved in order
+			if (prioritised && i > 0 && entries[i].priority < entries[i - 1].priority)
+				return false;
+		}
+		return true;
+	};
+
+	ok = readList(patientRecords.size(), false);
+	for (uint32_t i = 0; ok && i < header.laneCount; i++)
+		ok = readList(resourceRecords.size(), false) && readList(resourceRecords.size(), true);
+	ok = ok && readList(patientRecords.size(), true) && readList(patientRecords.size(), true);
+	for (uint32_t i = 0; ok && i < header.laneCount; i++)
+		ok = readList(patientRecords.size(), false);
+	ok = ok && readList(patientRecords.size(), true) && readList(patientRecords.size(), true)
+		&& readList(patientRecords.size(), false);
+	if (!ok)
+	{
+		cout << "Error: invalid list data in checkpoint." << endl;
+		return false;
+	}
+
+	//----------------------------------------------------------------------------------
+	// the snapshot is valid, nothing below fails
+	//----------------------------------------------------------------------------------
+
+	// 6) lanes and how they hand out their resources
+	for (uint32_t i = 0; i < header.laneCount; i++)
+	{
+		const LaneRecord& lr = laneRecords[i];
+		if (i >= (uint32_t)s.laneCount)
+			s.DeclareLane((char)lr.code, (LaneKind)lr.kind);
+
+		TreatmentLane& lane = s.lanes[i];
+		lane.waitEvent = (EventType)lr.waitEvent;
+		lane.numDevices = lr.numDevices;
+		lane.totalFreeFail = lr.totalFreeFail;
+		lane.totalBusyFail = lr.totalBusyFail;
+	}
+	s.setAllocationOrder((AllocationOrder)rec.allocationOrder);
+	s.setRoomFit((RoomFit)rec.roomFit);
+
+	// 7) resources, created in the pool in handle order so they get their handles back
+	vector<Resource*> resources(header.resourceCount, nullptr);
+	for (uint32_t i = 0; i < header.resourceCount; i++)
+	{
+		const ResourceRecord& rr = resourceRecords[i];
+		switch (rr.type)
+		{
+		case _Edevice:
+			resources[i] = s.resources.Create<Edevice>();
+			break;
+		case _Udevice:
+			resources[i] = s.resources.Create<Udevice>();
+			break;
+		case _Ldevice:
+			resources[i] = s.resources.Create<Device>((TreatmentType)rr.lane);
+			break;
+		default:
+		{
+			GymRoom* room = s.resources.Create<GymRoom>(rr.roomCapacity, (TreatmentType)rr.lane);
+			room->curr_cap = rr.currCap;
+			resources[i] = room;
+			break;
+		}
+		}
+		Resource* r = resources[i];
+		if (Device* dev = dynamic_cast<Device*>(r))
+		{
+			dev->Working = rr.working != 0;
+			dev->failedOnce = rr.failedOnce != 0;
+			dev->maintainanceTime = rr.maintainanceTime;
+			dev->MaintainanceCooldown = rr.maintainanceCooldown;
+		}
+		r->id = rr.id;
+		r->lane = (TreatmentType)rr.lane;
+		r->status = rr.status != 0;
+		r->underMaintenance = rr.underMaintenance != 0;
+		r->usageSince = rr.usageSince;
+		r->occupants = rr.occupants;
+		r->usage.sessions = rr.sessions;
+		r->usage.busyFailures = rr.busyFailures;
+		r->usage.freeFailures = rr.freeFailures;
+		r->usage.busyTicks = rr.busyTicks;
+		r->usage.idleTicks = rr.idleTicks;
+		r->usage.maintenanceTicks = rr.maintenanceTicks;
+		r->usage.occupancyTicks = rr.occupancyTicks;
+
+		//slots in id order, as loading gave them, whether the resource is free or not
+		if (s.lanes[rr.lane].kind == ROOM_LANE)
+			s.lanes[rr.lane].rooms.Register(r);
+		else
+			s.lanes[rr.lane].devices.Register(r);
+	}
+
+	// 8) patients and their remaining treatments
+	vector<Patient*> patients(header.patientCount, nullptr);
+	const TreatmentRecord* tr = treatmentRecords.data();
+	for (uint32_t i = 0; i < header.patientCount; i++)
+	{
+		const PatientRecord& pr = patientRecords[i];
+		Patient* p = new (s.getArena()) Patient(pr.PID, pr.PT, pr.VT, (PatientType)pr.pType);
+		p->status = (PatientStatus)pr.status;
+		p->LastChangeTimeStamp = pr.lastChange;
+		p->totalWaitingTime = pr.totalWaitingTime;
+		p->totalTreatmentTime = pr.totalTreatmentTime;
+		p->finishTime = pr.finishTime;
+		p->cancelled = pr.cancelled != 0;
+		p->rescheduled = pr.rescheduled != 0;
+
+		for (int j = 0; j < pr.treatmentCount; j++, tr++)
+		{
+			Treatment t(tr->duration, (TreatmentType)tr->type);
+			t.duration = tr->duration;
+			t.assignmentTime = tr->assignmentTime;
+			t.finishTime = tr->finishTime;
+			t.interrupted = tr->interrupted != 0;
+			t.Assigned_Resource = (tr->resource >= 0) ? resources[tr->resource] : nullptr;
+			p->addTreatment(t);
+		}
+		patients[i] = p;
+	}
+
+	// 9) registry, it holds the reclaimed patients too, so their IDs are reserved as well
+	int lastPID = 0;
+	for (const PatientRecord& pr : patientRecords)
+		lastPID = max(lastPID, (int)pr.PID);
+	for (const RegistryRecord& rr : registry)
+	{
+		lastPID = max(lastPID, (int)rr.PID);
+
+		PatientEntry e;
+		e.patient = (rr.index >= 0) ? patients[rr.index] : nullptr;
+		e.nextEvent = rr.nextEvent;
+		e.since = rr.since;
+		e.arrival = rr.arrival;
+		e.finishTime = rr.finishTime;
+		e.transitions = rr.transitions;
+		e.interruptions = rr.interruptions;
+		e.reschedules = rr.reschedules;
+		e.status = rr.status;
+		e.place = (PatientPlace)rr.place;
+		e.lane = rr.lane;
+		e.flags = rr.flags;
+		s.registry.Restore(rr.PID, e);
+	}
+	Patient::ReserveIDs(lastPID);
+
+	// 10) lists
+	vector<Patient*> patientItems;
+	vector<Resource*> resourceItems;
+	vector<int> priorities;
+	next = 0;
+
+	auto patientList = [&]()
+	{
+		patientItems.clear();
+		priorities.clear();
+		for (const QueueEntry& e : lists[next])
+		{
+			patientItems.push_back(patients[e.index]);
+			priorities.push_back(e.priority);
+		}
+		next++;
+	};
+	auto resourceList = [&]()
+	{
+		resourceItems.clear();
+		priorities.clear();
+		for (const QueueEntry& e : lists[next])
+		{
+			resourceItems.push_back(resources[e.index]);
+			priorities.push_back(e.priority);
+		}
+		next++;
+	};
+	auto intoQueue = [&](auto& q) { patientList(); for (Patient* p : patientItems) q.enqueue(p); };
+	auto intoPriQueue = [&](priQueue<Patient*>& q) { patientList(); q.assignSorted(patientItems.data(), priorities.data(), (int)patientItems.size()); };
+	auto intoResourceQueue = [&](TreatmentLane& lane)
+	{
+		resourceList();
+		for (Resource* r : resourceItems)
+		{
+			if (lane.kind == ROOM_LANE)
+				lane.rooms.enqueue(r);
+			else
+				lane.devices.enqueue(r);
+		}
+	};
+	auto intoResourcePriQueue = [&](priQueue<Resource*>& q) { resourceList(); q.assignSorted(resourceItems.data(), priorities.data(), (int)resourceItems.size()); };
+
+	intoQueue(s.ALL_patients);
+	for (int i = 0; i < s.laneCount; i++)
+	{
+		intoResourceQueue(s.lanes[i]);
+		intoResourcePriQueue(s.lanes[i].maintenance);
+	}
+	intoPriQueue(s.EARLY_patients);
+	intoPriQueue(s.LATE_patients);
+	for (int i = 0; i < s.laneCount; i++)
+		intoQueue(s.lanes[i].waiting);
+	intoPriQueue(s.interruptedPatients);
+	intoPriQueue(s.inTreatment);
+
+	patientList();
+	for (Patient* p : patientItems)
+		s.Finished_patients.push(p);
+
+	for (Patient* p : patients)
+		s.byStatus.Attach(p);
+
+	// 11) scalars
+	s.currentTime = rec.currentTime;
+	s.lastArrivalTime = rec.lastArrivalTime;
+	s.pCancel = rec.pCancel;
+	s.pResc = rec.pResc;
+	s.pFreeFailure = rec.pFreeFailure;
+	s.pBusyFailure = rec.pBusyFailure;
+	s.TotalTimeSteps = rec.TotalTimeSteps;
+	s.TotalPatients = rec.TotalPatients;
+	s.N_patients = rec.N_patients;
+	s.R_patients = rec.R_patients;
+	s.TotalEarly = rec.TotalEarly;
+	s.TotalLate = rec.TotalLate;
+	s.TotalLatePenalty = rec.TotalLatePenalty;
+	s.FinishedCount = rec.FinishedCount;
+	s.TotalCancelled = rec.TotalCancelled;
+	s.TotalReschduled = rec.TotalReschduled;
+	s.TotalWait = rec.TotalWait;
+	s.TotalWait_N = rec.TotalWait_N;
+	s.TotalWait_R = rec.TotalWait_R;
+	s.TotalTreatment = rec.TotalTreatment;
+	s.TotalTreatment_N = rec.TotalTreatment_N;
+	s.TotalTreatment_R = rec.TotalTreatment_R;
+	s.AvgWaitTime_all = rec.AvgWaitTime_all;
+	s.AvgWaitTime_N = rec.AvgWaitTime_N;
+	s.AvgWaitTime_R = rec.AvgWaitTime_R;
+	s.AvgTreatmentTime_all = rec.AvgTreatmentTime_all;
+	s.AvgTreatmentTime_N = rec.AvgTreatmentTime_N;
+	s.AvgTreatmentTime_R = rec.AvgTreatmentTime_R;
+	s.perc_accepted_cancell = rec.perc_accepted_cancell;
+	s.perc_accepted_resch = rec.perc_accepted_resch;
+	s.perc_early_patients = rec.perc_early_patients;
+	s.perc_late_patients = rec.perc_late_patients;
+	s.AvgLatePenalty = rec.AvgLatePenalty;
+	s.perc_freefail_E = rec.perc_freefail_E;
+	s.perc_freefail_U = rec.perc_freefail_U;
+	s.perc_Busyfail_E = rec.perc_Busyfail_E;
+	s.perc_Busyfail_U = rec.perc_Busyfail_U;
+	s.rng.setState(reinterpret_cast<const unsigned long long*>(rec.rngState));
+
+	return true;
+}
+
+//----------------------------------------------------------------------------------
+// FILES
+//----------------------------------------------------------------------------------
+
+bool Checkpoint::Save(const Schedular& mySchedular, const string& fileName)
+{
+	vector<char> buffer;
+	SaveToBuffer(mySchedular, buffer);
+
+	ofstream outFile(fileName, ios::binary);
+	if (!outFile)
+	{
+		cout << "Error: Unable to open checkpoint file " << fileName << endl;
+		return false;
+	}
+
+	outFile.write(buffer.data(), buffer.size());
+	return (bool)outFile;
+}
+
+bool Checkpoint::Restore(Schedular& mySchedular, const string& fileName)
+{
+	ifstream inFile(fileName, ios::binary | ios::ate);
+	if (!inFile)
+	{
+		cout << "Error: Unable to open checkpoint file " << fileName << endl;
+		return false;
+	}
+
+	vector<char> buffer((size_t)inFile.tellg());
+	inFile.seekg(0);
+	if (!inFile.read(buffer.data(), buffer.size()))
+	{
+		cout << "Error: Unable to read checkpoint file " << fileName << endl;
+		return false;
+	}
+
+	return RestoreFromBuffer(mySchedular, buffer);
+}
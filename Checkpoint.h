@@ -0,0 +1,73 @@
+/**
+ * @file Checkpoint.h
+ * @brief Declares the Checkpoint class that saves and restores a running simulation.
+ *
+ * A checkpoint is a compact binary snapshot of the simulation state at the end of a
+ * time step: every treatment lane (declared ones included) and every list with its priorities
+ * and order, every patient with its remaining
+ * treatments and their assigned resources, device failure/maintenance/cooldown state, room
+ * occupancy, the usage counters of every resource, all counters, the current time and the
+ * random generator state.
+ *
+ * The attachments of a Schedular are not saved: the position of a PatientStream, the output
+ * sink, the telemetry ring and the event log. Telemetry and an event log can be attached again
+ * after a restore and start from there. A run fed by a PatientStream cannot be resumed, its
+ * unread arrivals are not in the snapshot, so such a snapshot is flagged when saved and
+ * refused by RestoreFromBuffer, as is a restore into a streamed Schedular.
+ *
+ * Restoring a snapshot into a freshly constructed Schedular continues the simulation exactly
+ * where it was saved. Every record is checked before the Schedular is changed, so an invalid
+ * snapshot leaves it as it was. The patient IDs of the snapshot are reserved, so patients
+ * created after a restore get new ones. The same snapshot can be restored several times to branch independent
+ * what-if continuations. Snapshots are fixed-width host-endian records copied with memcpy,
+ * so they are meant to be resumed on the same kind of machine that wrote them.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "SchedularFwd.h"
+
+/**
+ * @class Checkpoint
+ * @brief Provides static functions to snapshot a Schedular to memory or disk and back.
+ */
+class Checkpoint
+{
+public:
+    /**
+     * @brief Serialises the state of a simulation into a buffer.
+     * @param mySchedular The simulation to save (not modified).
+     * @param buffer Receives the snapshot, previous content is replaced.
+     */
+    static void SaveToBuffer(const Schedular& mySchedular, vector<char>& buffer);
+
+    /**
+     * @brief Rebuilds a simulation from a snapshot buffer.
+     * @param mySchedular A freshly constructed Schedular that receives the state.
+     * @param buffer Snapshot produced by SaveToBuffer or read from a checkpoint file.
+     * @return False if the snapshot is invalid or was saved from a streamed run, or the
+     *         Schedular is not empty or is streamed. The Schedular is unchanged then.
+     */
+    static bool RestoreFromBuffer(Schedular& mySchedular, const vector<char>& buffer);
+
+    /**
+     * @brief Saves the state of a simulation to a binary file.
+     * @param mySchedular The simulation to save (not modified).
+     * @param fileName Path of the checkpoint file.
+     * @return False if the file could not be written.
+     */
+    static bool Save(const Schedular& mySchedular, const string& fileName);
+
+    /**
+     * @brief Restores a simulation saved with Save.
+     * @param mySchedular A freshly constructed Schedular that receives the state.
+     * @param fileName Path of the checkpoint file.
+     * @return False if the file could not be read or is not a valid checkpoint.
+     */
+    static bool Restore(Schedular& mySchedular, const string& fileName);
+};
@@ -0,0 +1,332 @@
+#include "ContainerBenchmark.h"
+#include "Schedular.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+//keeps the results of measured calls alive so the optimiser can't drop the calls
+static volatile long long benchSink = 0;
+
+ContainerBenchmark::ContainerBenchmark() :
+	sizes({ 100, 1000, 10000, 100000, 1000000 }),
+	budget(0.5),
+	seed(1)
+{}
+
+ContainerBenchmark::~ContainerBenchmark()
+{
+	for (Patient* p : pool)
+		delete p;
+}
+
+void ContainerBenchmark::setSizes(const vector<int>& containerSizes)
+{
+	sizes.clear();
+	for (int size : containerSizes)
+	{
+		if (size > 0)
+			sizes.push_back(size);
+	}
+
+	//a size is skipped by predicting from the smaller one before it
+	sort(sizes.begin(), sizes.end());
+}
+
+void ContainerBenchmark::setTimeBudget(double seconds) { budget = (seconds > 0) ? seconds : budget; }
+
+void ContainerBenchmark::setSeed(unsigned long long randomSeed) { seed = randomSeed; }
+
+const vector<BenchmarkResult>& ContainerBenchmark::getResults() const { return results; }
+
+//gives the patient of index i its treatments
+static void AddTreatments(Patient* p, int i)
+{
+	if (i % 2)
+		p->addTreatment(U_treatment(1 + i % 10));
+	else
+		p->addTreatment(E_treatment(1 + i % 10));
+
+	//one patient out of four has a single treatment (cancellable once in the X waiting list)
+	if (i % 4)
+		p->addTreatment(X_treatment(1 + i % 10));
+}
+
+void ContainerBenchmark::FillPool(int count)
+{
+	for (int i = (int)pool.size(); i < count; i++)
+	{
+		//appointment times follow the index, so the pool is already sorted by PT
+		Patient* p = new Patient(i, i, (i % 2) ? RECOVERING : NORMAL);
+		AddTreatments(p, i);
+		pool.push_back(p);
+	}
+}
+
+template <typename Step, typename Restore>
+void ContainerBenchmark::Measure(const string& operation, int size, int batch, Step step, Restore restore)
+{
+	BenchmarkResult result = { operation, size, false, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	//assume the worst (quadratic) growth from the previous size
+	auto last = previous.find(operation);
+	if (last != previous.end())
+	{
+		double growth = (double)size / last->second.first;
+		if (last->second.second * growth * growth > BENCH_SKIP_FACTOR * budget)
+		{
+			result.skipped = true;
+			results.push_back(result);
+			cout << left << setw(40) << operation << setw(10) << size << "skipped (predicted over budget)" << endl;
+			return;
+		}
+	}
+
+	vector<double> latencies;
+	double total = 0;
+	while (total < budget && (int)latencies.size() < BENCH_MAX_SAMPLES)
+	{
+		auto start = chrono::steady_clock::now();
+		step();
+		double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		restore();
+
+		total += elapsed;
+		latencies.push_back(elapsed * 1e9 / batch);
+	}
+
+	sort(latencies.begin(), latencies.end());
+	auto percentile = [&](double q)
+	{
+		size_t rank = (size_t)(q * latencies.size());
+		return latencies[(rank < latencies.size()) ? rank : latencies.size() - 1];
+	};
+
+	result.samples = (int)latencies.size();
+	result.operations = (long long)latencies.size() * batch;
+	result.seconds = total;
+	result.opsPerSecond = (total > 0) ? result.operations / total : 0;
+	result.p50 = percentile(0.50);
+	result.p90 = percentile(0.90);
+	result.p99 = percentile(0.99);
+	result.maximum = latencies.back();
+	results.push_back(result);
+	previous[operation] = { size, result.p50 * batch * 1e-9 };
+
+	cout << left << setw(40) << operation << setw(10) << size
+		<< setw(14) << result.opsPerSecond
+		<< setw(12) << result.p50 << setw(12) << result.p90
+		<< setw(12) << result.p99 << setw(12) << result.maximum << endl;
+}
+
+//----------------------------------------------------------------------------------
+// CASES
+//----------------------------------------------------------------------------------
+
+void ContainerBenchmark::BenchLinkedQueue(int size)
+{
+	const int batch = (size < 64) ? size : 64;
+	LinkedQueue<Patient*> queue;
+	Patient* item = nullptr;
+	for (int i = 0; i < size; i++)
+		queue.enqueue(pool[i]);
+
+	Measure("LinkedQueue::enqueue", size, batch,
+		[&]() { for (int i = 0; i < batch; i++) queue.enqueue(pool[i]); },
+		[&]() { for (int i = 0; i < batch; i++) queue.dequeue(item); });
+
+	Measure("LinkedQueue::dequeue", size, batch,
+		[&]() { for (int i = 0; i < batch; i++) queue.dequeue(item); },
+		[&]() { for (int i = 0; i < batch; i++) queue.enqueue(pool[i]); });
+
+	LinkedQueue<Patient*>* copy = nullptr;
+	Measure("LinkedQueue copy", size, 1,
+		[&]() { copy = new LinkedQueue<Patient*>(queue); },
+		[&]() { benchSink = benchSink + copy->getCount(); delete copy; });
+}
+
+void ContainerBenchmark::BenchPriQueue(int size)
+{
+	vector<int> priorities(size);
+	Patient* item = nullptr;
+	int priority = 0;
+
+	// random priorities land anywhere in the sorted list
+	{
+		priQueue<Patient*> queue;
+		for (int i = 0; i < size; i++)
+			priorities[i] = rng.Next(4 * size);
+		sort(priorities.begin(), priorities.end());
+		queue.assignSorted(pool.data(), priorities.data(), size);
+
+		int next = rng.Next(4 * size);
+		Measure("priQueue::enqueue random", size, 1,
+			[&]() { queue.enqueue(pool[0], next); },
+			[&]() { queue.dequeue(item, priority); next = rng.Next(4 * size); });
+	}
+
+	// increasing priorities (like finish times) always go to the back
+	{
+		priQueue<Patient*> queue;
+		for (int i = 0; i < size; i++)
+			priorities[i] = i;
+		queue.assignSorted(pool.data(), priorities.data(), size);
+
+		int next = size;
+		Measure("priQueue::enqueue monotone", size, 1,
+			[&]() { queue.enqueue(pool[0], next++); },
+			[&]() { queue.dequeue(item, priority); });
+	}
+}
+
+void ContainerBenchmark::BenchEUWaitList(int size)
+{
+	EU_WaitList waiting;
+	Patient* item = nullptr;
+	for (int i = 0; i < size; i++)
+		waiting.enqueue(pool[i]);
+
+	int next = rng.Next(size);
+	Measure("EU_WaitList::insertSorted", size, 1,
+		[&]() { waiting.insertSorted(pool[next], next); },
+		[&]() { waiting.dequeue(item); next = rng.Next(size); });
+
+	//a handful of devices busy with E and U treatments
+	TreatmentList inTreatment;
+	for (int i = 0; i < 8 && i < size; i++)
+		inTreatment.enqueue(pool[i], i + 1);
+
+	Measure("EU_WaitList::CalcTreatmentLatency", size, 1,
+		[&]() { benchSink = benchSink + waiting.CalcTreatmentLatency(E_THERAPY, 0, inTreatment); },
+		[&]() {});
+}
+
+void ContainerBenchmark::BenchTreatmentList(int size)
+{
+	TreatmentList inTreatment;
+	vector<int> finishTimes(size);
+	for (int i = 0; i < size; i++)
+		finishTimes[i] = i + 1;
+	inTreatment.assignSorted(pool.data(), finishTimes.data(), size);
+
+	Measure("TreatmentList::RandomBusyFailure", size, 1,
+		[&]() { benchSink = benchSink + (inTreatment.RandomBusyFailure(100, 0, rng) != nullptr); },
+		[&]() {});
+}
+
+void ContainerBenchmark::BenchXWaitList(int size)
+{
+	Schedular hospitalSystem;
+	hospitalSystem.setSeed(seed);
+	hospitalSystem.setpCancel(100);
+
+	//the list holds patients of the schedular, a cancelled one goes on its finished stack and
+	//is deleted with it, so the pool (owned by the benchmark) is not used here
+	X_WaitList waiting;
+	auto admit = [&](int i)
+	{
+		Patient* p = new (hospitalSystem.getArena()) Patient(i, i, i, (i % 2) ? RECOVERING : NORMAL);
+		AddTreatments(p, i);
+		waiting.enqueue(p);
+	};
+	for (int i = 0; i < size; i++)
+		admit(i);
+
+	//a cancelled patient leaves the list, a new one like it goes to its end
+	bool cancelled = false;
+	Measure("X_WaitList::RandomCancel", size, 1,
+		[&]() { cancelled = waiting.RandomCancel(hospitalSystem); },
+		[&]()
+		{
+			if (cancelled)
+				admit(hospitalSystem.getFinishedPatient(hospitalSystem.getFinishedCount() - 1)->getPID());
+		});
+
+	Patient* p = nullptr;
+	while (waiting.dequeue(p))
+		delete p;
+}
+
+void ContainerBenchmark::BenchEarlyPlist(int size)
+{
+	EarlyPlist early;
+	vector<int> appointments(size);
+	for (int i = 0; i < size; i++)
+		appointments[i] = pool[i]->getAppointmentTime();
+	early.assignSorted(pool.data(), appointments.data(), size);
+
+	//rescheduled patients leave the list, they go back with their new appointment
+	Patient* rescheduled = nullptr;
+	Measure("EarlyPlist::RandomReschedule", size, 1,
+		[&]() { rescheduled = early.RandomReschedule(100, size, rng); },
+		[&]()
+		{
+			if (rescheduled)
+				early.enqueue(rescheduled, rescheduled->getAppointmentTime());
+		});
+}
+
+//----------------------------------------------------------------------------------
+// RUN AND EXPORT
+//----------------------------------------------------------------------------------
+
+void ContainerBenchmark::Run()
+{
+	results.clear();
+	previous.clear();
+	rng.setSeed(seed);
+
+	if (sizes.empty())
+		return;
+	FillPool(sizes.back());
+
+	cout << left << setw(40) << "Operation" << setw(10) << "Size" << setw(14) << "Ops/s"
+		<< setw(12) << "p50 (ns)" << setw(12) << "p90 (ns)" << setw(12) << "p99 (ns)" << setw(12) << "Max (ns)" << endl;
+
+	//RandomReschedule changes the appointments of the pool, it goes last
+	void (ContainerBenchmark::*cases[])(int) =
+	{
+		&ContainerBenchmark::BenchLinkedQueue,
+		&ContainerBenchmark::BenchPriQueue,
+		&ContainerBenchmark::BenchEUWaitList,
+		&ContainerBenchmark::BenchTreatmentList,
+		&ContainerBenchmark::BenchXWaitList,
+		&ContainerBenchmark::BenchEarlyPlist
+	};
+
+	for (auto bench : cases)
+	{
+		for (int size : sizes)
+			(this->*bench)(size);
+	}
+}
+
+bool ContainerBenchmark::ExportJson(const string& fileName) const
+{
+	ofstream outFile(fileName);
+	if (!outFile.is_open())
+	{
+		cout << "Error: Unable to create file " << fileName << endl;
+		return false;
+	}
+
+	outFile << "{\n  \"seed\": " << seed << ",\n  \"budget_seconds\": " << budget << ",\n  \"results\": [\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const BenchmarkResult& r = results[i];
+		outFile << "    { \"operation\": \"" << r.operation << "\", \"size\": " << r.size
+			<< ", \"skipped\": " << (r.skipped ? "true" : "false");
+		if (!r.skipped)
+		{
+			outFile << ", \"samples\": " << r.samples << ", \"operations\": " << r.operations
+				<< ", \"seconds\": " << r.seconds << ", \"ops_per_second\": " << r.opsPerSecond
+				<< ", \"p50_ns\": " << r.p50 << ", \"p90_ns\": " << r.p90
+				<< ", \"p99_ns\": " << r.p99 << ", \"max_ns\": " << r.maximum;
+		}
+		outFile << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	outFile << "  ]\n}\n";
+
+	return (bool)outFile;
+}
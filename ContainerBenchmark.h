@@ -0,0 +1,107 @@
+/**
+ * @file ContainerBenchmark.h
+ * @brief Microbenchmarks of the simulation containers and of the random list operations.
+ *
+ * Every case fills a container to a given size, then repeats one operation on it and puts the
+ * container back to its size after each sample (outside the timed part). A case stops after
+ * its time budget or BENCH_MAX_SAMPLES samples. Several list operations are quadratic, so a
+ * size is skipped when the median of the previous size, scaled quadratically, predicts a
+ * single operation longer than BENCH_SKIP_FACTOR budgets.
+ *
+ * Results hold the throughput and the latency percentiles of one operation per case and size,
+ * and can be exported as JSON to compare container replacements.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "RandomGenerator.h"
+using namespace std;
+
+class Patient;
+
+#define BENCH_MAX_SAMPLES 100000
+#define BENCH_SKIP_FACTOR 10
+
+/**
+ * @struct BenchmarkResult
+ * @brief Measurements of one operation at one container size.
+ */
+struct BenchmarkResult
+{
+    string operation;       ///< Name of the measured operation
+    int size;               ///< Number of items in the container
+    bool skipped;           ///< True if the operation was predicted to take far longer than the budget
+    int samples;            ///< Number of timed samples
+    long long operations;   ///< Number of operations over all samples
+    double seconds;         ///< Timed seconds over all samples
+    double opsPerSecond;    ///< Throughput
+    double p50;             ///< Median latency of one operation (ns)
+    double p90;             ///< 90th percentile latency (ns)
+    double p99;             ///< 99th percentile latency (ns)
+    double maximum;         ///< Slowest operation (ns)
+};
+
+/**
+ * @class ContainerBenchmark
+ * @brief Runs every container case at every size and collects the results.
+ */
+class ContainerBenchmark
+{
+private:
+    vector<int> sizes;                  ///< Container sizes to measure
+    double budget;                      ///< Time budget of one case at one size (seconds)
+    unsigned long long seed;            ///< Seed of the random priorities, indices and failures
+    RandomGenerator rng;                ///< Random source of the cases
+
+    vector<Patient*> pool;              ///< Patients shared by the cases (E or U first, 3 out of 4 followed by X)
+    vector<BenchmarkResult> results;    ///< Results so far, in run order
+    map<string, pair<int, double>> previous; ///< Last measured size of each case and its median operation (seconds)
+
+    /** @brief Makes sure the pool holds at least count patients. */
+    void FillPool(int count);
+
+    /**
+     * @brief Times one case at one size.
+     * @param operation Name of the case.
+     * @param size Container size.
+     * @param batch Operations done by one call of step (cheap operations are timed in batches).
+     * @param step Timed part of a sample.
+     * @param restore Untimed part of a sample, puts the container back to its size.
+     */
+    template <typename Step, typename Restore>
+    void Measure(const string& operation, int size, int batch, Step step, Restore restore);
+
+    void BenchLinkedQueue(int size);        ///< LinkedQueue enqueue, dequeue and copy
+    void BenchPriQueue(int size);           ///< priQueue::enqueue with random and monotone priorities
+    void BenchEUWaitList(int size);         ///< EU_WaitList::insertSorted and CalcTreatmentLatency
+    void BenchTreatmentList(int size);      ///< TreatmentList::RandomBusyFailure
+    void BenchXWaitList(int size);          ///< X_WaitList::RandomCancel
+    void BenchEarlyPlist(int size);         ///< EarlyPlist::RandomReschedule (changes the pool, runs last)
+
+public:
+    /** @brief Constructs a benchmark of sizes 1e2 to 1e6 with a budget of 0.5 s per case and size. */
+    ContainerBenchmark();
+
+    /** @brief Deletes the patient pool. */
+    ~ContainerBenchmark();
+
+    void setSizes(const vector<int>& containerSizes);   ///< Container sizes to measure
+    void setTimeBudget(double seconds);                 ///< Time budget of one case at one size
+    void setSeed(unsigned long long randomSeed);        ///< Seed of the cases
+
+    /** @brief Runs every case at every size, printing one line per result. */
+    void Run();
+
+    /** @brief Results of the last run. */
+    const vector<BenchmarkResult>& getResults() const;
+
+    /**
+     * @brief Writes the results as a JSON document.
+     * @return false if the file could not be written.
+     */
+    bool ExportJson(const string& fileName) const;
+};
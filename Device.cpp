@@ -0,0 +1,88 @@
+#include "Device.h"
+#include "SchedularPolicy.h"
+
+Device::Device(ResType t, TreatmentType l) :
+    Resource(t, l),
+    Working(true),
+    maintainanceTime(0),
+    MaintainanceCooldown(0),
+    failedOnce(false)
+{
+}
+
+Device::Device(TreatmentType l) : Device(_Ldevice, l)
+{
+}
+
+template <class Policy>
+bool Device::FreeFail(int pFF, typename Policy::Random& rng)
+{
+    int random = rng.Next(100);
+    if (random < pFF)
+    {
+        if (MaintainanceCooldown == 0)
+        {
+            Working = false;
+            maintainanceTime = rng.Next(Policy::maintainanceDuration) + 1;
+            MaintainanceCooldown = Policy::maintainanceCooldown;
+        }
+        else
+        {
+            MaintainanceCooldown--;
+        }
+    }
+
+    return Working;
+}
+
+template <class Policy>
+bool Device::BusyFail(typename Policy::Random& rng)
+{
+    Working = false;
+    maintainanceTime = rng.Next(Policy::maintainanceDuration) + 1;
+    MaintainanceCooldown = Policy::maintainanceCooldown;
+    return true;
+}
+
+void Device::Repair()
+{
+    Working = true;
+}
+
+int Device::getMaintainanceTime() const
+{
+    return maintainanceTime;
+}
+
+void Device::setMaintainanceTime(int time)
+{
+    maintainanceTime = time;
+}
+
+bool Device::isWorking() const
+{
+    return Working;
+}
+
+bool Device::FailedBefore()
+{
+    if (failedOnce == false)
+    {
+        failedOnce = true;
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+void Device::print(std::ostream& os) const
+{
+    os << "Device id : " << id;
+}
+
+#define INSTANTIATE_DEVICE_FAILURES(Policy) \
+    template bool Device::FreeFail<Policy>(int, Policy::Random&); \
+    template bool Device::BusyFail<Policy>(Policy::Random&);
+SCHEDULAR_POLICIES(INSTANTIATE_DEVICE_FAILURES)
@@ -0,0 +1,104 @@
+/**
+ * @file Device.h
+ * @brief Defines the Device class, a Resource that can fail and require maintenance.
+ *
+ * Device holds the failure model shared by every device lane: the working state, the
+ * maintenance time drawn on a failure, the cooldown before the next free failure, and
+ * whether the device failed before. Edevice and Udevice are devices of the built-in E and
+ * U lanes, a plain Device serves a device lane declared in the input file.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include "Resource.h"
+#include "SchedularFwd.h"
+#include <iostream>
+
+class Device : public Resource
+{
+protected:
+    bool Working;                ///< Indicates if the device is working.
+    int maintainanceTime;        ///< Remaining maintenance time.
+    int MaintainanceCooldown;    ///< Cooldown time before the device can fail again.
+    bool failedOnce;             ///< Tracks if the device has failed previously.
+
+    /**
+     * @brief Constructor for the devices of the built-in lanes.
+     * @param t Type of the device.
+     * @param l Lane the device serves.
+     */
+    Device(ResType t, TreatmentType l);
+
+public:
+    /**
+     * @brief Device of a declared lane, numbered by the resource pool that creates it.
+     * @param l Lane the device serves.
+     */
+    Device(TreatmentType l);
+
+    /**
+     * @brief Simulates a failure check when the device is free.
+     *
+     * @tparam Policy Schedular policy, gives the random source and the maintenance constants.
+     * @param pFF Probability (0-100) of failure occurring.
+     * @param rng Random generator of the simulation.
+     * @return true if the device remains working, false if it fails.
+     */
+    template <class Policy>
+    bool FreeFail(int pFF, typename Policy::Random& rng);
+
+    /**
+     * @brief Forces the device to fail while busy.
+     *
+     * @tparam Policy Schedular policy, gives the random source and the maintenance constants.
+     * @param rng Random generator of the simulation (draws the maintenance time).
+     * @return Always returns true indicating device failure.
+     */
+    template <class Policy>
+    bool BusyFail(typename Policy::Random& rng);
+
+    /**
+     * @brief Repairs the device, setting it to working state.
+     */
+    void Repair();
+
+    /**
+     * @brief Gets the current maintenance time remaining.
+     *
+     * @return Maintenance time as an integer.
+     */
+    int getMaintainanceTime() const;
+
+    /**
+     * @brief Sets the maintenance time.
+     *
+     * @param time New maintenance time to set.
+     */
+    void setMaintainanceTime(int time);
+
+    /**
+     * @brief Checks if the device is currently working.
+     *
+     * @return true if working, false otherwise.
+     */
+    bool isWorking() const;
+
+    /**
+     * @brief Checks if the device has failed before.
+     * The first call returns false and sets the flag; subsequent calls return true.
+     *
+     * @return true if failed before, false if this is the first failure check.
+     */
+    bool FailedBefore();
+
+    /**
+     * @brief Prints the device details to the provided output stream.
+     *
+     * @param os Output stream to print to.
+     */
+    void print(std::ostream& os) const override;
+
+    /** @brief Checkpoint saves and restores the failure and maintenance state. */
+    friend class Checkpoint;
+};
@@ -1,11 +1,16 @@
 ﻿#include "EU_WaitList.h"
 #include "Patient.h"
+#include "Profiler.h"
+#include "TreatmentList.h"
+#include "SchedularPolicy.h"
 #include "stdint.h"
 #include <assert.h>
 //for adding late patients to their waiting list
 //according to PT+penalty as their PT
 void EU_WaitList :: insertSorted(Patient* pPatient, int priority)
 {
+	Profiler::Scope profile(PROFILE_INSERT_SORTED);
+
 	EU_WaitList temp_list;
 	Patient* temp_patient;
 
@@ -54,8 +59,11 @@ void EU_WaitList :: insertSorted(Patient* pPatient, int priority)
 //2) current time step : to calculate total latency
 //3) inTreatmentList : traversed for a specific type of treatment that we are concerned with its patients
 //4) waiting_list : traversed to calculate the waiting list time relative to current time
-int EU_WaitList:: CalcTreatmentLatency(TreatmentType type, int currentTime, priQueue<Patient*> inTreatmentList)
+template <class Policy>
+int EU_WaitList:: CalcTreatmentLatency(TreatmentType type, int currentTime, BasicTreatmentList<Policy> inTreatmentList)
 {
+	typename Policy::Instrumentation::Scope profile(PROFILE_CALC_TREATMENT_LATENCY);
+
 	EU_WaitList waiting_list = *this;
 
 	//get total treatment time
@@ -123,4 +131,7 @@ int EU_WaitList:: CalcTreatmentLatency(TreatmentType type, int currentTime, priQ
 	}
 
 	return TotalWaitTime;
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_TREATMENT_LATENCY(Policy) template int EU_WaitList::CalcTreatmentLatency(TreatmentType, int, BasicTreatmentList<Policy>);
+SCHEDULAR_POLICIES(INSTANTIATE_TREATMENT_LATENCY)
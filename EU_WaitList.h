@@ -12,7 +12,9 @@
 #pragma once
 #include "LinkedQueue.h"
 #include "priQueue.h"
+#include "Treatment.h"
 class Patient;
+template <class Policy> class BasicTreatmentList;
 /**
  * @class EU_WaitList
  * @brief Manages a sorted waiting list of patients requiring Emergency/Urgent treatments.
@@ -43,10 +45,11 @@ public:
      *
      * @param type The TreatmentType : used to search the intreatment list
      * @param currentTime : to calculate total latency
-     * @param inTreatmentList : traversed for a specific type of treatment
+     * @param inTreatmentList : traversed for a specific type of treatment (a copy, of the schedular policy's list)
      * @return Total latency time (wait + treatment) for the specified treatment type.
      */
-    int CalcTreatmentLatency(TreatmentType type, int currentTime, priQueue<Patient*> inTreatmentList);
+    template <class Policy>
+    int CalcTreatmentLatency(TreatmentType type, int currentTime, BasicTreatmentList<Policy> inTreatmentList);
 
     // Additional member functions and variables inherited from priQueue<Patient*>.
 };
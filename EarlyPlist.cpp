@@ -1,35 +1,40 @@
 #include "EarlyPlist.h"
 #include "Patient.h"
-#define RANDOM_ARGUMENT time(0)
-#define NEW_PT_RANGE 12
-#define NEW_VT_RANGE 10
+#include "SchedularPolicy.h"
 
 
-EarlyPlist ::EarlyPlist() : priQueue<Patient *>() {}
+template <class Policy>
+BasicEarlyPlist<Policy> ::BasicEarlyPlist() {}
 
-EarlyPlist ::~EarlyPlist()
+template <class Policy>
+BasicEarlyPlist<Policy> ::~BasicEarlyPlist()
 {
     // parent destructor will delete all nodes
 }
 
-Patient *EarlyPlist ::RandomReschedule(int presc, int lastArrivalTime)
+template <class Policy>
+Patient *BasicEarlyPlist<Policy> ::RandomReschedule(int presc, int lastArrivalTime, typename Policy::Random& rng)
 {
-    if ((rand() % 100) < presc)
+    typename Policy::Instrumentation::Scope profile(PROFILE_RANDOM_RESCHEDULE);
+
+    if (rng.Next(100) < presc)
     {
-        priQueue<Patient*> tempQueue;
+        typename Policy::template PriorityQueue<Patient*> tempQueue;
 
         Patient* tempPatient = nullptr;
 
         Patient* foundPatient = nullptr;
 
-        int tempPriority;
+        int tempPriority = 0;
+
+        int foundPriority = 0;
 
         int randomIndex = 0;
 
-        int CurrCount = getCount();
+        int CurrCount = this->getCount();
         if (CurrCount != 0)
         {
-            randomIndex = rand() % CurrCount; // Generate a random index
+            randomIndex = rng.Next(CurrCount); // Generate a random index
         }//else we choose the first patient to reschedule
         else
         {
@@ -62,6 +67,7 @@ Patient *EarlyPlist ::RandomReschedule(int presc, int lastArrivalTime)
                 {
                     //store their address for further processing
                     foundPatient = tempPatient;
+                    foundPriority = tempPriority;
 
                     //get out of the loop
                     break;
@@ -70,7 +76,7 @@ Patient *EarlyPlist ::RandomReschedule(int presc, int lastArrivalTime)
         }
 
         //continue deuque in the temp to preserve order
-        while (!isEmpty())
+        while (!this->isEmpty())
         {
             this->dequeue(tempPatient, tempPriority);
             tempQueue.enqueue(tempPatient, tempPriority);
@@ -91,8 +97,8 @@ Patient *EarlyPlist ::RandomReschedule(int presc, int lastArrivalTime)
             //generate new appointment data,
             //Task : how to insert them in all patients list by arrival time?
 
-            int new_PT = lastArrivalTime + (rand() % NEW_PT_RANGE);
-            int new_VT = lastArrivalTime + (rand() % NEW_VT_RANGE);
+            int new_PT = lastArrivalTime + rng.Next(Policy::reschedulePTRange);
+            int new_VT = lastArrivalTime + rng.Next(Policy::rescheduleVTRange);
 
             //reschdule to the same PT? doesnt seem right
             new_PT = (old_PT == new_PT) ? (new_PT + 1) : new_PT;
@@ -100,7 +106,12 @@ Patient *EarlyPlist ::RandomReschedule(int presc, int lastArrivalTime)
             //Same
             new_VT = (old_VT == new_VT) ? (new_VT + 1) : new_VT;
 
-            foundPatient->markRescheduled(new_PT, new_VT);
+            //the new appointment can't be earlier than the old one, keep the patient where they were
+            if (!foundPatient->markRescheduled(new_PT, new_VT))
+            {
+                this->enqueue(foundPatient, foundPriority);
+                foundPatient = nullptr;
+            }
         }
 
         return foundPatient;
@@ -109,4 +120,7 @@ Patient *EarlyPlist ::RandomReschedule(int presc, int lastArrivalTime)
     {
         return nullptr;
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_EARLY_PLIST(Policy) template class BasicEarlyPlist<Policy>;
+SCHEDULAR_POLICIES(INSTANTIATE_EARLY_PLIST)
@@ -2,8 +2,8 @@
  * @file EarlyPlist.h
  * @brief Defines the EarlyPlist class, a priority queue implementation for managing Early Patients objects.
  *
- * This file contains the declaration of the EarlyPlist class, which extends a generic priority queue
- * to handle pointer to Patient objects. It provides functionality for enqueuing and dequeuing patients based on
+ * This file contains the declaration of the EarlyPlist class, which extends the priority queue of a
+ * schedular policy (SchedularPolicy.h) to handle pointer to Patient objects. It provides functionality for enqueuing and dequeuing patients based on
  * priority, counting the number of patients, printing the queue contents, and selecting a random patient
  * for rescheduling.
  *
@@ -21,27 +21,29 @@
  */
 class Patient;
 #include "priQueue.h"
+#include "SchedularFwd.h"
 #include <random>
 #include <iostream>
 using namespace std;
 /**
- * @class EarlyPlist
+ * @class BasicEarlyPlist
  * @brief A class that represents a priority queue for managing Early Patients.
  *
- * This class extends the priQueue class to handle pointers to Patient objects. It provides methods for
+ * This class extends the priority queue of the policy to handle pointers to Patient objects. It provides methods for
  * enqueuing and dequeuing patients based on priority, counting the number of patients, printing the queue
  * contents, and selecting a random patient for rescheduling.
  */
-class EarlyPlist : public priQueue<Patient *>
+template <class Policy>
+class BasicEarlyPlist : public Policy::template PriorityQueue<Patient *>
 {
 public:
     /**
      * @brief Default constructor for EarlyPlist.
      * Initializes the priority queue and sets the patient count to zero.
      */
-    EarlyPlist();
+    BasicEarlyPlist();
 
-    ~EarlyPlist();
+    ~BasicEarlyPlist();
 
     /**
      * @brief Selects a random patient from the queue for rescheduling.
@@ -49,8 +51,12 @@ public:
      * @return Pointer to the randomly selected Patient object.
      * @details This method generates a random number between 0 and 100
      * if the number is less than pResch, we call getRandomReschedule();
+     * @param rng Random generator of the simulation.
      */
-    Patient* RandomReschedule(int pResch, int lastArrivalTime);
+    Patient* RandomReschedule(int pResch, int lastArrivalTime, typename Policy::Random& rng);
 };
 
+/** @brief Early list of the default Schedular. */
+typedef BasicEarlyPlist<DefaultSchedularPolicy> EarlyPlist;
+
 #endif // EARLYPLIST_H
@@ -0,0 +1,226 @@
+#include "EventLog.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+struct EventLogHeader
+{
+	char magic[4];      // "PCEV"
+	uint32_t version;   // 1
+};
+
+EventLog::EventLog() : used(0), events(0), lastTick(0), lastPatient(0), lastResource(0) {}
+
+EventLog::~EventLog() { Close(); }
+
+bool EventLog::Open(const string& fileName)
+{
+	Close();
+	outFile.open(fileName, ios::binary | ios::trunc);
+	if (!outFile.is_open())
+		return false;
+
+	block.assign(EVENT_LOG_BLOCK, 0);
+	used = 0;
+	events = 0;
+	lastTick = lastPatient = lastResource = 0;
+
+	EventLogHeader header = { { 'P', 'C', 'E', 'V' }, 1 };
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	return (bool)outFile;
+}
+
+void EventLog::Flush()
+{
+	if (used && outFile.is_open())
+		outFile.write(reinterpret_cast<const char*>(block.data()), used);
+	used = 0;
+}
+
+bool EventLog::Close()
+{
+	if (!outFile.is_open())
+		return true;
+
+	Flush();
+	bool written = (bool)outFile;
+	outFile.close();
+	return written;
+}
+
+//----------------------------------------------------------------------------------
+// READER
+//----------------------------------------------------------------------------------
+
+static bool GetVarint(const uint8_t*& at, const uint8_t* end, uint32_t& value)
+{
+	value = 0;
+	for (int shift = 0; at < end && shift < 35; shift += 7)
+	{
+		uint8_t byte = *at++;
+		value |= (uint32_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+static bool GetDelta(const uint8_t*& at, const uint8_t* end, int& previous)
+{
+	uint32_t zigzag = 0;
+	if (!GetVarint(at, end, zigzag))
+		return false;
+	int32_t delta = (int32_t)((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+	previous = (int)((uint32_t)previous + (uint32_t)delta);
+	return true;
+}
+
+bool EventLog::Replay(const string& fileName, int untilTick, EventLogState& state)
+{
+	MappedFile file;
+	if (!file.Open(fileName))
+	{
+		cout << "Error: Unable to open file " << fileName << endl;
+		return false;
+	}
+
+	const uint8_t* at = reinterpret_cast<const uint8_t*>(file.begin());
+	const uint8_t* end = reinterpret_cast<const uint8_t*>(file.end());
+	if (file.getSize() < sizeof(EventLogHeader) || memcmp(at, "PCEV", 4) != 0)
+	{
+		cout << "Error: " << fileName << " is not an event log." << endl;
+		return false;
+	}
+	at += sizeof(EventLogHeader);
+
+	state.tick = 0;
+	state.events = 0;
+	state.patients.clear();
+	state.resources.clear();
+
+	int tick = 0, patient = 0, resource = 0;
+	while (at < end)
+	{
+		//decode the record first, it is only applied if its tick is in range
+		uint8_t flags = *at++;
+		EventType type = (EventType)(flags & 0x0F);
+		uint32_t step = 0;
+		int eventTick = tick, eventPatient = 0, eventResource = 0;
+
+		if ((flags & EVENT_HAS_TICK) && GetVarint(at, end, step))
+			eventTick = tick + (int)step;
+		if ((flags & EVENT_HAS_PATIENT) && !GetDelta(at, end, patient))
+			break;
+		if ((flags & EVENT_HAS_RESOURCE) && !GetDelta(at, end, resource))
+			break;
+		if (flags & EVENT_HAS_PATIENT)
+			eventPatient = patient;
+		if (flags & EVENT_HAS_RESOURCE)
+			eventResource = resource;
+		if (type >= EVENT_TYPES)
+		{
+			cout << "Error: corrupted event log " << fileName << endl;
+			return false;
+		}
+
+		tick = eventTick;
+		if (untilTick >= 0 && tick > untilTick)
+			break;
+
+		state.tick = tick;
+		state.events++;
+
+		if (eventPatient)
+		{
+			EventLogState::PatientEntry& p = state.patients[eventPatient];
+			p.lastEvent = type;
+			p.resource = (type == EVENT_SERVE) ? eventResource : 0;
+		}
+
+		if (eventResource)
+		{
+			EventLogState::ResourceEntry& r = state.resources[eventResource];
+			switch (type)
+			{
+			case EVENT_SERVE:
+				r.occupants++;
+				break;
+			case EVENT_RELEASE:
+				if (r.occupants > 0)
+					r.occupants--;
+				break;
+			case EVENT_BUSY_FAILURE:
+				r.occupants = 0;
+				r.failed = true;
+				break;
+			case EVENT_FREE_FAILURE:
+				r.failed = true;
+				break;
+			case EVENT_REPAIR:
+				r.failed = false;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	if (untilTick >= 0)
+		state.tick = untilTick;
+	return true;
+}
+
+const char* EventLog::Name(EventType type)
+{
+	static const char* names[EVENT_TYPES] =
+	{
+		"early", "late", "wait E", "wait U", "wait X", "serve", "release", "interrupted",
+		"busy failure", "free failure", "repair", "cancelled", "rescheduled", "finished",
+		"wait other"
+	};
+	return (type >= 0 && type < EVENT_TYPES) ? names[type] : "unknown";
+}
+
+void EventLog::PrintState(const EventLogState& state, ostream& os, bool verbose)
+{
+	//a patient is in the list of their last event (a released patient moves on in the same tick)
+	int counts[EVENT_TYPES] = {};
+	for (const auto& p : state.patients)
+		counts[p.second.lastEvent]++;
+
+	int busy = 0, failed = 0;
+	for (const auto& r : state.resources)
+	{
+		busy += (r.second.occupants > 0);
+		failed += r.second.failed;
+	}
+
+	os << "=========== State at tick " << state.tick << " (" << state.events << " events) ===========\n";
+	os << "Early: " << counts[EVENT_EARLY] << " | Late: " << counts[EVENT_LATE]
+		<< " | Wait E/U/X/other: " << counts[EVENT_WAIT_E] << "/" << counts[EVENT_WAIT_U] << "/" << counts[EVENT_WAIT_X] << "/" << counts[EVENT_WAIT_OTHER]
+		<< " | In treatment: " << counts[EVENT_SERVE] << " | Interrupted: " << counts[EVENT_INTERRUPTED] + counts[EVENT_BUSY_FAILURE]
+		<< " | Rescheduled: " << counts[EVENT_RESCHEDULED]
+		<< " | Finished: " << counts[EVENT_FINISHED] << " | Cancelled: " << counts[EVENT_CANCELLED] << "\n";
+	os << "Resources seen: " << state.resources.size() << " | Busy: " << busy << " | Under maintenance: " << failed << "\n";
+
+	if (!verbose)
+		return;
+
+	for (const auto& r : state.resources)
+	{
+		os << "  Resource " << r.first << ": " << (r.second.failed ? "maintenance" : (r.second.occupants ? "busy" : "free"));
+		if (r.second.occupants)
+			os << " (" << r.second.occupants << " patients)";
+		os << "\n";
+	}
+	for (const auto& p : state.patients)
+	{
+		if (p.second.lastEvent == EVENT_FINISHED || p.second.lastEvent == EVENT_CANCELLED)
+			continue;
+		os << "  P" << p.first << ": " << Name(p.second.lastEvent);
+		if (p.second.resource)
+			os << " on " << p.second.resource;
+		os << "\n";
+	}
+}
@@ -0,0 +1,187 @@
+/**
+ * @file EventLog.h
+ * @brief Append-only binary log of patient and device state transitions, and its reader.
+ *
+ * The schedular reports every transition through a few choke points: arrival in the early or
+ * late list, entering a waiting list, starting and finishing a treatment, interruption, device
+ * failure and repair, cancellation, rescheduling and finishing. An EventLog attached with
+ * Schedular::setEventLog appends one record per transition:
+ *
+ *     flags      1 byte    event type (low 4 bits) | EVENT_HAS_TICK | EVENT_HAS_PATIENT | EVENT_HAS_RESOURCE
+ *     tick       varint    time steps since the previous record (only if it moved)
+ *     patient    varint    zigzag difference with the previous patient id (only if there is one)
+ *     resource   varint    zigzag difference with the previous resource id (only if there is one)
+ *
+ * Most records take 2 to 4 bytes. Records are encoded into a block owned by the log and the
+ * block is written once it is full, so an event costs a few stores and no system call. A log
+ * belongs to one simulation, and a simulation runs on one thread, so parallel runs
+ * (CapacityOptimizer) each keep their own log and block without locking.
+ *
+ * Replay reads a log back and rebuilds the state of every patient and resource at any tick.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+#define EVENT_LOG_BLOCK (1 << 20)   // bytes encoded before a block is written
+#define EVENT_MAX_RECORD 16         // flags + three 5 byte varints
+
+#define EVENT_HAS_TICK 0x10
+#define EVENT_HAS_PATIENT 0x20
+#define EVENT_HAS_RESOURCE 0x40
+
+/** @enum EventType
+ *  Logged transitions.
+ */
+enum EventType
+{
+    EVENT_EARLY,            ///< Patient arrived before the appointment
+    EVENT_LATE,             ///< Patient arrived after the appointment
+    EVENT_WAIT_E,           ///< Patient entered the E waiting list
+    EVENT_WAIT_U,           ///< Patient entered the U waiting list
+    EVENT_WAIT_X,           ///< Patient entered the X waiting list
+    EVENT_SERVE,            ///< Treatment started on a resource
+    EVENT_RELEASE,          ///< Treatment finished, the resource was released
+    EVENT_INTERRUPTED,      ///< Treatment interrupted by a busy failure
+    EVENT_BUSY_FAILURE,     ///< Device failed while treating the patient
+    EVENT_FREE_FAILURE,     ///< Device failed while free
+    EVENT_REPAIR,           ///< Device left maintenance
+    EVENT_CANCELLED,        ///< Patient cancelled the last X treatment and left
+    EVENT_RESCHEDULED,      ///< Patient moved back to the all list with a new appointment
+    EVENT_FINISHED,         ///< Patient finished every treatment
+    EVENT_WAIT_OTHER,       ///< Patient entered the waiting list of a lane declared in the input file
+    EVENT_TYPES
+};
+
+/**
+ * @struct EventLogState
+ * @brief Patients and resources rebuilt by EventLog::Replay.
+ */
+struct EventLogState
+{
+    /** @brief Last event of a patient and the resource they use (0 if none). */
+    struct PatientEntry { EventType lastEvent; int resource; };
+
+    /** @brief Patients using a resource and whether it is under maintenance. */
+    struct ResourceEntry { int occupants; bool failed; };
+
+    int tick;                               ///< Tick the state was rebuilt at
+    long long events;                       ///< Events replayed
+    map<int, PatientEntry> patients;        ///< Patients seen so far, by id
+    map<int, ResourceEntry> resources;      ///< Resources seen so far, by id
+};
+
+/**
+ * @class EventLog
+ * @brief Block buffered writer of transition records.
+ */
+class EventLog
+{
+private:
+    ofstream outFile;           ///< Log file
+    vector<uint8_t> block;      ///< Records not written yet
+    size_t used;                ///< Bytes used in the block
+    long long events;           ///< Records appended
+    int lastTick;               ///< Tick of the previous record
+    int lastPatient;            ///< Patient id of the previous record with a patient
+    int lastResource;           ///< Resource id of the previous record with a resource
+
+    /** @brief Appends an unsigned LEB128 varint. */
+    void PutVarint(uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            block[used++] = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+        block[used++] = (uint8_t)value;
+    }
+
+    /** @brief Appends a signed difference (zigzag, so small negative steps stay small). */
+    void PutDelta(int value, int& previous)
+    {
+        int32_t delta = (int32_t)((uint32_t)value - (uint32_t)previous);
+        PutVarint(((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+        previous = value;
+    }
+
+public:
+    EventLog();
+
+    /** @brief Flushes and closes the log. */
+    ~EventLog();
+
+    /**
+     * @brief Creates (truncates) the log file and writes its header.
+     * @return false if the file could not be created.
+     */
+    bool Open(const string& fileName);
+
+    /**
+     * @brief Writes the pending records and closes the file.
+     * @return false if a write failed.
+     */
+    bool Close();
+
+    /** @brief Writes the pending records. */
+    void Flush();
+
+    /** @brief Number of records appended since Open. */
+    long long getEventCount() const { return events; }
+
+    /**
+     * @brief Appends one record.
+     * @param tick Current time step (never decreases).
+     * @param type Transition.
+     * @param patient Patient id, 0 if the event has no patient.
+     * @param resource Resource id, 0 if the event has no resource.
+     */
+    void Record(int tick, EventType type, int patient, int resource = 0)
+    {
+        if (used + EVENT_MAX_RECORD > block.size())
+            Flush();
+
+        size_t flagsAt = used++;
+        uint8_t flags = (uint8_t)type;
+        if (tick != lastTick)
+        {
+            flags |= EVENT_HAS_TICK;
+            PutVarint((uint32_t)(tick - lastTick));
+            lastTick = tick;
+        }
+        if (patient)
+        {
+            flags |= EVENT_HAS_PATIENT;
+            PutDelta(patient, lastPatient);
+        }
+        if (resource)
+        {
+            flags |= EVENT_HAS_RESOURCE;
+            PutDelta(resource, lastResource);
+        }
+        block[flagsAt] = flags;
+        events++;
+    }
+
+    /**
+     * @brief Replays a log up to (and including) a tick.
+     * @param fileName Log written by an EventLog.
+     * @param untilTick Last tick applied, -1 for the whole log.
+     * @param state Receives the patients and resources at that tick.
+     * @return false if the file could not be read or is not an event log.
+     */
+    static bool Replay(const string& fileName, int untilTick, EventLogState& state);
+
+    /** @brief Prints the counts of a replayed state, and its patients and resources if verbose. */
+    static void PrintState(const EventLogState& state, ostream& os, bool verbose);
+
+    /** @brief Name of an event type. */
+    static const char* Name(EventType type);
+};
@@ -1,14 +1,10 @@
 #include "GymRoom.h"
-static int ID = 400; // Initialize static member
-
-GymRoom::GymRoom() : Resource(_Xdevice), curr_cap(0), room_capacity(1)
+GymRoom::GymRoom() : Resource(_Xdevice, X_THERAPY), curr_cap(0), room_capacity(1)
 {
-    id = ++ID;
 }
 
-GymRoom::GymRoom(int capacity) : Resource(_Xdevice), curr_cap(0), room_capacity(capacity)
+GymRoom::GymRoom(int capacity, TreatmentType lane) : Resource(_Xdevice, lane), curr_cap(0), room_capacity(capacity)
 {
-    id = ++ID;
 }
 
 int GymRoom::getAvailableSlots() const
@@ -16,6 +12,11 @@ int GymRoom::getAvailableSlots() const
     return (room_capacity - curr_cap);
 }
 
+int GymRoom::getCapacity() const
+{
+    return room_capacity;
+}
+
 void GymRoom::assignPatient()
 {
     if (status == FREE)
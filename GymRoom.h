@@ -27,8 +27,9 @@ public:
     /**
      * @brief Parameterized constructor.
      * @param capacity Maximum number of patients the room can hold.
+     * @param lane Room lane the room serves (X unless declared in the input file).
      */
-    GymRoom(int capacity);
+    GymRoom(int capacity, TreatmentType lane = X_THERAPY);
 
     /**
      * @brief Returns the number of available slots in the room.
@@ -36,6 +37,12 @@ public:
      */
     int getAvailableSlots() const;
 
+    /**
+     * @brief Returns the maximum number of patients the room can hold.
+     * @return Room capacity.
+     */
+    int getCapacity() const;
+
     /**
      * @brief Assigns a patient to the room.
      * Increments the count and updates room status accordingly.
@@ -53,4 +60,7 @@ public:
      * @param os Output stream.
      */
     void print(ostream& os) const override;
+
+    /** @brief Checkpoint saves and restores the room occupancy. */
+    friend class Checkpoint;
 };
@@ -0,0 +1,158 @@
+#pragma once
+#include <iostream>
+#include <vector>
+using namespace std;
+
+//This class implements the priority queue as a binary min heap in one array
+//It has the interface of priQueue, and the same order: the smallest priority is at the front,
+//and items of equal priority leave in the order they came in (every item carries an insertion
+//sequence that breaks the ties), so a simulation gives the same results with either queue.
+//enqueue and dequeue are O(log n) instead of the O(n) sorted insertion of priQueue.
+template <typename T>
+class HeapPriQueue
+{
+    struct Entry
+    {
+        T item;
+        int pri;
+        long long seq;  //insertion order among equal priorities
+    };
+
+    vector<Entry> heap;
+    long long nextSeq;
+
+    static bool before(const Entry& a, const Entry& b)
+    {
+        return (a.pri != b.pri) ? (a.pri < b.pri) : (a.seq < b.seq);
+    }
+
+    void siftUp(int i)
+    {
+        Entry moved = heap[i];
+        while (i > 0)
+        {
+            int parent = (i - 1) / 2;
+            if (!before(moved, heap[parent]))
+                break;
+            heap[i] = heap[parent];
+            i = parent;
+        }
+        heap[i] = moved;
+    }
+
+    void siftDown(int i)
+    {
+        int n = (int)heap.size();
+        Entry moved = heap[i];
+        while (true)
+        {
+            int child = 2 * i + 1;
+            if (child >= n)
+                break;
+            if (child + 1 < n && before(heap[child + 1], heap[child]))
+                child++;
+            if (!before(heap[child], moved))
+                break;
+            heap[i] = heap[child];
+            i = child;
+        }
+        heap[i] = moved;
+    }
+
+    //entries from front to back, for the traversals that must see the queue order
+    vector<Entry> sorted() const
+    {
+        HeapPriQueue<T> copy(*this);
+        vector<Entry> out;
+        out.reserve(heap.size());
+        while (!copy.heap.empty())
+        {
+            out.push_back(copy.heap[0]);
+            copy.heap[0] = copy.heap.back();
+            copy.heap.pop_back();
+            if (!copy.heap.empty())
+                copy.siftDown(0);
+        }
+        return out;
+    }
+
+public:
+    HeapPriQueue() : nextSeq(0) {}
+
+    //insert the new item after every item of a smaller or equal priority
+    void enqueue(const T& data, int priority)
+    {
+        heap.push_back({ data, priority, nextSeq++ });
+        siftUp((int)heap.size() - 1);
+    }
+
+    //replaces the content with count items already sorted by priority, a sorted array is already a heap
+    //returns false (queue left unchanged) if the priorities are not in order
+    bool assignSorted(const T* items, const int* priorities, int count)
+    {
+        for (int i = 1; i < count; i++)
+        {
+            if (priorities[i] < priorities[i - 1])
+                return false;
+        }
+
+        heap.clear();
+        heap.reserve(count);
+        for (int i = 0; i < count; i++)
+            heap.push_back({ items[i], priorities[i], nextSeq++ });
+        return true;
+    }
+
+    //pri stores the priority of the dequeued item
+    bool dequeue(T& topEntry, int& pri)
+    {
+        if (isEmpty())
+            return false;
+
+        topEntry = heap[0].item;
+        pri = heap[0].pri;
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+            siftDown(0);
+        return true;
+    }
+
+    bool peek(T& topEntry, int& pri)
+    {
+        if (isEmpty())
+            return false;
+
+        topEntry = heap[0].item;
+        pri = heap[0].pri;
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return heap.empty();
+    }
+
+    int getCount() const
+    {
+        return (int)heap.size();
+    }
+
+    void printQueue() const
+    {
+        for (const Entry& entry : sorted())
+            std::cout << *(entry.item) << "\n";  // Assuming operator<< is overloaded
+    }
+
+    //calls visit(item, priority) for every item from front to back (sorts a copy, O(n log n))
+    template <typename Visitor>
+    void Traverse(Visitor visit) const
+    {
+        for (const Entry& entry : sorted())
+        {
+            int pri = entry.pri;
+            T item = entry.item;
+            visit(item, pri);
+        }
+    }
+};
@@ -64,6 +64,8 @@ public:
 	int getCount() const;
 	bool peek(T& frntEntry)  const;
 	void printQueue() const;
+	template <typename Visitor>
+	void Traverse(Visitor visit) const;
 	~LinkedQueue();
 
 	//copy constructor
@@ -191,6 +193,23 @@ void LinkedQueue<T>::printQueue() const
 	}
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////
+/*
+Function: Traverse
+calls visit(item) for every item from front to back, without copying or modifying the queue.
+
+Input: visit : any callable taking a const T&.
+Output: none
+*/
+template <typename T>
+template <typename Visitor>
+void LinkedQueue<T>::Traverse(Visitor visit) const
+{
+	for (Node<T>* current = frontPtr; current != nullptr; current = current->getNext())
+	{
+		visit(current->getItem());
+	}
+}
 
 ///////////////////////////////////////////////////////////////////////////////////
 /*
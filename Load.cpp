@@ -1,38 +1,49 @@
 #include "Load.h"
 #include <assert.h>
 #include <iostream>
+#include <cctype>
 #include "Schedular.h"
+#include "MappedFile.h"
+#include "TextScanner.h"
+#include "BinaryRoster.h"
 
 Load::Load(string fileName) : _fileName(fileName)
 {
     // Constructor
 }
 
-void Load::LoadDataFromFile(Schedular& hospitalSystem)
+//next non-space character without reading it, 0 at the end of the input
+static char PeekToken(ifstream& l_inFile)
 {
-    ifstream l_inFile(_fileName + ".txt", ios::in);
-    if (!l_inFile.is_open()) 
-    {
-        cout << "Error: Unable to open file " << _fileName << ".txt" << endl;
-        return;
-    }
+    int next = (l_inFile >> ws).peek();
+    return (next == EOF) ? 0 : (char)next;
+}
 
+static char PeekToken(TextScanner& l_inFile)
+{
+    return l_inFile.peek();
+}
+
+//the parsing below is shared by the ifstream and the memory mapped (TextScanner) backends
+template <typename Input, class Policy>
+static bool ReadSettingsFrom(Input& l_inFile, BasicSchedular<Policy>& hospitalSystem, bool loadResources, int& numPatients)
+{
     // Step 1: Read the number of resources
     int numEDevices = 0, numUDevices = 0, numXRooms = 0;
     if (!(l_inFile >> numEDevices >> numUDevices >> numXRooms)) 
     {
         cout << "Error: Failed to read device counts." << endl;
-        return;
+        return false;
     }
 
     // Add E-therapy devices
-    for (int i = 0; i < numEDevices; i++) {
-        hospitalSystem.AddResource(new Edevice);
+    for (int i = 0; loadResources && i < numEDevices; i++) {
+        hospitalSystem.template CreateResource<Edevice>();
     }
 
     // Add U-therapy devices
-    for (int i = 0; i < numUDevices; i++) {
-        hospitalSystem.AddResource(new Udevice);
+    for (int i = 0; loadResources && i < numUDevices; i++) {
+        hospitalSystem.template CreateResource<Udevice>();
     }
 
     // Add X-therapy gym rooms
@@ -40,19 +51,58 @@ void Load::LoadDataFromFile(Schedular& hospitalSystem)
         int capacity;
         if (!(l_inFile >> capacity)) {
             cout << "Error: Failed to read gym room capacity." << endl;
-            return;
+            return false;
+        }
+        if (loadResources)
+            hospitalSystem.template CreateResource<GymRoom>(capacity);
+    }
+
+    // Step 1.1: Treatment lanes after E, U and X, each line starts with the treatment letter
+    // (the probabilities that follow start with a digit)
+    while (isalpha((unsigned char)PeekToken(l_inFile)))
+    {
+        char code, kind;
+        int count = 0;
+        if (!(l_inFile >> code >> kind >> count) || (kind != 'D' && kind != 'R'))
+        {
+            cout << "Error: Failed to read treatment lane." << endl;
+            return false;
+        }
+
+        TreatmentType lane = hospitalSystem.DeclareLane(code, (kind == 'D') ? DEVICE_LANE : ROOM_LANE);
+        if (lane == DUMMY_THERAPY)
+        {
+            cout << "Error: Treatment lane " << code << " is declared twice or there are more than " << MAX_LANES << " lanes." << endl;
+            return false;
+        }
+
+        // the caller only brings its own E, U and X resources, declared lanes always get theirs
+        for (int i = 0; i < count; i++)
+        {
+            if (kind == 'D')
+            {
+                hospitalSystem.template CreateResource<Device>(lane);
+                continue;
+            }
+
+            int capacity;
+            if (!(l_inFile >> capacity)) {
+                cout << "Error: Failed to read room capacity of treatment lane " << code << "." << endl;
+                return false;
+            }
+            hospitalSystem.template CreateResource<GymRoom>(capacity, lane);
         }
-        hospitalSystem.AddResource(new GymRoom(capacity));
     }
 
-    hospitalSystem.UpdateNumberResources();
+    if (loadResources)
+        hospitalSystem.UpdateNumberResources();
 
     // Step 2: Read probabilities
     int Pcancel = 0, Presc = 0, pFF = 0, pBF = 0;
     if (!(l_inFile >> Pcancel >> Presc >> pFF >> pBF)) 
     {
         cout << "Error: Failed to read probabilities." << endl;
-        return;
+        return false;
     }
 
     hospitalSystem.setpCancel(Pcancel);
@@ -61,14 +111,19 @@ void Load::LoadDataFromFile(Schedular& hospitalSystem)
     hospitalSystem.setpBusyFail(pBF);
 
     // Step 3: Read the number of patients
-    int numPatients = 0;
+    numPatients = 0;
     if (!(l_inFile >> numPatients)) 
     {
         cout << "Error: Failed to read the number of patients." << endl;
-        return;
+        return false;
     }
 
-    // Step 4: Read patient details
+    return true;
+}
+
+template <typename Input, class Policy>
+static void ReadPatientsFrom(Input& l_inFile, BasicSchedular<Policy>& hospitalSystem, int numPatients)
+{
     for (int i = 0; i < numPatients; i++) {
         char patientTypeChar;
         int arrivalTime, appointmentTime, numTreatments;    
@@ -82,7 +137,7 @@ void Load::LoadDataFromFile(Schedular& hospitalSystem)
         PatientType patientType = (patientTypeChar == 'N') ? NORMAL : RECOVERING;
 
         // Create the patient object
-        Patient* patient = new Patient(appointmentTime, arrivalTime, patientType);
+        Patient* patient = new (hospitalSystem.getArena()) Patient(appointmentTime, arrivalTime, patientType);
 
         // Read treatments
         for (int j = 0; j < numTreatments; j++) 
@@ -94,25 +149,146 @@ void Load::LoadDataFromFile(Schedular& hospitalSystem)
                 return;
             }
 
-            if (treatmentType == 'E')
-                patient->addTreatment(new E_treatment(duration));
-            else if (treatmentType == 'U')
-                patient->addTreatment(new U_treatment(duration));
-            else if (treatmentType == 'X')
-                patient->addTreatment(new X_treatment(duration));
+            // the letter names the lane, unknown letters and repeated types are skipped
+            TreatmentType lane = hospitalSystem.getLane(treatmentType);
+            if (lane == DUMMY_THERAPY)
+                continue;
+
+            if (!patient->addTreatment(Treatment(duration, lane)) && patient->getNumber_RemainingTreatment() == MAX_TREATMENTS)
+            {
+                cout << "Error: Patient at entry " << i + 1 << " requires more than " << MAX_TREATMENTS << " treatments" << endl;
+                delete patient;
+                return;
+            }
+        }
+
+        // a patient without treatments would never leave the simulation
+        if (patient->getNumber_RemainingTreatment() == 0)
+        {
+            cout << "Error: Patient at entry " << i + 1 << " has no treatment of a known type" << endl;
+            delete patient;
+            return;
         }
 
         // Add patient to system
         hospitalSystem.AddToAllList(patient);
     }
+}
+
+template <class Policy>
+bool Load::ReadSettings(ifstream& l_inFile, BasicSchedular<Policy>& hospitalSystem, bool loadResources, int& numPatients)
+{
+    return ReadSettingsFrom(l_inFile, hospitalSystem, loadResources, numPatients);
+}
+
+template <class Policy>
+void Load::LoadDataFromFile(BasicSchedular<Policy>& hospitalSystem, bool loadResources)
+{
+    ifstream l_inFile(_fileName + ".txt", ios::in);
+    if (!l_inFile.is_open()) 
+    {
+        cout << "Error: Unable to open file " << _fileName << ".txt" << endl;
+        return;
+    }
+
+    // Steps 1 to 3: resources, probabilities and the number of patients
+    int numPatients = 0;
+    if (!ReadSettings(l_inFile, hospitalSystem, loadResources, numPatients))
+        return;
+
+    // Step 4: Read patient details
+    ReadPatientsFrom(l_inFile, hospitalSystem, numPatients);
 
     l_inFile.close();
 }
 
+template <class Policy>
+void Load::LoadDataFromMappedFile(BasicSchedular<Policy>& hospitalSystem, bool loadResources)
+{
+    MappedFile l_inMap;
+    if (!l_inMap.Open(_fileName + ".txt"))
+    {
+        cout << "Error: Unable to open file " << _fileName << ".txt" << endl;
+        return;
+    }
+
+    TextScanner l_inFile(l_inMap.begin(), l_inMap.end());
+
+    // Steps 1 to 3: resources, probabilities and the number of patients
+    int numPatients = 0;
+    if (!ReadSettingsFrom(l_inFile, hospitalSystem, loadResources, numPatients))
+        return;
+
+    // Step 4: Read patient details
+    ReadPatientsFrom(l_inFile, hospitalSystem, numPatients);
+}
+
+
+template <class Policy>
+void Load::LoadDataFromRoster(BasicSchedular<Policy>& hospitalSystem, bool loadResources)
+{
+    MappedFile l_inMap;
+    if (!l_inMap.Open(_fileName + ".bin"))
+    {
+        cout << "Error: Unable to open file " << _fileName << ".bin" << endl;
+        return;
+    }
+
+    const RosterHeader* header = nullptr;
+    const int32_t* capacities = nullptr;
+    const RosterPatient* records = nullptr;
+    if (!BinaryRoster::Open(l_inMap, header, capacities, records))
+        return;
+
+    // Step 1: Resources
+    for (int i = 0; loadResources && i < header->numEDevices; i++) {
+        hospitalSystem.template CreateResource<Edevice>();
+    }
+
+    for (int i = 0; loadResources && i < header->numUDevices; i++) {
+        hospitalSystem.template CreateResource<Udevice>();
+    }
+
+    for (int i = 0; loadResources && i < header->numXRooms; i++) {
+        hospitalSystem.template CreateResource<GymRoom>(capacities[i]);
+    }
+
+    if (loadResources)
+        hospitalSystem.UpdateNumberResources();
+
+    // Step 2: Probabilities
+    hospitalSystem.setpCancel(header->pCancel);
+    hospitalSystem.setpResch(header->pResc);
+    hospitalSystem.setpFreeFail(header->pFreeFailure);
+    hospitalSystem.setpBusyFail(header->pBusyFailure);
+
+    // Step 3: Patients, built straight from the mapped records
+    for (uint32_t i = 0; i < header->numPatients; i++) {
+        const RosterPatient& record = records[i];
 
-bool Load::GenerateRandomPatient(Schedular& hospitalSystem)
+        PatientType patientType = record.isRecovering() ? RECOVERING : NORMAL;
+        Patient* patient = new (hospitalSystem.getArena()) Patient(record.PT, record.VT, patientType);
+
+        for (int j = 0; j < record.getTreatmentCount(); j++)
+        {
+            switch (record.getTreatmentType(j))
+            {
+            case E_THERAPY: patient->addTreatment(E_treatment(record.durations[j])); break;
+            case U_THERAPY: patient->addTreatment(U_treatment(record.durations[j])); break;
+            default:        patient->addTreatment(X_treatment(record.durations[j])); break;
+            }
+        }
+
+        hospitalSystem.AddToAllList(patient);
+    }
+}
+
+template <class Policy>
+bool Load::GenerateRandomPatient(BasicSchedular<Policy>& hospitalSystem)
 {
-    int _generate_patient = rand() % 100;
+    typename Policy::Random& rng = hospitalSystem.getRandomGenerator();
+
+    int _generate_patient = rng.Next(100);
 
     if (_generate_patient >= 70)
     {
@@ -127,17 +303,17 @@ bool Load::GenerateRandomPatient(Schedular& hospitalSystem)
         //random appointment time
         if (_curr_time < _last_arrival_time)
         {
-            _rand_PT = _last_arrival_time + rand() % NEW_PT_RANGE;
+            _rand_PT = _last_arrival_time + rng.Next(Policy::newPatientPTRange);
 
-            _rand_VT = _last_arrival_time + rand() % NEW_VT_RANGE;
+            _rand_VT = _last_arrival_time + rng.Next(Policy::newPatientVTRange);
         }
         else
         {
-            _rand_PT = _curr_time + rand() % NEW_PT_RANGE;
+            _rand_PT = _curr_time + rng.Next(Policy::newPatientPTRange);
             if (_rand_PT == _curr_time)
                 _rand_PT++;
 
-            _rand_VT = _curr_time + rand() % NEW_VT_RANGE;
+            _rand_VT = _curr_time + rng.Next(Policy::newPatientVTRange);
             if (_rand_VT == _curr_time)
                 _rand_VT++;
 
@@ -146,41 +322,40 @@ bool Load::GenerateRandomPatient(Schedular& hospitalSystem)
         }
 
         //if the rand interger is an integer number 0, condition is false, Normal patient is generated
-        //I casted the rand output into int because I need to check on aboslute zero or one
-        PatientType _rand_type = ((int)(rand() % 2)) ? RECOVERING : NORMAL;
+        PatientType _rand_type = rng.Next(2) ? RECOVERING : NORMAL;
 
-        Patient* myPatient = new Patient(_rand_PT, _rand_VT, _rand_type);
+        Patient* myPatient = new (hospitalSystem.getArena()) Patient(_rand_PT, _rand_VT, _rand_type);
 
         assert(myPatient && "No more memory for extra patient");
 
-        int _add_Etreatment = rand() % 100;
-        int _add_Utreatment = rand() % 100;
-        int _add_Xtreatment = rand() % 100;
+        int _add_Etreatment = rng.Next(100);
+        int _add_Utreatment = rng.Next(100);
+        int _add_Xtreatment = rng.Next(100);
 
         if (_add_Etreatment >= 0 && _add_Etreatment < MAX_PROBABILITY_E)
         {
-            int _rand_treatment_time = rand() % NEW_TREATMENT_DURATION_RANGE;
+            int _rand_treatment_time = rng.Next(Policy::newTreatmentDurationRange);
             if (_rand_treatment_time != 0)
             {
-                myPatient->addTreatment(new E_treatment(_rand_treatment_time));
+                myPatient->addTreatment(E_treatment(_rand_treatment_time));
             }
         }
 
         if (_add_Utreatment >= MAX_PROBABILITY_E && _add_Utreatment < MAX_PROBABILITY_U)
         {
-            int _rand_treatment_time = rand() % NEW_TREATMENT_DURATION_RANGE;
+            int _rand_treatment_time = rng.Next(Policy::newTreatmentDurationRange);
             if (_rand_treatment_time != 0)
             {
-                myPatient->addTreatment(new U_treatment(_rand_treatment_time));
+                myPatient->addTreatment(U_treatment(_rand_treatment_time));
             }
         }
 
         if (_add_Xtreatment >= MAX_PROBABILITY_U && _add_Xtreatment < MAX_PROBABILITY_X)
         {
-            int _rand_treatment_time = rand() % NEW_TREATMENT_DURATION_RANGE;
+            int _rand_treatment_time = rng.Next(Policy::newTreatmentDurationRange);
             if (_rand_treatment_time != 0)
             {
-                myPatient->addTreatment(new X_treatment(_rand_treatment_time));
+                myPatient->addTreatment(X_treatment(_rand_treatment_time));
             }
         }
 
@@ -201,4 +376,12 @@ bool Load::GenerateRandomPatient(Schedular& hospitalSystem)
     {
         return false;
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_LOAD(Policy) \
+    template void Load::LoadDataFromFile(BasicSchedular<Policy>&, bool); \
+    template void Load::LoadDataFromMappedFile(BasicSchedular<Policy>&, bool); \
+    template void Load::LoadDataFromRoster(BasicSchedular<Policy>&, bool); \
+    template bool Load::ReadSettings(ifstream&, BasicSchedular<Policy>&, bool, int&); \
+    template bool Load::GenerateRandomPatient(BasicSchedular<Policy>&);
+SCHEDULAR_POLICIES(INSTANTIATE_LOAD)
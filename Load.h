@@ -15,11 +15,9 @@
 #include <string>
 using namespace std;
 #include "LinkedQueue.h"
+#include "SchedularFwd.h"
 
-//some macros for generating a random patient
-#define NEW_PT_RANGE 5
-#define NEW_VT_RANGE 5
-#define NEW_TREATMENT_DURATION_RANGE 5
+//some macros for generating a random patient (the time ranges come from the schedular policy)
 #define MAX_PROBABILITY_E 33
 #define MAX_PROBABILITY_U 66
 #define MAX_PROBABILITY_X 100
@@ -28,11 +26,12 @@ class Patient;
 class E_device;
 class U_device;
 class Gym_Room;
-class Schedular;
 
 /**
  * @class Load
  * @brief Responsible for reading simulation data from input files and generating random patients.
+ *
+ * Every function takes a schedular of any policy (SchedularPolicy.h).
  */
 class Load
 {
@@ -51,12 +50,56 @@ public:
      *
      * This includes reading:
      * - Resource counts and capacities (E, U devices, X rooms)
+     * - Optional treatment lanes after E, U and X, one line each starting with the treatment letter:
+     *   "<letter> D <devices>" for a device lane, "<letter> R <rooms> <capacities...>" for a room lane
      * - Probability values (cancellation, rescheduling, free failure, busy failure)
-     * - Patient details including type, times, and treatment needs
+     * - Patient details including type, times, and treatment needs. Unknown letters and repeated
+     *   types are skipped; a patient needing more than MAX_TREATMENTS treatments, or none of a
+     *   known type, is an error that stops the load
+     *
+     * @param hospitalSystem Reference to the Schedular object to populate
+     * @param loadResources If false, the device counts and room capacities are read but no
+     *        resources are added, so the caller can register its own resource mix
+     *        (declared lanes always get the resources of the file)
+     */
+    template <class Policy>
+    void LoadDataFromFile(BasicSchedular<Policy>& hospitalSystem, bool loadResources = true);
+
+    /**
+     * @brief Same as LoadDataFromFile, but memory maps the file and tokenises it with TextScanner.
+     *
+     * Much faster on large inputs, reports the same errors as LoadDataFromFile.
+     *
+     * @param hospitalSystem Reference to the Schedular object to populate
+     * @param loadResources If false, the resources are read but not added
+     */
+    template <class Policy>
+    void LoadDataFromMappedFile(BasicSchedular<Policy>& hospitalSystem, bool loadResources = true);
+
+    /**
+     * @brief Loads the binary roster (fileName.bin, see BinaryRoster.h) written by the converter.
+     *
+     * The roster is memory mapped and the patients are built directly from its records.
+     *
+     * @param hospitalSystem Reference to the Schedular object to populate
+     * @param loadResources If false, the resources are read but not added
+     */
+    template <class Policy>
+    void LoadDataFromRoster(BasicSchedular<Policy>& hospitalSystem, bool loadResources = true);
+
+    /**
+     * @brief Reads everything before the patient entries: resources, probabilities and the patient count.
+     *
+     * Shared by LoadDataFromFile and PatientStream, which then read the patient entries their own way.
      *
+     * @param l_inFile Input file positioned at its beginning
      * @param hospitalSystem Reference to the Schedular object to populate
+     * @param loadResources If false, the resources are read but not added
+     * @param numPatients Receives the number of patient entries that follow
+     * @return false if the file is malformed (the error is already reported)
      */
-    void LoadDataFromFile(Schedular& hospitalSystem);
+    template <class Policy>
+    static bool ReadSettings(ifstream& l_inFile, BasicSchedular<Policy>& hospitalSystem, bool loadResources, int& numPatients);
 
     /**
      * @brief Generates a random patient and adds them to the scheduler system.
@@ -69,7 +112,8 @@ public:
      * @param hospitalSystem Reference to the Schedular system
      * @return true if a patient was successfully generated and added; false otherwise
      */
-    bool GenerateRandomPatient(Schedular& hospitalSystem);
+    template <class Policy>
+    bool GenerateRandomPatient(BasicSchedular<Policy>& hospitalSystem);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : data(nullptr), size(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+
+bool MappedFile::Open(const string& fileName)
+{
+	Close();
+
+	fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		Close();
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+
+	//an empty file can't be mapped, but it is a valid (empty) input
+	if (size == 0)
+	{
+		data = "";
+		return true;
+	}
+
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mappingHandle)
+	{
+		Close();
+		return false;
+	}
+
+	data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data && size)
+		UnmapViewOfFile(data);
+	if (mappingHandle)
+		CloseHandle(mappingHandle);
+	if (fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(fileHandle);
+
+	data = nullptr;
+	size = 0;
+	mappingHandle = nullptr;
+	fileHandle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile() : data(nullptr), size(0), fileDescriptor(-1) {}
+
+bool MappedFile::Open(const string& fileName)
+{
+	Close();
+
+	fileDescriptor = open(fileName.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fileDescriptor, &info) != 0)
+	{
+		Close();
+		return false;
+	}
+	size = (size_t)info.st_size;
+
+	//an empty file can't be mapped, but it is a valid (empty) input
+	if (size == 0)
+	{
+		data = "";
+		return true;
+	}
+
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (mapping == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+
+	//the file is read once from front to back
+	madvise(mapping, size, MADV_SEQUENTIAL);
+
+	data = (const char*)mapping;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data && size)
+		munmap((void*)data, size);
+	if (fileDescriptor >= 0)
+		close(fileDescriptor);
+
+	data = nullptr;
+	size = 0;
+	fileDescriptor = -1;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
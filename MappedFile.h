@@ -0,0 +1,56 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole input file.
+ *
+ * The file content is accessed in place through the page cache, without being copied into
+ * stream buffers. Uses mmap on POSIX systems and CreateFileMapping on Windows.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <string>
+#include <cstddef>
+using namespace std;
+
+/**
+ * @class MappedFile
+ * @brief Owns a read-only mapping of one file, released on Close or destruction.
+ */
+class MappedFile
+{
+private:
+    const char* data;       ///< First byte of the mapping (nullptr if nothing is mapped)
+    size_t size;            ///< Size of the file in bytes
+
+#ifdef _WIN32
+    void* fileHandle;       ///< Windows file handle
+    void* mappingHandle;    ///< Windows file mapping handle
+#else
+    int fileDescriptor;     ///< POSIX file descriptor
+#endif
+
+public:
+    /** @brief Constructs an empty mapping. */
+    MappedFile();
+
+    /** @brief Releases the mapping. */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps a whole file for reading, releasing any previous mapping.
+     * @param fileName Path of the file.
+     * @return false if the file could not be opened or mapped.
+     */
+    bool Open(const string& fileName);
+
+    /** @brief Releases the mapping. */
+    void Close();
+
+    const char* begin() const { return data; }          ///< First byte of the file
+    const char* end() const { return data + size; }     ///< One past the last byte of the file
+    size_t getSize() const { return size; }             ///< Size of the file in bytes
+};
@@ -0,0 +1,25 @@
+#include "MersenneGenerator.h"
+
+MersenneGenerator::MersenneGenerator(unsigned long long seed) : engine(seed)
+{
+}
+
+void MersenneGenerator::setSeed(unsigned long long seed)
+{
+	engine.seed(seed);
+}
+
+int MersenneGenerator::Next(int range)
+{
+	if (range <= 0)
+		return 0;
+
+	//same scaling of the upper 32 bits as RandomGenerator
+	unsigned long long high = engine() >> 32;
+	return (int)((high * (unsigned long long)range) >> 32);
+}
+
+double MersenneGenerator::NextDouble()
+{
+	return (double)(engine() >> 11) * (1.0 / 9007199254740992.0);
+}
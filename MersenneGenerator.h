@@ -0,0 +1,47 @@
+/**
+ * @file MersenneGenerator.h
+ * @brief Declares the MersenneGenerator class, a second random number source for the schedular.
+ *
+ * MersenneGenerator has the interface the simulation uses from RandomGenerator (Next,
+ * NextDouble, setSeed) over std::mt19937_64. A schedular built with it (MersenneSchedularPolicy)
+ * draws from an independent, much longer sequence, which checks that results do not depend
+ * on the particular generator. Equal seeds still replay the same run, but not the same run as
+ * RandomGenerator, and its state is too large for a checkpoint.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <random>
+
+/**
+ * @class MersenneGenerator
+ * @brief Random source with the RandomGenerator interface over the standard Mersenne Twister.
+ */
+class MersenneGenerator
+{
+private:
+    std::mt19937_64 engine;     ///< 64-bit Mersenne Twister
+
+public:
+    /**
+     * @brief Constructs a generator from a seed.
+     * @param seed Any value, equal seeds give equal sequences.
+     */
+    MersenneGenerator(unsigned long long seed = 1);
+
+    /**
+     * @brief Restarts the sequence from a new seed.
+     * @param seed Any value, equal seeds give equal sequences.
+     */
+    void setSeed(unsigned long long seed);
+
+    /**
+     * @brief Returns a random integer in [0, range), 0 if range is not positive.
+     * @param range Number of possible values.
+     */
+    int Next(int range);
+
+    /** @brief Returns a random double in [0, 1) with 53 random bits. */
+    double NextDouble();
+};
@@ -1,6 +1,5 @@
 #ifndef _NODE
 #define _NODE
-#include "Treatment.h"
 template < typename T>
 class Node
 {
@@ -60,51 +59,3 @@ Node<T>* Node<T>::getNext() const
 {
 	return next;
 }
-
-template<>
-class Node<Treatment*>
-{
-private:
-	Treatment* item; // A data item
-	Node<Treatment*>* next; // Pointer to next node
-public:
-	Node()
-	{
-		item = nullptr;
-		next = nullptr;
-	}
-
-	Node(Treatment* r_Item)
-	{
-		item = r_Item;
-		next = nullptr;
-	}
-
-	Node(Treatment* r_Item, Node<Treatment* >* nextNodePtr)
-	{
-		item = r_Item;
-		next = nextNodePtr;
-	}
-
-	void setItem(Treatment* r_Item)
-	{
-		item = r_Item;
-	}
-
-	void setNext(Node<Treatment*>* nextNodePtr)
-	{
-		next = nextNodePtr;
-	}
-
-
-	Treatment* getItem() const
-	{
-		return item;
-	}
-
-
-	Node<Treatment* >* getNext() const
-	{
-		return next;
-	}
-};
\ No newline at end of file
@@ -21,19 +21,24 @@
 #include <string>
 using namespace std;
 #include "LinkedQueue.h"
+#include "ResultWriter.h"
+#include "SchedularFwd.h"
 
 class Patient;
 class E_device;
 class U_device;
 class Gym_Room;
-class Schedular;
 
 class Output
 {
 	string _fileName;
 public:
     Output(string fileName);
-    void GenerateOutputFile(const std::string& filename, const Schedular& mySchedular);
+    /**
+     * @brief Writes every finished patient (last finished first) and the statistics of the run.
+     * @param format TEXT_OUTPUT (fixed width table), CSV_OUTPUT or COLUMNAR_OUTPUT, see ResultWriter.h
+     */
+    void GenerateOutputFile(const std::string& filename, const Schedular& mySchedular, OutputFormat format = TEXT_OUTPUT);
 };
 
 
@@ -0,0 +1,30 @@
+/**
+ * @file OutputSink.h
+ * @brief Interface receiving every patient the moment they finish.
+ *
+ * A Schedular with an output sink (Schedular::setOutputSink) hands each finished or cancelled
+ * patient to the sink from IsPatientFinished, with its finish time already set. ResultWriter
+ * is the sink writing result rows to a file.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+
+class Patient;
+
+/**
+ * @class OutputSink
+ * @brief Receives finished patients one at a time.
+ */
+class OutputSink
+{
+public:
+    /**
+     * @brief Called once per patient when they finish or are cancelled.
+     * @param myPatient The finished patient, only valid during the call if the Schedular reclaims finished patients.
+     */
+    virtual void PatientFinished(const Patient* myPatient) = 0;
+
+    virtual ~OutputSink() {}
+};
@@ -1,20 +1,33 @@
 #include "Patient.h"
+#include "StatusIndex.h"
+#include <algorithm>
+#include <atomic>
 
 // Static counter for assigning unique IDs
-static int ID = 100;
+// atomic, since several simulations may load their patients concurrently
+static atomic<int> ID(100);
 
 //----------------------------------- CONSTRUCTORS -----------------------------------//
 
+void Patient::ReserveIDs(int lastPID)
+{
+    //only ever raised, a concurrent constructor may have passed lastPID already
+    int current = ID.load();
+    while (current < lastPID && !ID.compare_exchange_weak(current, lastPID)) {}
+}
+
 // Default constructor: Initializes an empty patient with default values
 Patient::Patient()
     : PID(++ID), PT(-1), VT(-1),
-    pType(DUMMY_PTYPE), status(IDLE), LastChangeTimeStamp(0),
+    pType(DUMMY_PTYPE), treatmentCount(0), status(IDLE), LastChangeTimeStamp(0),
     cancelled(false), rescheduled(false),
-    totalWaitingTime(0), totalTreatmentTime(0), finishTime(-1) {}
+    totalWaitingTime(0), totalTreatmentTime(0), finishTime(-1),
+    statusPrev(nullptr), statusNext(nullptr), statusIndex(nullptr) {}
 
 // Constructor with patient type, appointment time, and arrival time
 Patient::Patient(int pt, int vt, PatientType type) :
-    LastChangeTimeStamp(0), cancelled(false), rescheduled(false), totalWaitingTime(0), totalTreatmentTime(0), finishTime(-1)
+    treatmentCount(0), LastChangeTimeStamp(0), cancelled(false), rescheduled(false), totalWaitingTime(0), totalTreatmentTime(0), finishTime(-1),
+    statusPrev(nullptr), statusNext(nullptr), statusIndex(nullptr)
 {
     PID = ++ID;
     pType = type;
@@ -25,7 +38,8 @@ Patient::Patient(int pt, int vt, PatientType type) :
 
 // Constructor with specific patient ID
 Patient::Patient(int id, int pt, int vt, PatientType type) :
-    LastChangeTimeStamp(0), cancelled(false), rescheduled(false), totalWaitingTime(0), totalTreatmentTime(0), finishTime(-1)
+    treatmentCount(0), LastChangeTimeStamp(0), cancelled(false), rescheduled(false), totalWaitingTime(0), totalTreatmentTime(0), finishTime(-1),
+    statusPrev(nullptr), statusNext(nullptr), statusIndex(nullptr)
 {
     PID = id;
     pType = type;
@@ -34,48 +48,42 @@ Patient::Patient(int id, int pt, int vt, PatientType type) :
     status = (vt < pt) ? EARLY : LATE;
 }
 
-// Constructor with predefined treatments queue
-Patient::Patient(int id, int pt, int vt, PatientType type, LinkedQueue<Treatment*> req_treat):
-    LastChangeTimeStamp(0), cancelled(false), rescheduled(false), totalWaitingTime(0), totalTreatmentTime(0), finishTime(-1)
+Patient::~Patient()
 {
-    PID = id;
-    pType = type;
-    PT = pt;
-    VT = vt;
-    Required_Treatments = req_treat;
-    status = (vt < pt) ? EARLY : LATE;
+    if (statusIndex)
+        statusIndex->Detach(this);
 }
 
 //----------------------------------- TREATMENT HANDLING -----------------------------------//
 
 // Adds a treatment if not already added and maximum not reached
-bool Patient::addTreatment(Treatment* newTreatment)
+bool Patient::addTreatment(const Treatment& newTreatment)
 {
-    if (!newTreatment || Required_Treatments.getCount() == 3)
+    TreatmentType type = newTreatment.getType();
+    if (treatmentCount == MAX_TREATMENTS || type < 0 || type >= MAX_LANES)
         return false;
 
-    if (E_treatment* e = dynamic_cast<E_treatment*>(newTreatment))
+    for (int i = 0; i < treatmentCount; i++)
     {
-        return addTreatmentHelper<E_treatment>(e);
-    }
-    else if (U_treatment* u = dynamic_cast<U_treatment*>(newTreatment))
-    {
-        return addTreatmentHelper<U_treatment>(u);
-    }
-    else if (X_treatment* x = dynamic_cast<X_treatment*>(newTreatment))
-    {
-        return addTreatmentHelper<X_treatment>(x);
+        if (Required_Treatments[i].getType() == type)
+            return false;
     }
 
-    return false;
+    Required_Treatments[treatmentCount++] = newTreatment;
+    return true;
 }
 
 //----------------------------------- SETTERS -----------------------------------//
 
 void Patient::setStatus(PatientStatus newStatus)
 {
-    if (status != FINISHED)
-        status = newStatus;
+    if (status == FINISHED || status == newStatus)
+        return;
+
+    PatientStatus from = status;
+    status = newStatus;
+    if (statusIndex)
+        statusIndex->Moved(this, from);
 }
 
 void Patient::setFinishTime(int time)
@@ -112,31 +120,26 @@ void Patient::addTreatmentTime(int timesteps)
 
 //----------------------------------- TREATMENT MANAGEMENT -----------------------------------//
 
-Treatment* Patient::getNextTreatment() const
-{
-    Treatment* t = nullptr;
-    Required_Treatments.peek(t);
-    return t; // Returns nullptr if no treatment is available
-}
-
 bool Patient::completeCurrentTreatment(int CurrentTime)
 {
-    Treatment* treatment = nullptr;
-    if (Required_Treatments.dequeue(treatment))
-    {
-        treatment->setFinishTime(CurrentTime);
-        treatment->FreeResource();
+    if (treatmentCount == 0)
+        return false;
 
-        totalTreatmentTime += treatment->getDuration();
+    Treatment& treatment = Required_Treatments[0];
+    treatment.setFinishTime(CurrentTime);
+    treatment.FreeResource();
 
-        Treatment* Nexttreatment = nullptr;
-        Required_Treatments.peek(Nexttreatment);
+    totalTreatmentTime += treatment.getDuration();
 
-        if (!Nexttreatment)
-            status = FINISHED;
-    }
+    //the next treatment moves to the front
+    for (int i = 1; i < treatmentCount; i++)
+        Required_Treatments[i - 1] = Required_Treatments[i];
+    treatmentCount--;
+
+    if (treatmentCount == 0)
+        setStatus(FINISHED);
 
-    return treatment;
+    return true;
 }
 
 //----------------------------------- GETTERS -----------------------------------//
@@ -146,14 +149,14 @@ PatientType Patient::getType() const { return pType; }
 int Patient::getAppointmentTime() const { return PT; }
 int Patient::getArrivalTime() const { return VT; }
 
-LinkedQueue<Treatment*> Patient::getRemainingTreatments() const 
-{ 
-    return Required_Treatments; 
+const Treatment* Patient::getRemainingTreatment(int index) const
+{
+    return (index >= 0 && index < treatmentCount) ? &Required_Treatments[index] : nullptr;
 }
 
 int Patient::getNumber_RemainingTreatment() const
 {
-    return Required_Treatments.getCount();
+    return treatmentCount;
 }
 
 PatientStatus Patient::getStatus() const { return status; }
@@ -169,21 +172,23 @@ bool Patient::isFinished() const { return (status == FINISHED); }
 
 void Patient::markCancelled()
 {
-    if (status == WAIT && !Required_Treatments.isEmpty())
+    if (status == WAIT && treatmentCount > 0)
     {
         cancelled = true;
-        status = FINISHED;
+        setStatus(FINISHED);
     }
 }
 
-void Patient::markRescheduled(int newPT, int newVT)
+bool Patient::markRescheduled(int newPT, int newVT)
 {
     if (status == EARLY && newPT >= PT && newVT >= VT)
     {
         PT = newPT;
         VT = newVT;
         rescheduled = true;
+        return true;
     }
+    return false;
 }
 
 void Patient::ResortTreatments(TreatmentType Ttype)
@@ -191,26 +196,13 @@ void Patient::ResortTreatments(TreatmentType Ttype)
     if (pType != RECOVERING)
         return;
 
-    LinkedQueue<Treatment*> temp;
-    Treatment* _priority_treatment = nullptr;
+    int priority = 0;
+    while (priority < treatmentCount && Required_Treatments[priority].getType() != Ttype)
+        priority++;
 
-    while (Required_Treatments.peek(_priority_treatment))
-    {
-        TreatmentType tempType = _priority_treatment->getType();
-        if (tempType == Ttype)
-            break;
-
-        Required_Treatments.dequeue(_priority_treatment);
-        temp.enqueue(_priority_treatment);
-    }
+    if (priority == 0 || priority == treatmentCount)
+        return;
 
-    while (!temp.isEmpty())
-    {
-        temp.dequeue(_priority_treatment);
-        Required_Treatments.enqueue(_priority_treatment);
-    }
+    //the treatments before it go to the back, in the same order
+    rotate(Required_Treatments, Required_Treatments + priority, Required_Treatments + treatmentCount);
 }
-
-//----------------------------------- DESTRUCTOR -----------------------------------//
-
-Patient::~Patient() {}
\ No newline at end of file
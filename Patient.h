@@ -18,14 +18,16 @@
  * @date March 2025
  */
 #pragma once
-#include "LinkedQueue.h"
 #include "Treatment.h"
 #include "E_Treatment.h"
 #include "U_Treatment.h"
 #include "X_Treatment.h"
+#include "SimulationArena.h"
 #include <iostream>
 using namespace std;
 
+class StatusIndex;
+
 /** @enum PatientType
  *  Represents the type of patient.
  */
@@ -40,7 +42,7 @@ enum PatientStatus { EARLY, LATE, WAIT, SERV, INTERRUPTED, FINISHED, IDLE = -1 }
  * @class Patient
  * @brief Represents a patient in the treatment scheduling system.
  */
-class Patient {
+class Patient : public ArenaObject {
 private:
 	/** @brief Unique patient ID. */
 	int PID;
@@ -54,8 +56,11 @@ private:
 	/** @brief Arrival time. */
 	int VT;
 
-	/** @brief Queue of required treatments. */
-	LinkedQueue<Treatment*> Required_Treatments;
+	/** @brief Required treatments, stored inline, the next one first. */
+	Treatment Required_Treatments[MAX_TREATMENTS];
+
+	/** @brief Number of required treatments left. */
+	int treatmentCount;
 
 	/** @brief Current status of the patient. */
 	PatientStatus status;
@@ -78,39 +83,12 @@ private:
 	/** @brief Time the patient finished all treatments. */
 	int finishTime;
 
-	/**
-	 * @brief Utility function to safely add a new treatment if not duplicated.
-	 * @tparam T Type of the treatment.
-	 * @param newTreatment Pointer to the new treatment.
-	 * @return True if treatment was added, false if it was a duplicate.
-	 */
-	template<typename T>
-	bool addTreatmentHelper(T* newTreatment)
-	{
-		LinkedQueue<Treatment*> tempQueue;
-		Treatment* current;
-		bool duplicateFound = false;
-
-		while (Required_Treatments.dequeue(current))
-		{
-			if (dynamic_cast<T*>(current))
-				duplicateFound = true;
-			tempQueue.enqueue(current);
-		}
-
-		while (tempQueue.dequeue(current))
-		{
-			Required_Treatments.enqueue(current);
-		}
-
-		if (!duplicateFound)
-		{
-			Required_Treatments.enqueue(newTreatment);
-			return true;
-		}
-		return false;
-	}
+	/** @brief Neighbours in the status class of the index below. */
+	Patient* statusPrev;
+	Patient* statusNext;
 
+	/** @brief Index following the status of the patient (StatusIndex.h), nullptr if none. */
+	StatusIndex* statusIndex;
 
 public:
 	/** @brief Default constructor. Initializes an empty patient. */
@@ -134,23 +112,22 @@ public:
 	Patient(int id, int pt, int vt, PatientType type);
 
 	/**
-	 * @brief Constructor with treatments queue.
-	 * @param id Patient ID.
-	 * @param type Patient type.
-	 * @param pt Appointment time.
-	 * @param vt Arrival time.
-	 * @param req_treat Predefined queue of required treatments.
+	 * @brief Makes the next generated ID larger than lastPID, so patients created after a
+	 * restore don't take the IDs of the restored ones.
 	 */
-	Patient(int id, int pt, int vt, PatientType type, LinkedQueue<Treatment*> req_treat);
+	static void ReserveIDs(int lastPID);
+
+	/** @brief Leaves the status index, if attached. */
+	~Patient();
 
 	/**
 	 * @brief Adds a treatment to the patient if not already present.
-	 * @param newTreatment Pointer to the new treatment.
-	 * @return True if added successfully, false if a duplicate.
+	 * @param newTreatment Treatment value, copied into the patient.
+	 * @return True if added successfully, false if a duplicate, not a lane or the patient has MAX_TREATMENTS already.
 	 */
-	bool addTreatment(Treatment* newTreatment);
+	bool addTreatment(const Treatment& newTreatment);
 
-	/** @brief Sets the current status of the patient. */
+	/** @brief Sets the current status of the patient, and moves them to its class in their status index. */
 	void setStatus(PatientStatus newStatus);
 
 	/** @brief Sets the finish time for the patient. */
@@ -175,7 +152,8 @@ public:
 	 * @brief Gets the next treatment in the queue.
 	 * @return Pointer to the next treatment, or nullptr if empty.
 	 */
-	Treatment* getNextTreatment() const;
+	Treatment* getNextTreatment() { return treatmentCount ? &Required_Treatments[0] : nullptr; }
+	const Treatment* getNextTreatment() const { return treatmentCount ? &Required_Treatments[0] : nullptr; }
 
 	/**
 	 * @brief Completes the current treatment.
@@ -198,8 +176,12 @@ public:
 	/** @brief Returns the patient's arrival time. */
 	int getArrivalTime() const;
 
-	/** @brief Returns a copy of the patient's remaining treatment queue. */
-	LinkedQueue<Treatment*> getRemainingTreatments() const;
+	/**
+	 * @brief Returns a remaining treatment.
+	 * @param index Position in the remaining treatments, 0 is the next one.
+	 * @return Pointer to the treatment, or nullptr past the last one.
+	 */
+	const Treatment* getRemainingTreatment(int index) const;
 
 	/** @brief Returns the number of remaining treatments. */
 	int getNumber_RemainingTreatment() const;
@@ -237,8 +219,9 @@ public:
 	 * @brief Marks the patient as rescheduled.
 	 * @param newPT New appointment time.
 	 * @param newVT New arrival time.
+	 * @return false if the patient is not early or the new times are earlier than the old ones.
 	 */
-	void markRescheduled(int newPT, int newVT);
+	bool markRescheduled(int newPT, int newVT);
 
 	/**
 	 * @brief Resort the treatments queue for a recovering patient.
@@ -246,9 +229,6 @@ public:
 	 */
 	void ResortTreatments(TreatmentType type);
 
-	/** @brief Destructor. Handles cleanup. */
-	~Patient();
-
 	/**
 	 * @brief Overloaded stream insertion operator to display patient details.
 	 * @param os Output stream.
@@ -256,4 +236,8 @@ public:
 	 * @return Reference to the output stream.
 	 */
 	friend ostream& operator<<(ostream& os, Patient& myPatient);
+
+	/** @brief Checkpoint saves and restores the complete patient state. */
+	friend class Checkpoint;
+	friend class StatusIndex;       ///< Links the patients of a status class through them
 };
@@ -0,0 +1,113 @@
+#include "PatientRegistry.h"
+#include "Patient.h"
+
+PatientRegistry::PatientRegistry() : basePID(0), used(0)
+{
+}
+
+PatientEntry& PatientRegistry::Slot(int PID)
+{
+	if (entries.empty())
+		basePID = PID;
+
+	//a PID below the first one (restored out of order), shift everything once
+	if (PID < basePID)
+	{
+		entries.insert(entries.begin(), basePID - PID, PatientEntry());
+		basePID = PID;
+	}
+
+	size_t index = (size_t)(PID - basePID);
+	if (index >= entries.size())
+		entries.resize(index + 1);
+	return entries[index];
+}
+
+void PatientRegistry::Move(Patient* myPatient, PatientPlace place, int lane, int nextEvent, int time)
+{
+	PatientEntry& entry = Slot(myPatient->getPID());
+
+	if (entry.place == PLACE_NONE)
+	{
+		used++;
+		if (myPatient->getType() == RECOVERING)
+			entry.flags |= PATIENT_RECOVERING;
+	}
+	else if (place == PLACE_ALL)
+	{
+		entry.reschedules++;
+	}
+
+	switch (place)
+	{
+	case PLACE_EARLY:
+	case PLACE_LATE:
+		if (entry.arrival < 0)
+			entry.arrival = time;
+		break;
+	case PLACE_INTERRUPTED:
+		entry.interruptions++;
+		break;
+	case PLACE_FINISHED:
+		entry.finishTime = time;
+		if (myPatient->isCancelled())
+			entry.flags |= PATIENT_CANCELLED;
+		break;
+	default:
+		break;
+	}
+
+	entry.patient = myPatient;
+	entry.status = (int8_t)myPatient->getStatus();
+	entry.place = place;
+	entry.lane = (int8_t)lane;
+	entry.nextEvent = nextEvent;
+	entry.since = time;
+	entry.transitions++;
+}
+
+void PatientRegistry::Release(int PID)
+{
+	size_t index = (size_t)(PID - basePID);
+	if (PID >= basePID && index < entries.size())
+		entries[index].patient = nullptr;
+}
+
+void PatientRegistry::Restore(int PID, const PatientEntry& entry)
+{
+	PatientEntry& slot = Slot(PID);
+	if (slot.place == PLACE_NONE && entry.place != PLACE_NONE)
+		used++;
+	slot = entry;
+}
+
+const PatientEntry* PatientRegistry::Find(int PID) const
+{
+	size_t index = (size_t)(PID - basePID);
+	if (PID < basePID || index >= entries.size() || entries[index].place == PLACE_NONE)
+		return nullptr;
+	return &entries[index];
+}
+
+Patient* PatientRegistry::getPatient(int PID) const
+{
+	const PatientEntry* entry = Find(PID);
+	return entry ? entry->patient : nullptr;
+}
+
+int PatientRegistry::getCount() const { return used; }
+
+const char* PatientRegistry::PlaceName(PatientPlace place)
+{
+	switch (place)
+	{
+	case PLACE_ALL:         return "ALL";
+	case PLACE_EARLY:       return "EARLY";
+	case PLACE_LATE:        return "LATE";
+	case PLACE_WAIT:        return "WAIT";
+	case PLACE_TREATMENT:   return "TREATMENT";
+	case PLACE_INTERRUPTED: return "INTERRUPTED";
+	case PLACE_FINISHED:    return "FINISHED";
+	default:                return "NONE";
+	}
+}
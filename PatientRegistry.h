@@ -0,0 +1,121 @@
+/**
+ * @file PatientRegistry.h
+ * @brief Declares the PatientRegistry class, where every patient of a simulation is by PID.
+ *
+ * The lists of the schedular hold the patients, but none of them can say where a given
+ * patient is: that took a scan of every list, and the history list only repeated the
+ * patients (twice for a rescheduled one) without their state. The registry keeps one
+ * entry per PID in a vector indexed by PID - first PID, so a lookup is one subtraction.
+ * The schedular updates the entry at each transition with the status, the list the patient
+ * is in and the time they are due to leave it, and a short summary of the transitions
+ * (counts and times) that stays once a finished patient is reclaimed.
+ *
+ * PIDs come from one counter for the whole program, so replications running side by side
+ * leave unused entries between the PIDs of a simulation; they are PLACE_NONE.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+class Patient;
+
+/** @enum PatientPlace
+ *  List of the schedular a patient is in.
+ */
+enum PatientPlace : int8_t
+{
+    PLACE_NONE,             ///< Unused entry
+    PLACE_ALL,              ///< Not arrived yet
+    PLACE_EARLY,
+    PLACE_LATE,
+    PLACE_WAIT,             ///< Waiting list of a lane
+    PLACE_TREATMENT,        ///< Treated on a resource of a lane
+    PLACE_INTERRUPTED,
+    PLACE_FINISHED          ///< Finished or cancelled
+};
+
+/**
+ * @struct PatientEntry
+ * @brief Where a patient is, and what happened to them so far.
+ */
+struct PatientEntry
+{
+    Patient* patient = nullptr;     ///< nullptr once the finished patient is reclaimed
+    int32_t nextEvent = -1;         ///< Time the patient is due to leave the list, -1 if they wait for a resource
+    int32_t since = -1;             ///< Time of the last transition
+    int32_t arrival = -1;           ///< Time the patient arrived (entered the early or late list), -1 before
+    int32_t finishTime = -1;        ///< Time the patient finished or cancelled, -1 before
+    uint16_t transitions = 0;       ///< Transitions so far
+    uint8_t interruptions = 0;      ///< Busy failures during their treatments
+    uint8_t reschedules = 0;        ///< Times sent back to the all list
+    int8_t status = -1;             ///< PatientStatus after the last transition
+    PatientPlace place = PLACE_NONE;
+    int8_t lane = -1;               ///< Lane of PLACE_WAIT and PLACE_TREATMENT, -1 otherwise
+    uint8_t flags = 0;              ///< PATIENT_RECOVERING, PATIENT_CANCELLED
+};
+
+#define PATIENT_RECOVERING 0x01
+#define PATIENT_CANCELLED 0x02
+
+/**
+ * @class PatientRegistry
+ * @brief Entries of the patients of one simulation, O(1) by PID.
+ */
+class PatientRegistry
+{
+private:
+    vector<PatientEntry> entries;       ///< Entry of PID basePID + i at i
+    int basePID;                        ///< Lowest PID registered
+    int used;                           ///< Entries that are not PLACE_NONE
+
+    /** @brief Entry of a PID, the vector grows (at the front if needed) to hold it. */
+    PatientEntry& Slot(int PID);
+
+public:
+    /** @brief Constructs an empty registry. */
+    PatientRegistry();
+
+    /**
+     * @brief Records a transition of a patient, registering them on their first one.
+     * A move to PLACE_ALL of a registered patient counts as a reschedule, a move to
+     * PLACE_INTERRUPTED as an interruption.
+     * @param myPatient Patient, their status already set.
+     * @param place List they entered.
+     * @param lane Lane of the list, -1 if it has none.
+     * @param nextEvent Time they are due to leave it, -1 if unknown.
+     * @param time Current time.
+     */
+    void Move(Patient* myPatient, PatientPlace place, int lane, int nextEvent, int time);
+
+    /** @brief Forgets the patient object of a PID (reclaimed), its entry stays. */
+    void Release(int PID);
+
+    /** @brief Puts back a saved entry (checkpoint restore). */
+    void Restore(int PID, const PatientEntry& entry);
+
+    /** @brief Entry of a PID, nullptr if the PID was never registered. */
+    const PatientEntry* Find(int PID) const;
+
+    /** @brief Patient of a PID, nullptr if unknown or reclaimed. */
+    Patient* getPatient(int PID) const;
+
+    int getCount() const;                   ///< Patients registered
+
+    /** @brief Display name of a place. */
+    static const char* PlaceName(PatientPlace place);
+
+    /** @brief Calls visit(PID, entry) for every registered patient by increasing PID. */
+    template <typename Visitor>
+    void Traverse(Visitor visit) const
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].place != PLACE_NONE)
+                visit(basePID + (int)i, entries[i]);
+        }
+    }
+};
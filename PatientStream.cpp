@@ -0,0 +1,217 @@
+#include "PatientStream.h"
+#include "Schedular.h"
+#include "Load.h"
+#include <iostream>
+
+PatientStream::PatientStream(string fileName, int lookAheadTime, int maxBuffered) :
+	_fileName(fileName),
+	lookAhead((lookAheadTime > 0) ? lookAheadTime : 0),
+	capacity((maxBuffered > 0) ? maxBuffered : 1),
+	numPatients(0),
+	head(0),
+	count(0),
+	horizon(0),
+	finished(true),
+	stopping(false)
+{
+	ring.resize(capacity);
+}
+
+PatientStream::~PatientStream()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		stopping = true;
+	}
+	changed.notify_all();
+
+	if (reader.joinable())
+		reader.join();
+}
+
+template <class Policy>
+bool PatientStream::Open(BasicSchedular<Policy>& hospitalSystem, bool loadResources)
+{
+	if (reader.joinable())
+	{
+		cout << "Error: Stream " << _fileName << ".txt is already open" << endl;
+		return false;
+	}
+
+	inFile.open(_fileName + ".txt", ios::in);
+	if (!inFile.is_open())
+	{
+		cout << "Error: Unable to open file " << _fileName << ".txt" << endl;
+		return false;
+	}
+
+	// resources, probabilities and patient count are read right away, the patients are streamed
+	if (!Load::ReadSettings(inFile, hospitalSystem, loadResources, numPatients))
+		return false;
+
+	//the reader maps treatment letters to lanes without touching the Schedular
+	laneCodes.clear();
+	for (int i = 0; i < hospitalSystem.getLaneCount(); i++)
+		laneCodes += hospitalSystem.getLaneCode((TreatmentType)i);
+
+	head = 0;
+	count = 0;
+	horizon = hospitalSystem.getCurrentTime() + lookAhead;
+	finished = false;
+	stopping = false;
+
+	hospitalSystem.setPatientStream(this);
+	reader = thread(&PatientStream::ReadPatients, this);
+	return true;
+}
+
+void PatientStream::ReadPatients()
+{
+	int previousVT = 0;
+
+	for (int i = 0; i < numPatients; i++)
+	{
+		StreamedPatient entry;
+		int numTreatments = 0;
+
+		if (!(inFile >> entry.type >> entry.PT >> entry.VT >> numTreatments))
+		{
+			cout << "Error: Failed to read patient data at entry " << i + 1 << endl;
+			break;
+		}
+
+		if (entry.VT < previousVT)
+			cout << "Error: Streamed input is not sorted by arrival time at entry " << i + 1 << endl;
+		previousVT = entry.VT;
+
+		//the same rules as Load: the first treatment of each type, at most STREAM_MAX_TREATMENTS and at least one
+		entry.treatmentCount = 0;
+		bool valid = true;
+		for (int j = 0; j < numTreatments; j++)
+		{
+			char treatmentType;
+			int duration;
+			if (!(inFile >> treatmentType >> duration))
+			{
+				cout << "Error: Failed to read treatment data at entry " << i + 1 << endl;
+				valid = false;
+				break;
+			}
+
+			size_t lane = laneCodes.find(treatmentType);
+			if (lane == string::npos)
+				continue;
+
+			bool duplicate = false;
+			for (int k = 0; k < entry.treatmentCount; k++)
+				duplicate = duplicate || (entry.treatments[k] == (TreatmentType)lane);
+
+			if (duplicate)
+				continue;
+
+			if (entry.treatmentCount == STREAM_MAX_TREATMENTS)
+			{
+				cout << "Error: Patient at entry " << i + 1 << " requires more than " << STREAM_MAX_TREATMENTS << " treatments" << endl;
+				valid = false;
+				break;
+			}
+
+			entry.treatments[entry.treatmentCount] = (TreatmentType)lane;
+			entry.durations[entry.treatmentCount] = duration;
+			entry.treatmentCount++;
+		}
+
+		if (valid && entry.treatmentCount == 0)
+		{
+			cout << "Error: Patient at entry " << i + 1 << " has no treatment of a known type" << endl;
+			valid = false;
+		}
+
+		if (!valid)
+			break;
+
+		//wait while the ring is full or already reaches past the window
+		unique_lock<mutex> guard(lock);
+		changed.wait(guard, [this]()
+		{
+			if (stopping)
+				return true;
+			if (count == capacity)
+				return false;
+			return count == 0 || ring[(head + count - 1) % capacity].VT <= horizon;
+		});
+
+		if (stopping)
+			break;
+
+		ring[(head + count) % capacity] = entry;
+		count++;
+		guard.unlock();
+		changed.notify_all();
+	}
+
+	{
+		lock_guard<mutex> guard(lock);
+		finished = true;
+	}
+	changed.notify_all();
+	inFile.close();
+}
+
+template <class Policy>
+void PatientStream::Feed(BasicSchedular<Policy>& hospitalSystem)
+{
+	int now = hospitalSystem.getCurrentTime();
+	ready.clear();
+
+	{
+		unique_lock<mutex> guard(lock);
+		horizon = now + lookAhead;
+
+		while (true)
+		{
+			while (count > 0 && ring[head].VT <= now)
+			{
+				ready.push_back(ring[head]);
+				head = (head + 1) % capacity;
+				count--;
+			}
+
+			//the next buffered patient arrives later, or there is nothing left to read
+			if (count > 0 || finished)
+				break;
+
+			//the reader has not reached the current time yet
+			changed.notify_all();
+			changed.wait(guard);
+		}
+	}
+	changed.notify_all();
+
+	//patients are only created once they arrive
+	for (const StreamedPatient& entry : ready)
+		AddPatient(hospitalSystem, entry);
+}
+
+bool PatientStream::Exhausted() const
+{
+	lock_guard<mutex> guard(lock);
+	return finished && count == 0;
+}
+
+template <class Policy>
+void PatientStream::AddPatient(BasicSchedular<Policy>& hospitalSystem, const StreamedPatient& entry)
+{
+	PatientType patientType = (entry.type == 'N') ? NORMAL : RECOVERING;
+	Patient* patient = new (hospitalSystem.getArena()) Patient(entry.PT, entry.VT, patientType);
+
+	for (int i = 0; i < entry.treatmentCount; i++)
+		patient->addTreatment(Treatment(entry.durations[i], entry.treatments[i]));
+
+	hospitalSystem.AddToAllList(patient);
+}
+
+#define INSTANTIATE_PATIENT_STREAM(Policy) \
+	template bool PatientStream::Open(BasicSchedular<Policy>&, bool); \
+	template void PatientStream::Feed(BasicSchedular<Policy>&);
+SCHEDULAR_POLICIES(INSTANTIATE_PATIENT_STREAM)
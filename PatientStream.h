@@ -0,0 +1,115 @@
+/**
+ * @file PatientStream.h
+ * @brief Streams the patients of an input file into a running simulation.
+ *
+ * Load::LoadDataFromFile creates every patient before time step 0, so the all list holds the
+ * whole input for the entire run. A PatientStream instead reads the patient entries of an
+ * input file sorted by arrival time in a background thread, and only keeps a bounded window
+ * of parsed entries ahead of the current time. Schedular::CheckAllPatientList asks the stream
+ * for the patients arriving by the current time step, which are created only then.
+ *
+ * Rescheduled patients are moved after the last arrival the simulation has seen so far. Feed
+ * only adds the patients arriving by the current time step, so with streamed input that is
+ * about the current time step, while a batch run of the same file reschedules after the last
+ * arrival of the whole file. A streamed run and a batch run of one file therefore give
+ * different results once a patient is rescheduled. The patients parsed ahead in the window
+ * are not used for it, how far the reader got depends on the thread timing and would make a
+ * run depend on it too.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Treatment.h"
+using namespace std;
+
+#include "SchedularFwd.h"
+
+#define STREAM_MAX_TREATMENTS MAX_TREATMENTS   // a patient keeps at most MAX_TREATMENTS treatments, one of each type
+
+/**
+ * @struct StreamedPatient
+ * @brief One parsed patient entry waiting for its arrival time.
+ */
+struct StreamedPatient
+{
+    char type;                                  ///< 'N' or 'R'
+    int PT;                                     ///< Appointment time
+    int VT;                                     ///< Arrival time
+    int treatmentCount;                         ///< Number of distinct treatments kept
+    TreatmentType treatments[STREAM_MAX_TREATMENTS]; ///< Lanes of the treatments in file order
+    int durations[STREAM_MAX_TREATMENTS];       ///< Duration of each treatment
+};
+
+/**
+ * @class PatientStream
+ * @brief Background reader feeding the all list of a Schedular as simulation time advances.
+ */
+class PatientStream
+{
+private:
+    string _fileName;                   ///< Name of the input file (without extension)
+    int lookAhead;                      ///< Time steps the reader may parse ahead of the current time
+    int capacity;                       ///< Maximum number of parsed entries held at once
+
+    ifstream inFile;                    ///< Input file, owned by the reader thread after Open
+    thread reader;                      ///< Background reader thread
+    int numPatients;                    ///< Number of patient entries announced by the file
+    string laneCodes;                   ///< Treatment letter of each lane of the Schedular, by lane (fixed after Open)
+
+    mutable mutex lock;                 ///< Guards everything below
+    condition_variable changed;         ///< Signalled whenever the buffer or the horizon changes
+    vector<StreamedPatient> ring;       ///< Parsed entries in file order (circular buffer)
+    int head;                           ///< Index of the oldest entry
+    int count;                          ///< Number of entries in the ring
+    int horizon;                        ///< Latest time step the reader should parse up to
+    bool finished;                      ///< True once the reader is done with the file
+    bool stopping;                      ///< True when the owner wants the reader to quit early
+
+    vector<StreamedPatient> ready;      ///< Entries handed to the Schedular in the current Feed
+
+    /** @brief Body of the reader thread: parses entries into the ring until the file ends. */
+    void ReadPatients();
+
+    /** @brief Creates a Patient from a parsed entry and adds it to the all list. */
+    template <class Policy>
+    static void AddPatient(BasicSchedular<Policy>& hospitalSystem, const StreamedPatient& entry);
+
+public:
+    /**
+     * @brief Constructs a stream over one input file.
+     * @param fileName Name of the file (excluding the .txt extension), sorted by arrival time.
+     * @param lookAheadTime Time steps the reader may run ahead of the simulation.
+     * @param maxBuffered Maximum number of parsed entries held at once.
+     */
+    PatientStream(string fileName, int lookAheadTime = 50, int maxBuffered = 4096);
+
+    /** @brief Stops the reader thread. */
+    ~PatientStream();
+
+    /**
+     * @brief Reads the resources and probabilities, attaches the stream and starts the reader.
+     * @param hospitalSystem The Schedular fed by this stream (of any policy).
+     * @param loadResources If false, the resources of the file are read but not added.
+     * @return false if the file could not be opened or its settings are malformed.
+     */
+    template <class Policy>
+    bool Open(BasicSchedular<Policy>& hospitalSystem, bool loadResources = true);
+
+    /**
+     * @brief Adds every patient arriving by the current time of the Schedular to its all list.
+     *
+     * Waits for the reader only when it has not parsed that far yet.
+     */
+    template <class Policy>
+    void Feed(BasicSchedular<Policy>& hospitalSystem);
+
+    /** @brief Returns true once every patient of the file has been handed to the Schedular. */
+    bool Exhausted() const;
+};
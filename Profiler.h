@@ -0,0 +1,260 @@
+/**
+ * @file Profiler.h
+ * @brief Scoped timers around the simulation phases and the expensive list helpers.
+ *
+ * A PhaseProfiler<true>::Scope placed at the top of a function times the function with
+ * steady_clock and adds the time to the histogram of its ProfilePoint. Times are inclusive
+ * (a phase contains the helpers it calls). Histograms have one bucket per power of two
+ * nanoseconds and live per thread, so simulations running in parallel (CapacityOptimizer)
+ * never share a counter; the summary merges the threads.
+ *
+ * The policy is picked at compile time through PHASE_PROFILING. Profiler is PhaseProfiler<false>
+ * unless PHASE_PROFILING is 1, and all of its members are empty inline functions, so
+ * release builds contain no clock reads and no counters at all.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+using namespace std;
+
+#ifndef PHASE_PROFILING
+#define PHASE_PROFILING 0
+#endif
+
+#define PROFILE_BUCKETS 48      // bucket i holds times below 2^i ns
+
+/** @enum ProfilePoint
+ *  Timed functions.
+ */
+enum ProfilePoint
+{
+    PROFILE_CHECK_MAINTAINANCE,
+    PROFILE_MOVE_TO_NEXT_TREATMENT,
+    PROFILE_CHECK_ALL_PATIENTS,
+    PROFILE_CHECK_INTERRUPTED,
+    PROFILE_EARLY_TO_WAIT,
+    PROFILE_LATE_TO_WAIT,
+    PROFILE_WAIT_TO_TREATMENT,
+    PROFILE_CALC_TREATMENT_LATENCY,
+    PROFILE_INSERT_SORTED,
+    PROFILE_RANDOM_CANCEL,
+    PROFILE_RANDOM_BUSY_FAILURE,
+    PROFILE_RANDOM_RESCHEDULE,
+    PROFILE_POINTS
+};
+
+/**
+ * @struct ProfileHistogram
+ * @brief Calls and times of one ProfilePoint.
+ */
+struct ProfileHistogram
+{
+    long long calls;                            ///< Number of timed calls
+    long long totalNs;                          ///< Sum of the call times
+    long long maxNs;                            ///< Slowest call
+    long long buckets[PROFILE_BUCKETS];         ///< Calls per power of two nanoseconds
+
+    /** @brief Adds one call. */
+    void Add(long long ns)
+    {
+        int bucket = 0;
+        while (bucket < PROFILE_BUCKETS - 1 && (1LL << bucket) <= ns)
+            bucket++;
+
+        calls++;
+        totalNs += ns;
+        if (ns > maxNs)
+            maxNs = ns;
+        buckets[bucket]++;
+    }
+
+    /** @brief Adds the calls of another histogram. */
+    void Merge(const ProfileHistogram& other)
+    {
+        calls += other.calls;
+        totalNs += other.totalNs;
+        if (other.maxNs > maxNs)
+            maxNs = other.maxNs;
+        for (int i = 0; i < PROFILE_BUCKETS; i++)
+            buckets[i] += other.buckets[i];
+    }
+
+    /** @brief Upper bound (ns) of the bucket holding the given quantile. */
+    long long Quantile(double q) const
+    {
+        long long rank = (long long)(q * calls), seen = 0;
+        for (int i = 0; i < PROFILE_BUCKETS; i++)
+        {
+            seen += buckets[i];
+            if (seen > rank)
+                return 1LL << i;
+        }
+        return maxNs;
+    }
+};
+
+/**
+ * @class PhaseProfiler
+ * @brief Compile-time profiling policy, PhaseProfiler<false> does nothing.
+ */
+template <bool Enabled>
+class PhaseProfiler
+{
+public:
+    /** @brief Times its own lifetime. */
+    class Scope
+    {
+    public:
+        explicit Scope(ProfilePoint) {}
+    };
+
+    static void Reset() {}
+    static void PrintSummary(ostream&) {}
+    static bool ExportCsv(const string&) { return true; }
+};
+
+template <>
+class PhaseProfiler<true>
+{
+private:
+    /** @brief Histograms of one thread, registered once so the summary can find them. */
+    struct ThreadTable
+    {
+        ProfileHistogram points[PROFILE_POINTS] = {};
+
+        ThreadTable()
+        {
+            lock_guard<mutex> lock(registry());
+            tables().push_back(this);
+        }
+
+        ~ThreadTable()
+        {
+            //keep what the thread measured after it ends
+            lock_guard<mutex> lock(registry());
+            for (int i = 0; i < PROFILE_POINTS; i++)
+                retired()[i].Merge(points[i]);
+            for (size_t i = 0; i < tables().size(); i++)
+            {
+                if (tables()[i] == this)
+                {
+                    tables().erase(tables().begin() + i);
+                    break;
+                }
+            }
+        }
+    };
+
+    static mutex& registry() { static mutex m; return m; }
+    static vector<ThreadTable*>& tables() { static vector<ThreadTable*> t; return t; }
+    static ProfileHistogram* retired() { static ProfileHistogram r[PROFILE_POINTS] = {}; return r; }
+    static ThreadTable& local() { static thread_local ThreadTable t; return t; }
+
+    /** @brief Histograms of every thread added together. */
+    static void Collect(ProfileHistogram merged[PROFILE_POINTS])
+    {
+        lock_guard<mutex> lock(registry());
+        for (int i = 0; i < PROFILE_POINTS; i++)
+        {
+            merged[i] = retired()[i];
+            for (ThreadTable* table : tables())
+                merged[i].Merge(table->points[i]);
+        }
+    }
+
+public:
+    static const char* Name(ProfilePoint point)
+    {
+        static const char* names[PROFILE_POINTS] =
+        {
+            "CheckMaintainanceList", "MoveToNextTreatment", "CheckAllPatientList", "CheckInterrupted",
+            "EarlyToWait", "LateToWait", "WaitToTreatment", "CalcTreatmentLatency",
+            "insertSorted", "RandomCancel", "RandomBusyFailure", "RandomReschedule"
+        };
+        return names[point];
+    }
+
+    class Scope
+    {
+    private:
+        ProfilePoint point;
+        chrono::steady_clock::time_point start;
+
+    public:
+        explicit Scope(ProfilePoint timedPoint) : point(timedPoint), start(chrono::steady_clock::now()) {}
+
+        ~Scope()
+        {
+            long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            local().points[point].Add(ns);
+        }
+    };
+
+    /** @brief Clears the histograms of every thread. */
+    static void Reset()
+    {
+        lock_guard<mutex> lock(registry());
+        for (int i = 0; i < PROFILE_POINTS; i++)
+        {
+            retired()[i] = ProfileHistogram();
+            for (ThreadTable* table : tables())
+                table->points[i] = ProfileHistogram();
+        }
+    }
+
+    /** @brief Prints calls, total, mean, p50, p99 and max of every point that was called. */
+    static void PrintSummary(ostream& os)
+    {
+        ProfileHistogram merged[PROFILE_POINTS];
+        Collect(merged);
+
+        os << "\n=========== Phase Profile ===========\n" << left
+            << setw(24) << "Point" << setw(12) << "Calls" << setw(14) << "Total (ms)" << setw(12) << "Mean (ns)"
+            << setw(12) << "p50 (ns)" << setw(12) << "p99 (ns)" << "Max (ns)\n";
+        for (int i = 0; i < PROFILE_POINTS; i++)
+        {
+            const ProfileHistogram& h = merged[i];
+            if (!h.calls)
+                continue;
+            os << setw(24) << Name((ProfilePoint)i) << setw(12) << h.calls << setw(14) << h.totalNs / 1e6
+                << setw(12) << h.totalNs / h.calls << setw(12) << h.Quantile(0.5)
+                << setw(12) << h.Quantile(0.99) << h.maxNs << "\n";
+        }
+        os << "(p50 and p99 are power of two bucket bounds)\n";
+    }
+
+    /** @brief Writes one CSV line per point and bucket: point,calls,total_ns,max_ns,bucket_upper_ns,bucket_calls. */
+    static bool ExportCsv(const string& fileName)
+    {
+        ofstream outFile(fileName);
+        if (!outFile.is_open())
+            return false;
+
+        ProfileHistogram merged[PROFILE_POINTS];
+        Collect(merged);
+
+        outFile << "point,calls,total_ns,max_ns,bucket_upper_ns,bucket_calls\n";
+        for (int i = 0; i < PROFILE_POINTS; i++)
+        {
+            const ProfileHistogram& h = merged[i];
+            for (int b = 0; b < PROFILE_BUCKETS; b++)
+            {
+                if (h.buckets[b])
+                    outFile << Name((ProfilePoint)i) << ',' << h.calls << ',' << h.totalNs << ',' << h.maxNs
+                        << ',' << (1LL << b) << ',' << h.buckets[b] << '\n';
+            }
+        }
+        return (bool)outFile;
+    }
+};
+
+/** @brief The policy of this build. */
+typedef PhaseProfiler<PHASE_PROFILING != 0> Profiler;
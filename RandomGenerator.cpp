@@ -0,0 +1,62 @@
+#include "RandomGenerator.h"
+
+RandomGenerator::RandomGenerator(unsigned long long seed)
+{
+	setSeed(seed);
+}
+
+void RandomGenerator::setSeed(unsigned long long seed)
+{
+	//splitmix64 spreads even small consecutive seeds over the whole state
+	for (int i = 0; i < 2; i++)
+	{
+		seed += 0x9E3779B97F4A7C15ULL;
+		unsigned long long z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		state[i] = z ^ (z >> 31);
+	}
+
+	if (state[0] == 0 && state[1] == 0)
+		state[0] = 1;
+}
+
+unsigned long long RandomGenerator::NextBits()
+{
+	unsigned long long s1 = state[0];
+	const unsigned long long s0 = state[1];
+	state[0] = s0;
+	s1 ^= s1 << 23;
+	state[1] = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+	return state[1] + s0;
+}
+
+int RandomGenerator::Next(int range)
+{
+	if (range <= 0)
+		return 0;
+
+	//scale the upper 32 bits into [0, range) instead of using the biased modulo
+	unsigned long long high = NextBits() >> 32;
+	return (int)((high * (unsigned long long)range) >> 32);
+}
+
+double RandomGenerator::NextDouble()
+{
+	return (double)(NextBits() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void RandomGenerator::getState(unsigned long long out[2]) const
+{
+	out[0] = state[0];
+	out[1] = state[1];
+}
+
+void RandomGenerator::setState(const unsigned long long in[2])
+{
+	state[0] = in[0];
+	state[1] = in[1];
+
+	if (state[0] == 0 && state[1] == 0)
+		state[0] = 1;
+}
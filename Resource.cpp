@@ -2,7 +2,7 @@
 
 // Constructor implementation
 // Constructor implementation
-Resource::Resource(ResType t) : id(0), status(FREE)
+Resource::Resource(ResType t, TreatmentType l) : id(0), handle(NO_RESOURCE_HANDLE), slot(-1), status(FREE), lane(l), usage(), usageSince(0), occupants(0), underMaintenance(false)
 {
     type = t;
 }
@@ -35,5 +35,69 @@ bool Resource::isAvailable() const
     return status;
 }
 
+void Resource::AddElapsed(ResourceUsage& counters, int time) const
+{
+    long long elapsed = (time > usageSince) ? time - usageSince : 0;
+
+    if (underMaintenance)
+        counters.maintenanceTicks += elapsed;
+    else if (occupants > 0)
+        counters.busyTicks += elapsed;
+    else
+        counters.idleTicks += elapsed;
+
+    counters.occupancyTicks += elapsed * occupants;
+}
+
+void Resource::Account(int time)
+{
+    AddElapsed(usage, time);
+    usageSince = time;
+}
+
+void Resource::TrackAssign(int time)
+{
+    Account(time);
+    occupants++;
+    usage.sessions++;
+}
+
+void Resource::TrackRelease(int time)
+{
+    Account(time);
+    if (occupants > 0)
+        occupants--;
+}
+
+void Resource::TrackFailure(int time, bool busy)
+{
+    Account(time);
+    underMaintenance = true;
+
+    //a busy failure interrupts the patient, the device no longer treats them
+    if (busy)
+    {
+        usage.busyFailures++;
+        occupants = 0;
+    }
+    else
+    {
+        usage.freeFailures++;
+    }
+}
+
+void Resource::TrackRepair(int time)
+{
+    Account(time);
+    underMaintenance = false;
+}
+
+ResourceUsage Resource::getUsage(int time) const
+{
+    ResourceUsage current = usage;
+    AddElapsed(current, time);
+    return current;
+}
+
 // Virtual destructor implementation
 Resource::~Resource() { }
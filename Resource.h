@@ -12,10 +12,11 @@
 
 #define FREE true
 #define FULL false
-#define MAINTAINANCE_DURATION 6
-#define MAINTAINANCE_COOLDOWN 3
 
+#include <cstdint>
 #include <iostream>
+#include "SimulationArena.h"
+#include "Treatment.h"
 using namespace std;
 
 /**
@@ -26,23 +27,58 @@ enum ResType
 {
     _Edevice,       ///< Electrotherapy device
     _Udevice,       ///< Ultrasound therapy device
-    _Xdevice,       ///< Exercise/Gym room
+    _Xdevice,       ///< Exercise/Gym room (of any room lane)
+    _Ldevice,       ///< Device of a lane declared in the input file
     _dummydevice = -1  ///< Default/invalid type
 };
 
-class Resource
+/** @brief Index of a resource in the pool of its schedular (ResourcePool.h). */
+typedef uint32_t ResourceHandle;
+#define NO_RESOURCE_HANDLE ((ResourceHandle)-1)
+
+/**
+ * @struct ResourceUsage
+ * @brief Time a resource spent in each state and the events that moved it there.
+ */
+struct ResourceUsage
+{
+    long long busyTicks;            ///< Time steps with at least one patient
+    long long idleTicks;            ///< Time steps free and working
+    long long maintenanceTicks;     ///< Time steps under maintenance
+    long long occupancyTicks;       ///< Sum of patients over time steps (equals busyTicks for a device)
+    int sessions;                   ///< Treatments started on the resource
+    int busyFailures;               ///< Failures while treating a patient
+    int freeFailures;               ///< Failures while free
+};
+
+class Resource : public ArenaObject
 {
 protected:
-    int id;             ///< Unique resource ID
+    int id;             ///< Unique resource ID, given by the pool
+    ResourceHandle handle; ///< Index in the pool, NO_RESOURCE_HANDLE if created outside one
+    int slot;           ///< Index in the availability set of its lane, -1 before it joins
     bool status;        ///< Resource status (FREE or FULL)
     ResType type;       ///< Resource type
+    TreatmentType lane; ///< Lane of the schedular the resource serves
+
+    ResourceUsage usage;        ///< Counters up to usageSince
+    int usageSince;             ///< Time of the last usage event
+    int occupants;              ///< Patients using the resource since the last event
+    bool underMaintenance;      ///< Failed and not repaired yet
+
+    /** @brief Adds the time from the last event to the given time to the counter of the current state. */
+    void AddElapsed(ResourceUsage& counters, int time) const;
+
+    /** @brief Closes the current state at the given time. */
+    void Account(int time);
 
 public:
     /**
      * @brief Constructor to initialize a resource with a given type.
      * @param t Type of the resource (default is _dummydevice).
+     * @param l Lane the resource serves.
      */
-    Resource(ResType t = _dummydevice);
+    Resource(ResType t = _dummydevice, TreatmentType l = DUMMY_THERAPY);
 
     /**
      * @brief Assigns a patient to the resource (makes it busy).
@@ -60,18 +96,41 @@ public:
      */
     virtual int getID() const;
 
+    /** @brief Index of the resource in the pool of its schedular. */
+    ResourceHandle getHandle() const { return handle; }
+
     /**
      * @brief Gets the type of the resource.
      * @return ResType enum representing the resource type.
      */
     virtual ResType getType() const;
 
+    /**
+     * @brief Gets the lane the resource serves (E_THERAPY for an E device and so on).
+     * @return Lane index in the schedular.
+     */
+    TreatmentType getLane() const { return lane; }
+
     /**
      * @brief Checks if the resource is currently available.
      * @return True if free, false if in use.
      */
     virtual bool isAvailable() const;
 
+    // ===================== Usage Accounting =====================
+    // called by the schedular with the current time step, next to the matching state change
+
+    void TrackAssign(int time);                 ///< A treatment started on the resource
+    void TrackRelease(int time);                ///< A treatment finished on the resource
+    void TrackFailure(int time, bool busy);     ///< The resource failed (busy: while treating a patient)
+    void TrackRepair(int time);                 ///< The resource left maintenance
+
+    /**
+     * @brief Usage counters with the current state counted up to the given time.
+     * @param time Current time step (at least the time of the last event).
+     */
+    ResourceUsage getUsage(int time) const;
+
     /**
      * @brief Virtual destructor for proper cleanup.
      */
@@ -90,4 +149,10 @@ public:
      * @return Output stream with resource info.
      */
     friend ostream& operator<<(ostream& os, const Resource& r);
+
+    /** @brief Checkpoint saves and restores the complete resource state. */
+    friend class Checkpoint;
+    friend class ResourcePool;  ///< Gives the handle and id
+    friend class AvailabilitySet; ///< Gives the slot, orders by sessions
+    friend class RoomIndex;     ///< Reads the slot
 };
@@ -0,0 +1,44 @@
+#include "ResourcePool.h"
+
+ResourcePool::ResourcePool() :
+	storage{ SimulationArena(RESOURCE_POOL_CHUNK), SimulationArena(RESOURCE_POOL_CHUNK),
+		SimulationArena(RESOURCE_POOL_CHUNK), SimulationArena(RESOURCE_POOL_CHUNK) },
+	idSpan(RESOURCE_ID_SPAN)
+{
+	for (int& count : counts)
+		count = 0;
+}
+
+void ResourcePool::Register(Resource* resource)
+{
+	ResType type = resource->type;
+	resource->handle = (ResourceHandle)resources.size();
+	resources.push_back(resource);
+
+	//the last id of the span would run into the next type
+	if (++counts[type] == idSpan)
+		Renumber();
+	else
+		resource->id = (type + 2) * idSpan + counts[type];
+}
+
+void ResourcePool::Renumber()
+{
+	idSpan *= 10;
+
+	int numbered[RESOURCE_TYPES] = {};
+	for (Resource* resource : resources)
+	{
+		ResType type = resource->type;
+		resource->id = (type + 2) * idSpan + ++numbered[type];
+	}
+}
+
+Resource* ResourcePool::get(ResourceHandle handle) const
+{
+	return (handle < resources.size()) ? resources[handle] : nullptr;
+}
+
+int ResourcePool::getCount() const { return (int)resources.size(); }
+
+int ResourcePool::getCount(ResType type) const { return counts[type]; }
@@ -0,0 +1,95 @@
+/**
+ * @file ResourcePool.h
+ * @brief Declares the ResourcePool class, where the resources of one simulation are created.
+ *
+ * Every resource of a schedular is created by its pool. Each resource type has its own
+ * arena, so the devices of a type sit next to each other in memory whatever order the
+ * input declares them in, and the pool lists them all by handle: a dense 32-bit index
+ * given in creation order, valid for the life of the schedular. Walking every resource
+ * is a walk over one array instead of a visit of every lane list and treatment.
+ *
+ * The pool also numbers the resources. Ids used to come from counters shared by the whole
+ * program (E from 201, U from 301, X from 401), which kept counting over every simulation
+ * of a run and ran into the next type past 99 units. The pool keeps the same numbering per
+ * simulation, (type + 2) * span + n, and makes the span ten times wider (renumbering the
+ * resources made so far) as soon as a type reaches it, so ids stay unique with thousands
+ * of units.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <utility>
+#include <vector>
+#include "SimulationArena.h"
+#include "Resource.h"
+#include "Device.h"
+#include "Edevice.h"
+#include "Udevice.h"
+#include "GymRoom.h"
+using namespace std;
+
+#define RESOURCE_TYPES (_Ldevice + 1)
+#define RESOURCE_POOL_CHUNK (16 << 10)  // bytes per chunk of a type, a few hundred units
+#define RESOURCE_ID_SPAN 100            // ids per type while no type has more units
+
+/** @brief Type a resource class is stored as (its arena in the pool). */
+template <class T> struct PooledType;
+template <> struct PooledType<Edevice> { static const ResType type = _Edevice; };
+template <> struct PooledType<Udevice> { static const ResType type = _Udevice; };
+template <> struct PooledType<GymRoom> { static const ResType type = _Xdevice; };
+template <> struct PooledType<Device> { static const ResType type = _Ldevice; };
+
+/**
+ * @class ResourcePool
+ * @brief Typed storage, handles and ids of the resources of one simulation.
+ */
+class ResourcePool
+{
+private:
+    SimulationArena storage[RESOURCE_TYPES];    ///< One arena per resource type
+    vector<Resource*> resources;                ///< Every resource, by handle
+    int counts[RESOURCE_TYPES];                 ///< Units of each type
+    int idSpan;                                 ///< Ids available to each type
+
+    /** @brief Gives a new resource its handle and id. */
+    void Register(Resource* resource);
+
+    /** @brief Numbers every resource again on a span ten times wider. */
+    void Renumber();
+
+public:
+    /** @brief Constructs an empty pool. */
+    ResourcePool();
+
+    ResourcePool(const ResourcePool&) = delete;
+    ResourcePool& operator=(const ResourcePool&) = delete;
+
+    /**
+     * @brief Creates a resource in the storage of its type.
+     * @tparam T Edevice, Udevice, GymRoom or Device.
+     * @param args Constructor arguments.
+     * @return The resource, with its handle and id set. It lives as long as the pool.
+     */
+    template <class T, class... Args>
+    T* Create(Args&&... args)
+    {
+        T* resource = new (storage[PooledType<T>::type]) T(std::forward<Args>(args)...);
+        Register(resource);
+        return resource;
+    }
+
+    /** @brief Resource of a handle, nullptr if none. */
+    Resource* get(ResourceHandle handle) const;
+
+    int getCount() const;                       ///< Resources created
+    int getCount(ResType type) const;           ///< Resources of a type
+
+    /** @brief Calls visit(resource) for every resource by handle. */
+    template <typename Visitor>
+    void Traverse(Visitor visit) const
+    {
+        for (Resource* resource : resources)
+            visit(resource);
+    }
+};
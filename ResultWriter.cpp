@@ -0,0 +1,208 @@
+#include "ResultWriter.h"
+#include "Schedular.h"
+#include "Patient.h"
+
+ResultWriter::ResultWriter() : format(TEXT_OUTPUT), flushEvery(0), rowsSinceFlush(0) {}
+
+ResultWriter::~ResultWriter()
+{
+	Close();
+}
+
+OutputFormat ResultWriter::FormatFromName(const string& name)
+{
+	if (name == "csv")
+		return CSV_OUTPUT;
+	if (name == "columnar")
+		return COLUMNAR_OUTPUT;
+	return TEXT_OUTPUT;
+}
+
+const char* ResultWriter::ExtensionOf(OutputFormat outputFormat)
+{
+	switch (outputFormat)
+	{
+	case CSV_OUTPUT:
+		return ".csv";
+	case COLUMNAR_OUTPUT:
+		return ".col";
+	default:
+		return ".txt";
+	}
+}
+
+bool ResultWriter::Open(const string& fileName, OutputFormat outputFormat)
+{
+	format = outputFormat;
+	rowsSinceFlush = 0;
+	for (vector<int32_t>& column : columns)
+		column.clear();
+
+	if (!writer.Open(fileName, format == COLUMNAR_OUTPUT))
+		return false;
+
+	switch (format)
+	{
+	case TEXT_OUTPUT:
+		// Header with consistent column widths
+		writer.PutLeft("PID", 6);
+		writer.PutLeft("PType", 8);
+		writer.PutLeft("PT", 6);
+		writer.PutLeft("VT", 6);
+		writer.PutLeft("FT", 6);
+		writer.PutLeft("WT", 6);
+		writer.PutLeft("TT", 6);
+		writer.PutLeft("Cancel", 9);
+		writer.PutLeft("Resc", 6);
+		writer.Put('\n');
+		break;
+
+	case CSV_OUTPUT:
+		writer.Put("PID,PType,PT,VT,FT,WT,TT,Cancel,Resc\n");
+		break;
+
+	case COLUMNAR_OUTPUT:
+	{
+		ColumnarHeader header = { { 'P', 'C', 'R', 'C' }, 1, RESULT_COLUMNS, 0 };
+		writer.Write(&header, sizeof(header));
+		for (vector<int32_t>& column : columns)
+			column.reserve(RESULT_ROW_GROUP);
+		break;
+	}
+	}
+	return true;
+}
+
+void ResultWriter::WriteRow(const Patient* p)
+{
+	switch (format)
+	{
+	case TEXT_OUTPUT:
+		writer.PutLeft(p->getPID(), 6);
+		writer.PutLeft(p->getType() == NORMAL ? "N" : "R", 8);
+		writer.PutLeft(p->getAppointmentTime(), 6);
+		writer.PutLeft(p->getArrivalTime(), 6);
+		writer.PutLeft(p->getFinishTime(), 6);
+		writer.PutLeft(p->getTotalWaitingTime(), 6);
+		writer.PutLeft(p->getTotalTreatmentTime(), 6);
+		writer.PutLeft(p->isCancelled() ? "T" : "F", 9);
+		writer.PutLeft(p->isRescheduled() ? "T" : "F", 6);
+		writer.Put('\n');
+		break;
+
+	case CSV_OUTPUT:
+		writer.Put(p->getPID());
+		writer.Put(p->getType() == NORMAL ? ",N," : ",R,");
+		writer.Put(p->getAppointmentTime());
+		writer.Put(',');
+		writer.Put(p->getArrivalTime());
+		writer.Put(',');
+		writer.Put(p->getFinishTime());
+		writer.Put(',');
+		writer.Put(p->getTotalWaitingTime());
+		writer.Put(',');
+		writer.Put(p->getTotalTreatmentTime());
+		writer.Put(p->isCancelled() ? ",T," : ",F,");
+		writer.Put(p->isRescheduled() ? "T\n" : "F\n");
+		break;
+
+	case COLUMNAR_OUTPUT:
+		columns[0].push_back(p->getPID());
+		columns[1].push_back(p->getType() == NORMAL ? 0 : 1);
+		columns[2].push_back(p->getAppointmentTime());
+		columns[3].push_back(p->getArrivalTime());
+		columns[4].push_back(p->getFinishTime());
+		columns[5].push_back(p->getTotalWaitingTime());
+		columns[6].push_back(p->getTotalTreatmentTime());
+		columns[7].push_back(p->isCancelled() ? 1 : 0);
+		columns[8].push_back(p->isRescheduled() ? 1 : 0);
+
+		if (columns[0].size() == RESULT_ROW_GROUP)
+			FlushRowGroup();
+		break;
+	}
+}
+
+void ResultWriter::PatientFinished(const Patient* myPatient)
+{
+	WriteRow(myPatient);
+
+	//columnar rows reach the file one row group at a time
+	if (flushEvery > 0 && format != COLUMNAR_OUTPUT && ++rowsSinceFlush >= flushEvery)
+	{
+		writer.Flush();
+		rowsSinceFlush = 0;
+	}
+}
+
+void ResultWriter::setFlushEvery(int rows) { flushEvery = (rows > 0) ? rows : 0; }
+
+void ResultWriter::FlushRowGroup()
+{
+	uint32_t rows = (uint32_t)columns[0].size();
+	if (rows == 0)
+		return;
+
+	writer.Write(&rows, sizeof(rows));
+	for (vector<int32_t>& column : columns)
+	{
+		writer.Write(column.data(), column.size() * sizeof(int32_t));
+		column.clear();
+	}
+}
+
+void ResultWriter::WriteStatistics(const Schedular& mySchedular)
+{
+	if (format != TEXT_OUTPUT)
+		return;
+
+	writer.Put("\nTotal number of timesteps = ");
+	writer.Put(mySchedular.getTotalTimeSteps());
+	writer.Put("\nTotal number of all, N, and R patients = ");
+	writer.Put(mySchedular.getTotalPatients());
+	writer.Put(", ");
+	writer.Put(mySchedular.getTotal_N_Patient());
+	writer.Put(", ");
+	writer.Put(mySchedular.getTotal_R_Patient());
+
+	writer.Put("\nAverage total waiting time for all, N, and R patients = ");
+	writer.Put(mySchedular.get_AvgWait());
+	writer.Put(", ");
+	writer.Put(mySchedular.get_AvgWait_N());
+	writer.Put(", ");
+	writer.Put(mySchedular.get_AvgWait_R());
+
+	writer.Put("\nAverage total treatment time for all, N, and R patients = ");
+	writer.Put(mySchedular.get_AvgTimeTreatment());
+	writer.Put(", ");
+	writer.Put(mySchedular.get_AvgTimeTreatment_N());
+	writer.Put(", ");
+	writer.Put(mySchedular.get_AvgTimeTreatment_R());
+
+	writer.Put("\nPercentage of patients of an accepted cancellation (%) = ");
+	writer.Put(mySchedular.get_Perc_Accepted_Cancel() * 100);
+	writer.Put(" %\nPercentage of patients of an accepted rescheduling (%) = ");
+	writer.Put(mySchedular.get_Perc_Accepted_Resch() * 100);
+	writer.Put(" %\nPercentage of early patients (%) = ");
+	writer.Put(mySchedular.get_Perc_Early_Patients() * 100);
+	writer.Put(" %\nPercentage of late patients (%) = ");
+	writer.Put(mySchedular.get_Perc_Late_Patients() * 100);
+	writer.Put(" %\nAverage late penalty = ");
+	writer.Put(mySchedular.get_Avg_Late_Penalty());
+	writer.Put(" timestep(s)\nPercentage of Free Electro Device Failed (%) = ");
+	writer.Put(mySchedular.get_Perc_FreeFail_E() * 100);
+	writer.Put(" %\nPercentage of Free UltraSonic Device Failed (%) = ");
+	writer.Put(mySchedular.get_Perc_FreeFail_U() * 100);
+	writer.Put(" %\nTotal number of Busy failures for Electro Devices = ");
+	writer.Put(mySchedular.getTotal_BusyFail_E());
+	writer.Put("\nTotal number of Busy failures for UltraSonic Devices = ");
+	writer.Put(mySchedular.getTotal_BusyFail_U());
+	writer.Put('\n');
+}
+
+bool ResultWriter::Close()
+{
+	if (format == COLUMNAR_OUTPUT)
+		FlushRowGroup();
+	return writer.Close();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file ResultWriter.h
+ * @brief Writes finished patient rows and run statistics in text, CSV or columnar binary form.
+ *
+ * - TEXT_OUTPUT     : the fixed width table followed by the statistics (the historical format)
+ * - CSV_OUTPUT      : one header line and one comma separated line per patient
+ * - COLUMNAR_OUTPUT : binary, a ColumnarHeader followed by row groups. Each row group is a
+ *                     uint32_t row count followed by one int32_t array per column, in the order
+ *                     PID, PType (0 = N, 1 = R), PT, VT, FT, WT, TT, Cancel, Resc (0 = F, 1 = T).
+ *                     Loading a column is a single read, no parsing.
+ *
+ * Rows can be written one at a time as patients finish (ResultWriter is an OutputSink); the
+ * columnar backend keeps at most one row group in memory.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BufferedWriter.h"
+#include "OutputSink.h"
+#include "SchedularFwd.h"
+using namespace std;
+
+class Patient;
+
+/** @enum OutputFormat
+ *  Layout of an output file.
+ */
+enum OutputFormat { TEXT_OUTPUT, CSV_OUTPUT, COLUMNAR_OUTPUT };
+
+#define RESULT_COLUMNS 9
+#define RESULT_ROW_GROUP 65536     // rows per columnar row group
+
+/**
+ * @struct ColumnarHeader
+ * @brief First record of a columnar result file.
+ */
+struct ColumnarHeader
+{
+    char magic[4];          ///< "PCRC"
+    uint32_t version;       ///< 1
+    uint32_t columns;       ///< RESULT_COLUMNS
+    uint32_t reserved;      ///< Zero
+};
+
+/**
+ * @class ResultWriter
+ * @brief Formats result rows through a BufferedWriter.
+ */
+class ResultWriter : public OutputSink
+{
+private:
+    BufferedWriter writer;                      ///< Destination file
+    OutputFormat format;                        ///< Layout being written
+    vector<int32_t> columns[RESULT_COLUMNS];    ///< Pending columnar row group
+    int flushEvery;                             ///< Rows between forced flushes (0 = only when the buffer is full)
+    int rowsSinceFlush;                         ///< Rows written since the last forced flush
+
+    /** @brief Writes the pending columnar row group. */
+    void FlushRowGroup();
+
+public:
+    ResultWriter();
+
+    /** @brief Closes the file if still open. */
+    ~ResultWriter();
+
+    /**
+     * @brief Opens the file and writes the table header of the format.
+     * @return false if the file could not be opened.
+     */
+    bool Open(const string& fileName, OutputFormat outputFormat);
+
+    /** @brief Appends the row of one finished patient. */
+    void WriteRow(const Patient* myPatient);
+
+    /** @brief OutputSink: writes the row of a patient as soon as they finish. */
+    void PatientFinished(const Patient* myPatient) override;
+
+    /**
+     * @brief Pushes the rows to the file every given number of rows, so a killed run keeps its results so far.
+     * @param rows Rows between flushes (text and CSV), 0 flushes only when the buffer is full.
+     */
+    void setFlushEvery(int rows);
+
+    /** @brief Appends the run statistics (text format only, the tabular formats hold rows only). */
+    void WriteStatistics(const Schedular& mySchedular);
+
+    /**
+     * @brief Writes everything pending and closes the file.
+     * @return false if any write failed.
+     */
+    bool Close();
+
+    /** @brief Parses "text", "csv" or "columnar", anything else gives TEXT_OUTPUT. */
+    static OutputFormat FormatFromName(const string& name);
+
+    /** @brief File extension of a format: ".txt", ".csv" or ".col". */
+    static const char* ExtensionOf(OutputFormat outputFormat);
+};
@@ -0,0 +1,233 @@
+#include "RoomIndex.h"
+#include "GymRoom.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//index of the lowest set bit of a word that is not 0
+static int LowestBit(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return (int)index;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+//index of the highest set bit of a word that is not 0
+static int HighestBit(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, word);
+	return (int)index;
+#else
+	return 63 - __builtin_clzll(word);
+#endif
+}
+
+RoomIndex::RoomIndex() : count(0), fit(ROOM_FIRST_FREE)
+{
+}
+
+int RoomIndex::keyOf(int slot) const
+{
+	if (fit == ROOM_CONSOLIDATE)
+		return static_cast<GymRoom*>(rooms[slot])->getCapacity() - listed[slot];
+	return listed[slot];
+}
+
+void RoomIndex::Link(int slot)
+{
+	int key = keyOf(slot);
+	Bucket& bucket = buckets[key];
+
+	prev[slot] = bucket.tail;
+	next[slot] = -1;
+	if (bucket.tail >= 0)
+		next[bucket.tail] = slot;
+	else
+	{
+		bucket.head = slot;
+		keys[key >> 6] |= (uint64_t)1 << (key & 63);
+	}
+	bucket.tail = slot;
+}
+
+void RoomIndex::Unlink(int slot)
+{
+	int key = keyOf(slot);
+	Bucket& bucket = buckets[key];
+
+	if (prev[slot] >= 0)
+		next[prev[slot]] = next[slot];
+	else
+		bucket.head = next[slot];
+
+	if (next[slot] >= 0)
+		prev[next[slot]] = prev[slot];
+	else
+		bucket.tail = prev[slot];
+
+	prev[slot] = next[slot] = -1;
+	if (bucket.head < 0)
+		keys[key >> 6] &= ~((uint64_t)1 << (key & 63));
+}
+
+int RoomIndex::front() const
+{
+	if (count == 0)
+		return -1;
+
+	//best fit takes the lowest key, the other fits the highest
+	int key = -1;
+	if (fit == ROOM_BEST_FIT)
+	{
+		for (int w = 0; w < (int)keys.size() && key < 0; w++)
+		{
+			if (keys[w])
+				key = w * 64 + LowestBit(keys[w]);
+		}
+	}
+	else
+	{
+		for (int w = (int)keys.size() - 1; w >= 0 && key < 0; w--)
+		{
+			if (keys[w])
+				key = w * 64 + HighestBit(keys[w]);
+		}
+	}
+
+	if (key < 0)
+		return -1;
+	return (fit == ROOM_WORST_FIT) ? buckets[key].head : buckets[key].tail;
+}
+
+void RoomIndex::Relist(Resource* room)
+{
+	int slot = room->slot;
+	int freeSlots = static_cast<GymRoom*>(room)->getAvailableSlots();
+
+	if (listed[slot] == freeSlots)
+		return;
+
+	if (listed[slot] > 0)
+	{
+		if (fit != ROOM_FIRST_FREE)
+			Unlink(slot);
+		count--;
+	}
+
+	listed[slot] = freeSlots;
+
+	if (freeSlots > 0)
+	{
+		if (fit != ROOM_FIRST_FREE)
+			Link(slot);
+		count++;
+	}
+}
+
+void RoomIndex::Register(Resource* room)
+{
+	open.Register(room);
+
+	int slot = room->slot;
+	if (slot < (int)rooms.size())
+		return;
+
+	rooms.push_back(room);
+	listed.push_back(0);
+	next.push_back(-1);
+	prev.push_back(-1);
+
+	//one bucket per key, up to the capacity of the largest room
+	int keyCount = static_cast<GymRoom*>(room)->getCapacity() + 1;
+	if (keyCount > (int)buckets.size())
+	{
+		buckets.resize(keyCount, { -1, -1 });
+		keys.resize((keyCount + 63) / 64, 0);
+	}
+}
+
+void RoomIndex::setOrder(AllocationOrder order) { open.setOrder(order); }
+
+AllocationOrder RoomIndex::getOrder() const { return open.getOrder(); }
+
+void RoomIndex::setFit(RoomFit newFit)
+{
+	fit = newFit;
+	open.Clear();
+	for (Bucket& bucket : buckets)
+		bucket = { -1, -1 };
+	fill(keys.begin(), keys.end(), 0);
+
+	for (int slot = 0; slot < (int)rooms.size(); slot++)
+	{
+		if (listed[slot] == 0)
+			continue;
+		if (fit == ROOM_FIRST_FREE)
+			open.enqueue(rooms[slot]);
+		else
+			Link(slot);
+	}
+}
+
+RoomFit RoomIndex::getFit() const { return fit; }
+
+bool RoomIndex::enqueue(Resource* const& room)
+{
+	Register(room);
+
+	if (static_cast<GymRoom*>(room)->getAvailableSlots() <= 0)
+		return false;
+
+	if (fit == ROOM_FIRST_FREE)
+		open.enqueue(room);
+	Relist(room);
+	return true;
+}
+
+bool RoomIndex::peek(Resource*& room) const
+{
+	if (fit == ROOM_FIRST_FREE)
+		return open.peek(room);
+
+	int slot = front();
+	if (slot < 0)
+		return false;
+
+	room = rooms[slot];
+	return true;
+}
+
+void RoomIndex::Taken(Resource* room)
+{
+	if (fit == ROOM_FIRST_FREE)
+	{
+		//the room is the front of the open set, it leaves it when full or stays in its place
+		Resource* first = nullptr;
+		if (open.peek(first) && first == room)
+		{
+			if (static_cast<GymRoom*>(room)->getAvailableSlots() == 0)
+				open.dequeue(first);
+			else
+				open.Used(room);
+		}
+	}
+	Relist(room);
+}
+
+bool RoomIndex::contains(const Resource* room) const
+{
+	int slot = room->slot;
+	return slot >= 0 && slot < (int)rooms.size() && rooms[slot] == room && listed[slot] > 0;
+}
+
+bool RoomIndex::isEmpty() const { return count == 0; }
+
+int RoomIndex::getCount() const { return count; }
+
+int RoomIndex::getSize() const { return (int)rooms.size(); }
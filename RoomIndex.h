@@ -0,0 +1,138 @@
+/**
+ * @file RoomIndex.h
+ * @brief Declares the RoomIndex class, the rooms of a room lane that have a free slot.
+ *
+ * A room stays listed while it has a free slot, and the index records for every room the
+ * free slots it is listed with (0 while the room is full). A patient taking or leaving a
+ * room moves it by that state, so a room that was full is listed again whatever number of
+ * its patients leave at once. Which listed room a patient is given is the fit of the index:
+ *
+ * - ROOM_FIRST_FREE: in the allocation order of the lane (AvailabilitySet.h), the room stays
+ *   in its place while it has a slot. The default, rooms were always handed out this way.
+ * - ROOM_BEST_FIT: the room with the fewest free slots, rooms fill up one at a time and the
+ *   large empty rooms are kept for later.
+ * - ROOM_WORST_FIT: the room with the most free slots, patients are spread over the rooms.
+ * - ROOM_CONSOLIDATE: the room with the most patients in it, whatever its capacity, so the
+ *   patients gather in as few rooms as possible and the others stay empty.
+ *
+ * The fits keep one bucket per key (free slots, or patients for ROOM_CONSOLIDATE, up to the
+ * largest capacity of the lane) holding its rooms in the order they were listed, and a bit
+ * per bucket set while it holds one. Listing, moving or taking a room is O(1), finding the
+ * bucket to take from is a scan of a word per 64 keys. Within a bucket worst fit takes the
+ * room listed first, best fit and consolidation the room listed last, so a room that was just
+ * used is used again before an idle one of the same key.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "AvailabilitySet.h"
+using namespace std;
+
+class Resource;
+
+/** @enum RoomFit
+ *  Which room with a free slot a patient is given.
+ */
+enum RoomFit : int8_t
+{
+    ROOM_FIRST_FREE,        ///< Allocation order of the lane (the original order)
+    ROOM_BEST_FIT,          ///< Fewest free slots first
+    ROOM_WORST_FIT,         ///< Most free slots first
+    ROOM_CONSOLIDATE        ///< Most patients first
+};
+
+/**
+ * @class RoomIndex
+ * @brief Rooms of a lane with a free slot, by free slots, handed out by a selectable fit.
+ */
+class RoomIndex
+{
+private:
+    /** @brief Listed rooms with one key, in the order they were listed. */
+    struct Bucket
+    {
+        int head;
+        int tail;
+    };
+
+    AvailabilitySet open;           ///< ROOM_FIRST_FREE: listed rooms, gives every room its slot
+    vector<Resource*> rooms;        ///< Rooms of the lane, by slot
+    vector<int> listed;             ///< Free slots a room is listed with, 0 while it is not listed
+    vector<int> next, prev;         ///< Links of a listed room in its bucket, -1 at the ends
+    vector<Bucket> buckets;         ///< Listed rooms by key
+    vector<uint64_t> keys;          ///< Bit of a key set while its bucket holds a room
+    int count;                      ///< Listed rooms
+    RoomFit fit;
+
+    /** @brief Bucket of a listed room under the fit. */
+    int keyOf(int slot) const;
+
+    void Link(int slot);            ///< Adds a listed room at the end of its bucket
+    void Unlink(int slot);          ///< Takes a listed room out of its bucket
+
+    /** @brief Slot of the room a fit hands out next, -1 if none is listed. */
+    int front() const;
+
+    /** @brief Lists the room with its free slots now, or takes it out if it is full. */
+    void Relist(Resource* room);
+
+public:
+    /** @brief Constructs an empty index handing out rooms ROOM_FIRST_FREE in FIFO order. */
+    RoomIndex();
+
+    /** @brief Gives a room of the lane its slot, without listing it. */
+    void Register(Resource* room);
+
+    /** @brief Allocation order used by ROOM_FIRST_FREE. */
+    void setOrder(AllocationOrder order);
+    AllocationOrder getOrder() const;
+
+    /** @brief Changes the fit, the listed rooms are ordered again in slot order. */
+    void setFit(RoomFit newFit);
+    RoomFit getFit() const;
+
+    /**
+     * @brief Lists a room with its free slots now, registering it first if needed.
+     * Called when a room is added or restored and when a patient leaves it; a listed room
+     * moves to the end of its new bucket (ROOM_FIRST_FREE keeps it in its place).
+     * @return false if the room is full.
+     */
+    bool enqueue(Resource* const& room);
+
+    /** @brief Reads the room handed out next. @return false if no room has a free slot. */
+    bool peek(Resource*& room) const;
+
+    /** @brief The room handed out next got a patient, it moves by its free slots or leaves when full. */
+    void Taken(Resource* room);
+
+    bool contains(const Resource* room) const;      ///< True if the room has a free slot
+    bool isEmpty() const;
+    int getCount() const;                           ///< Rooms with a free slot
+    int getSize() const;                            ///< Rooms registered, listed or not
+
+    /**
+     * @brief Calls visit(room) for every listed room, a bucket at a time in the order the fit
+     * takes from them, each in the order its rooms were listed (ROOM_FIRST_FREE: in the order
+     * they would be handed out). Enqueueing the rooms again in this order rebuilds the index.
+     */
+    template <typename Visitor>
+    void Traverse(Visitor visit) const
+    {
+        if (fit == ROOM_FIRST_FREE)
+        {
+            open.Traverse(visit);
+            return;
+        }
+
+        int keyCount = (int)buckets.size();
+        for (int i = 0; i < keyCount; i++)
+        {
+            int key = (fit == ROOM_BEST_FIT) ? i : keyCount - 1 - i;
+            for (int slot = buckets[key].head; slot >= 0; slot = next[slot])
+                visit(rooms[slot]);
+        }
+    }
+};
@@ -1,4 +1,11 @@
 ﻿#include "Schedular.h"
+#include "TreatmentTraits.h"
+#include "PatientStream.h"
+#include "OutputSink.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <iomanip>
+#include <vector>
 
 //----------------------------------------------------------------------------------
 // PRIVATE HELPER FUNCTIONS
@@ -8,91 +15,71 @@
  * @brief Handles recovering patients and adjusts treatment order.
  * @param rec Pointer to the recovering patient.
  */
-void Schedular::_handle_recovering_patient(Patient* rec)
+template <class Policy>
+void BasicSchedular<Policy>::_handle_recovering_patient(Patient* rec)
 {
-	LinkedQueue<Treatment*> _this_patient_treatments = rec->getRemainingTreatments();
+	int _this_patient_treatments = rec->getNumber_RemainingTreatment();
 
 	//no need to handle anything, it is just 1 single treatment type
-	if (_this_patient_treatments.getCount() == 1)
+	if (_this_patient_treatments == 1)
 	{
 		return;
 	}
 
-	Treatment* next = nullptr;
+	TreatmentType least = DUMMY_THERAPY;
+	int leastWait = INT_MAX;
 
-	int eWait = INT_MAX;
-	int uWait = INT_MAX;
-	int xWait = INT_MAX;
-
-	//1) get the latemcy in each treatment type
-	while (_this_patient_treatments.dequeue(next))
+	//1) get the latency in each treatment type, ties go to the lower lane (E, U, X, then declared ones)
+	for (int i = 0; i < _this_patient_treatments; i++)
 	{
+		const Treatment* next = rec->getRemainingTreatment(i);
 		TreatmentType type = next->getType();
 
-		switch (type)
+		int wait = 0;
+		if (!next->CanAssign(*this))
+			wait = lanes[type].waiting.CalcTreatmentLatency(type, currentTime, inTreatment);
+
+		if (wait < leastWait || (wait == leastWait && type < least))
 		{
-		case E_THERAPY:
-			if (next->CanAssign(*this)) 
-				eWait = 0; 
-			else
-				eWait = Ewaiting.CalcTreatmentLatency(E_THERAPY, currentTime, inTreatment);
-			break;
-		case U_THERAPY:
-			if (next->CanAssign(*this))
-				uWait = 0;
-			else
-				uWait = Uwaiting.CalcTreatmentLatency(U_THERAPY, currentTime, inTreatment);
-			break;
-		case X_THERAPY:
-			if (next->CanAssign(*this))
-				xWait = 0;
-			else
-				xWait = Xwaiting.CalcTreatmentLatency(X_THERAPY, currentTime, inTreatment);
-			break;
+			least = type;
+			leastWait = wait;
 		}
 	}
 
-	//2) compare them
-	bool least_is_E = ((eWait <= uWait) && (eWait <= xWait));
-
-	bool least_is_U = ((uWait <= eWait) && (uWait <= xWait));
-
-	bool least_is_X = ((xWait <= uWait) && (xWait <= eWait));
-
-	//3) sort the queue of the patient accordingly
-	if		(least_is_E)
-	{
-		rec->ResortTreatments(E_THERAPY);
-	}
-	else if (least_is_U)
-	{
-		rec->ResortTreatments(U_THERAPY);
-	}
-	else  //(least_is_X)
-	{
-		rec->ResortTreatments(X_THERAPY);
-	}
+	//2) sort the queue of the patient accordingly
+	rec->ResortTreatments(least);
 }
 
 /**
  * @brief Manages rescheduling logic.
  * @return True if a patient was rescheduled, false otherwise.
  */
-bool Schedular::_handle_rescheduling_patient()
+template <class Policy>
+bool BasicSchedular<Policy>::_handle_rescheduling_patient()
 {
 	//presc is passed to compare it against a random generated number
-	Patient* isResc = EARLY_patients.RandomReschedule(pResc, lastArrivalTime);
+	Patient* isResc = EARLY_patients.RandomReschedule(pResc, lastArrivalTime, rng);
 
 	if (!isResc)
 		return false;
 
+	LogEvent(EVENT_RESCHEDULED, isResc);
+
 	AddToAllList(isResc);
 	return true;
 }
 
-ResType Schedular::_handle_busy_failure()
+template <class Policy>
+void BasicSchedular<Policy>::LogEvent(EventType type, const Patient* patient, const Resource* resource)
+{
+	if (eventLog)
+		eventLog->Record(currentTime, type, patient ? patient->getPID() : 0, resource ? resource->getID() : 0);
+}
+
+template <class Policy>
+bool BasicSchedular<Policy>::_handle_busy_failure()
 {
-	Patient* InterruptedPatient = inTreatment.RandomBusyFailure(pBusyFailure, currentTime);
+	Patient* InterruptedPatient = inTreatment.RandomBusyFailure(pBusyFailure, currentTime, rng);
 
 	if (InterruptedPatient)
 	{
@@ -101,78 +88,24 @@ ResType Schedular::_handle_busy_failure()
 
 		// 2) process the failed resource
 		Resource* AssginedRes = InterruptedPatient->getNextTreatment()->getAssignedResource();
-		Edevice* edev = dynamic_cast <Edevice*> (AssginedRes);
-		Udevice* udev = dynamic_cast <Udevice*> (AssginedRes);
-		if (edev)
-		{
-			edev->BusyFail();
-			MaintenanceE.enqueue(edev, currentTime + edev->getMaintainanceTime());
-			return _Edevice;
-		}
-		else if (udev)
-		{
-			udev->BusyFail();
-			MaintenanceU.enqueue(udev,currentTime + udev->getMaintainanceTime());
-			return _Udevice;
-		}
+		BusyFailure(lanes[AssginedRes->getLane()], InterruptedPatient, AssginedRes);
+		return true;
 	}
 
-	return _dummydevice;
+	return false;
 }
 
 /**
  * @brief Calculates final statistics after simulation ends.
  */
-void Schedular::CalcPatientStatistics()
+template <class Policy>
+void BasicSchedular<Policy>::CalcPatientStatistics()
 {
 	//prevent dividing by zero exception
 	if (TotalPatients == 0)
 		return;
 
-	ArrayStack<Patient*> copy = Finished_patients;
-
-	Patient* myPatient = nullptr;
-
-	int TotalWait = 0;
-	int TotalWait_N = 0;
-	int TotalWait_R = 0;
-
-	int TotalTreatment = 0;
-	int TotalTreatment_N = 0;
-	int TotalTreatment_R = 0;
-
-	int TotalCancelled = 0;
-	int TotalReschduled = 0;
-
-	int EarlyPatient = 0;
-
-	while (copy.pop(myPatient))
-	{
-		int _wait_time = myPatient->getTotalWaitingTime();
-		int _treatment_time = myPatient->getTotalTreatmentTime();
-
-		TotalWait += _wait_time;
-		TotalTreatment += _treatment_time;
-
-		if (myPatient->getType() == NORMAL)
-		{
-			TotalWait_N += _wait_time;
-			TotalTreatment_N += _treatment_time;
-		}
-		else
-		{
-			TotalWait_R += _wait_time;
-			TotalTreatment_R += _treatment_time;
-		}
-
-		if (myPatient->isCancelled())
-			TotalCancelled++;
-
-		if (myPatient->isRescheduled())
-			TotalReschduled++;
-
-	}
-	TotalTimeSteps;
+	//the patient totals are kept by IsPatientFinished, finished patients may be gone already
 
 	AvgWaitTime_all = (double)TotalWait / TotalTimeSteps;
 	AvgWaitTime_N = (double)TotalWait_N / TotalTimeSteps;
@@ -188,20 +121,23 @@ void Schedular::CalcPatientStatistics()
 	perc_early_patients = (double)TotalEarly / TotalPatients;
 	perc_late_patients = (double)TotalLate / TotalPatients;
 
-	if (NumEdevices)
-		perc_freefail_E = (double)TotalFreeFail_E / NumEdevices;
-	if (NumUdevices)
-		perc_freefail_U = (double)TotalFreeFail_U / NumUdevices;
+	if (lanes[E_THERAPY].numDevices)
+		perc_freefail_E = (double)lanes[E_THERAPY].totalFreeFail / lanes[E_THERAPY].numDevices;
+	if (lanes[U_THERAPY].numDevices)
+		perc_freefail_U = (double)lanes[U_THERAPY].totalFreeFail / lanes[U_THERAPY].numDevices;
 
 	//if there is no late patients, this line throughs divide by zero exception
 	if (TotalLate)
 		AvgLatePenalty = TotalLatePenalty / TotalLate;
 }
 
-void Schedular::AddToEarlyList(Patient* patient, int arr_time, int app_time)
+template <class Policy>
+void BasicSchedular<Policy>::AddToEarlyList(Patient* patient, int arr_time, int app_time)
 {
 	//set patient status
 	patient->setStatus(EARLY);
+	LogEvent(EVENT_EARLY, patient);
+	registry.Move(patient, PLACE_EARLY, -1, app_time, currentTime);
 
 	//track when the enqueuing in the EARLY List occurs
 	patient->TrackLastChange(arr_time);
@@ -216,7 +152,8 @@ void Schedular::AddToEarlyList(Patient* patient, int arr_time, int app_time)
 
 }
 
-void Schedular::AddToLateList(Patient* patient, int arr_time, int app_time)
+template <class Policy>
+void BasicSchedular<Policy>::AddToLateList(Patient* patient, int arr_time, int app_time)
 {
 	//calculate penalty
 	int penalty = (arr_time - app_time) / 2;
@@ -224,6 +161,7 @@ void Schedular::AddToLateList(Patient* patient, int arr_time, int app_time)
 	TotalLatePenalty += penalty;
 	//set patient status
 	patient->setStatus(LATE);
+	LogEvent(EVENT_LATE, patient);
 
 	//track when the enqueuing in the LATE List occurs
 	patient->TrackLastChange(arr_time);
@@ -232,22 +170,26 @@ void Schedular::AddToLateList(Patient* patient, int arr_time, int app_time)
 	int pri = penalty + arr_time;
 
 	LATE_patients.enqueue(patient, pri);
+	registry.Move(patient, PLACE_LATE, -1, pri, currentTime);
 
 	//in order not to count recovering patients twice
 	if (patient->isRescheduled()) { TotalEarly--; }
 	TotalLate++;
 }
 
-void Schedular :: AddToInterrupted(Patient* InterruptedPatient, int app_time)
+template <class Policy>
+void BasicSchedular<Policy>::AddToInterrupted(Patient* InterruptedPatient, int app_time)
 {
 	//track patient status for later checking
 	InterruptedPatient->setStatus(INTERRUPTED);
+	LogEvent(EVENT_INTERRUPTED, InterruptedPatient);
 
 	//track inserting time in the Interrupted list for waiting time calculation
 	InterruptedPatient->TrackLastChange(currentTime);
 
 	//enqueue in the interruptedPatients list
 	interruptedPatients.enqueue(InterruptedPatient, app_time);
+	registry.Move(InterruptedPatient, PLACE_INTERRUPTED, -1, app_time, currentTime);
 }
 
 /**
@@ -255,102 +197,168 @@ void Schedular :: AddToInterrupted(Patient* InterruptedPatient, int app_time)
  * @param required_treatment Pointer to the treatment.
  * @return Pointer to an available resource, or nullptr if not available.
  */
-Resource* Schedular::ReadyResource(Treatment* required_treatment) 
+template <class Policy>
+Resource* BasicSchedular<Policy>::ReadyResource(Treatment* required_treatment)
 {
-	Resource* tempRes = nullptr;
+	bool WasInterrupted = required_treatment->isInterrupted();
+	TreatmentLane& lane = lanes[required_treatment->getType()];
+
+	if (lane.kind == DEVICE_LANE)
+		return ReadyResource<DEVICE_LANE>(lane, WasInterrupted);
+	return ReadyResource<ROOM_LANE>(lane, WasInterrupted);
+}
+
+//----------------------------------------------------------------------------------
+// PER LANE PATHS
+// written once per lane kind, TreatmentTraits<K> compiles out what K does not do
+//----------------------------------------------------------------------------------
+
+template <class Policy>
+template <LaneKind K>
+Resource* BasicSchedular<Policy>::ReadyResource(TreatmentLane& lane, bool WasInterrupted)
+{
+	typedef TreatmentTraits<K> Traits;
+
+	//patients already waiting come first
 	Patient* WaitingPatient = nullptr;
+	if (lane.waiting.peek(WaitingPatient))
+		return nullptr;
 
-	Resource* isReady = nullptr;
-	TreatmentType type = required_treatment->getType();
-	bool WasInterrupted = required_treatment->isInterrupted();
+	Resource* tempRes = nullptr;
 
 	//this boolean ensures that 1 device only may FreeFail per function call
 	bool FailureOccured = false;
 
-	switch (type)
+	while (Traits::Free(lane).peek(tempRes))
 	{
-	case E_THERAPY:
-		if (!Ewaiting.peek(WaitingPatient))
+		if constexpr (Traits::freeFailure)
 		{
-			while (E_Devices.peek(tempRes))
+			//the lane only holds devices
+			typename Traits::Unit* dev = static_cast<typename Traits::Unit*>(tempRes);
+			if (!WasInterrupted && !FailureOccured && !dev->template FreeFail<Policy>(pFreeFailure, rng))
 			{
-				//to gain access to free failure functionality, we need to dynamic cast
-				Edevice* edev = dynamic_cast<Edevice*>(tempRes);
-				if (!WasInterrupted && edev && !FailureOccured && !edev->FreeFail(pFreeFailure))
-				{
-					E_Devices.dequeue(tempRes);
-					MaintenanceE.enqueue(edev, (currentTime + edev->getMaintainanceTime()));
-					FailureOccured = true;
-					if (!(edev->FailedBefore()))
-						TotalFreeFail_E++;
-				}
-				else
-				{
-					isReady = tempRes;
-					break;
-				}
-			}
-		}
-		break;
-	case U_THERAPY:
-		if (!Uwaiting.peek(WaitingPatient))
-		{
-			while (U_Devices.peek(tempRes))
-			{
-				//to gain access to free failure functionality, we need to dynamic cast
-				Udevice* udev = dynamic_cast<Udevice*>(tempRes);
-				if (!WasInterrupted && udev && !FailureOccured && !udev->FreeFail(pFreeFailure) )
-				{
-					U_Devices.dequeue(tempRes);
-					MaintenanceU.enqueue(udev, (currentTime + udev->getMaintainanceTime()));
-					FailureOccured = true;
-					if (!(udev->FailedBefore()))
-						TotalFreeFail_U++;
-				}
-				else
-				{
-					isReady = tempRes;
-					break;
-				}
+				lane.devices.dequeue(tempRes);
+				dev->TrackFailure(currentTime, false);
+				LogEvent(EVENT_FREE_FAILURE, nullptr, dev);
+				lane.maintenance.enqueue(dev, (currentTime + dev->getMaintainanceTime()));
+				FailureOccured = true;
+				if (!(dev->FailedBefore()))
+					lane.totalFreeFail++;
+				continue;
 			}
 		}
-		break;
-	case X_THERAPY:
-		if (!Xwaiting.peek(WaitingPatient))
+		return tempRes;
+	}
+
+	return nullptr;
+}
+
+template <class Policy>
+template <LaneKind K>
+void BasicSchedular<Policy>::WaitToTreatment(TreatmentLane& lane)
+{
+	typedef TreatmentTraits<K> Traits;
+
+	Patient* myPatient = nullptr;
+	Resource* ReadyResource = nullptr;
+
+	while (lane.waiting.peek(myPatient))
+	{
+		//check if there were no devices in the list
+		if (!Traits::Free(lane).peek(ReadyResource))
+			break;
+
+		if constexpr (Traits::cancellation)
 		{
-			X_Devices.peek(isReady);
+			if (lane.waiting.RandomCancel(*this))
+				continue;
 		}
-		break;
+
+		//if we reach this line, the resource is available
+		lane.waiting.dequeue(myPatient);
+
+		//add the waiting time in the waitinglist to total wait time of the patient
+		myPatient->addWaitingTime(currentTime - myPatient->getLastChange());
+
+		//keep track of last change time stamp
+		myPatient->TrackLastChange(currentTime);
+
+		//call to add to proper treatment lists
+		AddToTreatmentList(myPatient, ReadyResource);
 	}
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::CheckMaintainance(TreatmentLane& lane)
+{
+	Resource* tempRes = nullptr;
+	int maintainanceFinishTime = 0;
+
+	while (lane.maintenance.peek(tempRes, maintainanceFinishTime))
+	{
+		if (maintainanceFinishTime != currentTime)
+			break;
 
-	return isReady;
+		lane.maintenance.dequeue(tempRes, maintainanceFinishTime);
+
+		//the device works again, otherwise every later free failure check would fail it
+		static_cast<Device*>(tempRes)->Repair();
+		tempRes->TrackRepair(currentTime);
+		LogEvent(EVENT_REPAIR, nullptr, tempRes);
+
+		AddResource(tempRes);
+	}
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::BusyFailure(TreatmentLane& lane, Patient* InterruptedPatient, Resource* AssginedRes)
+{
+	//rooms never fail, TreatmentList only interrupts patients on devices
+	Device* dev = static_cast<Device*>(AssginedRes);
+	dev->BusyFail<Policy>(rng);
+	dev->TrackFailure(currentTime, true);
+	LogEvent(EVENT_BUSY_FAILURE, InterruptedPatient, dev);
+	lane.maintenance.enqueue(dev, currentTime + dev->getMaintainanceTime());
+	lane.totalBusyFail++;
 }
 
 //----------------------------------------------------------------------------------
 // PUBLIC MEMBER FUNCTION
 //----------------------------------------------------------------------------------
 
-Schedular::Schedular() :
-	NumEdevices(0),
-	NumUdevices(0),
-	NumXdevices(0),
+template <class Policy>
+BasicSchedular<Policy>::BasicSchedular() :
+	arena(&ownArena),
+	laneCount(0),
+	allocationOrder(ALLOC_FIFO),
+	roomFit(ROOM_FIRST_FREE),
 	currentTime(0),
 	lastArrivalTime(0),
 	pCancel(0),
 	pResc(0),
 	pFreeFailure(0),
 	pBusyFailure(0),
+	patientStream(nullptr),
+	outputSink(nullptr),
+	reclaimFinished(false),
+	telemetry(nullptr),
+	eventLog(nullptr),
 	TotalTimeSteps(0),
 	TotalPatients(0),
 	N_patients(0),
 	R_patients(0),
 	TotalEarly(0),
 	TotalLate(0),
-	TotalFreeFail_E(0),
-	TotalFreeFail_U(0),
-	TotalBusyFail_E(0),
-	TotalBusyFail_U(0),
 	TotalLatePenalty(0),
+	FinishedCount(0),
+	TotalWait(0),
+	TotalWait_N(0),
+	TotalWait_R(0),
+	TotalTreatment(0),
+	TotalTreatment_N(0),
+	TotalTreatment_R(0),
+	TotalCancelled(0),
+	TotalReschduled(0),
 	AvgWaitTime_all(0),
 	AvgWaitTime_N(0),
 	AvgWaitTime_R(0),
@@ -366,51 +374,79 @@ Schedular::Schedular() :
 	perc_freefail_U(0),
 	perc_Busyfail_E(0),
 	perc_Busyfail_U(0)
-{}
+{
+	//built-in lanes, in the order their phases always ran
+	DeclareLane('E', DEVICE_LANE);
+	DeclareLane('U', DEVICE_LANE);
+	DeclareLane('X', ROOM_LANE);
+
+	lanes[E_THERAPY].waitEvent = EVENT_WAIT_E;
+	lanes[U_THERAPY].waitEvent = EVENT_WAIT_U;
+	lanes[X_THERAPY].waitEvent = EVENT_WAIT_X;
+}
 
 
-void Schedular::setCurrentTime(int currtime)
+template <class Policy>
+void BasicSchedular<Policy>::setCurrentTime(int currtime)
 {
 	currentTime = (currtime > 0) ? currtime : 0;
 }
 
-void Schedular::IncrementTime()
+template <class Policy>
+void BasicSchedular<Policy>::IncrementTime()
 {
 	currentTime++;
 }
 
-void Schedular::setpCancel(int p_cancel)
+template <class Policy>
+void BasicSchedular<Policy>::setpCancel(int p_cancel)
 {
 	pCancel = (p_cancel <= 100 && p_cancel >= 0) ? p_cancel : 0;
 }
 
-void Schedular::setpResch(int p_resch)
+template <class Policy>
+void BasicSchedular<Policy>::setpResch(int p_resch)
 {
 	pResc = (p_resch <= 100 && p_resch >= 0) ? p_resch : 0;
 }
 
-void Schedular :: setpFreeFail(int pFF)
+template <class Policy>
+void BasicSchedular<Policy>::setpFreeFail(int pFF)
 {
 	pFreeFailure = (pFF <= 100 && pFF >= 0) ? pFF : 0;
 }
 
-void Schedular:: setpBusyFail(int pBF)
+template <class Policy>
+void BasicSchedular<Policy>::setpBusyFail(int pBF)
 {
 	pBusyFailure = (pBF <= 100 && pBF >= 0) ? pBF : 0;
 }
 
-void Schedular::AddToAllList(Patient* myPatient)
+template <class Policy>
+void BasicSchedular<Policy>::setSeed(unsigned long long seed)
+{
+	rng.setSeed(seed);
+}
+
+template <class Policy>
+typename BasicSchedular<Policy>::Random& BasicSchedular<Policy>::getRandomGenerator() { return rng; }
+
+template <class Policy>
+void BasicSchedular<Policy>::AddToAllList(Patient* myPatient)
 {
 	if (!myPatient)
 		return;
 
-	lastArrivalTime = myPatient->getArrivalTime();
+	//not arrived yet, the early or late list sets the status on arrival
+	myPatient->setStatus(IDLE);
+	byStatus.Attach(myPatient);
+	registry.Move(myPatient, PLACE_ALL, -1, myPatient->getArrivalTime(), currentTime);
 
-	history.enqueue(myPatient);
+	//after every patient arriving at or before them, O(1) for sorted input, O(log n) otherwise
+	ALL_patients.enqueue(myPatient);
 
 	if (!myPatient->isRescheduled())
 	{
-		ALL_patients.enqueue(myPatient);
 		if (myPatient->getType() == NORMAL)
 		{
 			N_patients++;
@@ -422,69 +458,235 @@ void Schedular::AddToAllList(Patient* myPatient)
 
 		TotalPatients++;
 	}
-	else //insert them in all list sorted by arrival time  (handling rescheduled patients)
+
+	if (myPatient->getArrivalTime() > lastArrivalTime)
+		lastArrivalTime = myPatient->getArrivalTime();
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::setPatientStream(PatientStream* stream) { patientStream = stream; }
+
+template <class Policy>
+void BasicSchedular<Policy>::setOutputSink(OutputSink* sink, bool reclaim)
+{
+	outputSink = sink;
+	reclaimFinished = sink && reclaim;
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::setTelemetry(Telemetry* recorder) { telemetry = recorder; }
+
+template <class Policy>
+void BasicSchedular<Policy>::setArena(SimulationArena* shared) { arena = shared ? shared : &ownArena; }
+
+template <class Policy>
+SimulationArena& BasicSchedular<Policy>::getArena() { return *arena; }
+
+template <class Policy>
+const ResourcePool& BasicSchedular<Policy>::getResourcePool() const { return resources; }
+
+template <class Policy>
+void BasicSchedular<Policy>::setEventLog(EventLog* log) { eventLog = log; }
+
+template <class Policy>
+void BasicSchedular<Policy>::AddResource(Resource* resource)
+{
+	if (!resource)
+		return;
+
+	TreatmentType lane = resource->getLane();
+
+	if (lane < 0 || lane >= laneCount)
+		return;
+
+	if (lanes[lane].kind == ROOM_LANE)
+		lanes[lane].rooms.enqueue(resource);
+	else
+		lanes[lane].devices.enqueue(resource);
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::UpdateNumberResources()
+{
+	for (int i = 0; i < laneCount; i++)
+		lanes[i].numDevices = lanes[i].getFreeCount();
+}
+
+template <class Policy>
+TreatmentType BasicSchedular<Policy>::DeclareLane(char code, LaneKind kind)
+{
+	if (laneCount == MAX_LANES || getLane(code) != DUMMY_THERAPY)
+		return DUMMY_THERAPY;
+
+	TreatmentLane& lane = lanes[laneCount];
+	lane.code = code;
+	lane.kind = kind;
+	lane.devices.setOrder(allocationOrder);
+	lane.rooms.setOrder(allocationOrder);
+	lane.rooms.setFit(roomFit);
+	return (TreatmentType)laneCount++;
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::setAllocationOrder(AllocationOrder order)
+{
+	allocationOrder = order;
+	for (int i = 0; i < laneCount; i++)
 	{
-		LinkedQueue<Patient*> temp;
-		Patient* tempPatient = nullptr;
-		bool inserted = false;
+		lanes[i].devices.setOrder(order);
+		lanes[i].rooms.setOrder(order);
+	}
+}
+
+template <class Policy>
+AllocationOrder BasicSchedular<Policy>::getAllocationOrder() const { return allocationOrder; }
 
-		// Move patients from ALL_patients to temp, inserting myPatient at the right place
-		while (ALL_patients.dequeue(tempPatient))
+template <class Policy>
+bool BasicSchedular<Policy>::CheckAllocation() const
+{
+	bool passed = true;
+	auto fail = [&](int lane, const char* what)
+	{
+		cout << "Error: lane " << lanes[lane].code << " at time " << currentTime << ": " << what << endl;
+		passed = false;
+	};
+
+	//patients treated on each resource and the devices under maintenance, by handle (the status
+	//of a device that failed while busy is not reset, so the lists tell which ones are held)
+	vector<int> occupants(resources.getCount(), 0);
+	vector<bool> maintained(resources.getCount(), false);
+	inTreatment.Traverse([&](Patient* p, int)
+	{
+		Resource* r = p->getNextTreatment()->getAssignedResource();
+		if (r && r->getHandle() < occupants.size())
+			occupants[r->getHandle()]++;
+	});
+	for (int i = 0; i < laneCount; i++)
+		lanes[i].maintenance.Traverse([&](Resource* r, int) { maintained[r->getHandle()] = true; });
+
+	for (int i = 0; i < laneCount; i++)
+	{
+		const TreatmentLane& lane = lanes[i];
+		bool roomLane = lane.kind == ROOM_LANE;
+
+		//what the lane hands out first has the smallest key: the room fit, else the allocation
+		//order with ties by id. FIFO hands out the resource freed first, nothing on it tells which
+		bool byFit = roomLane && roomFit != ROOM_FIRST_FREE;
+		bool ordered = byFit || allocationOrder != ALLOC_FIFO;
+		auto keyOf = [&](Resource* r) -> long long
 		{
-			if (!inserted && myPatient->getArrivalTime() < tempPatient->getArrivalTime())
+			if (byFit)
 			{
-				temp.enqueue(myPatient); // Insert before curr
-				inserted = true;
+				const GymRoom* room = static_cast<const GymRoom*>(r);
+				if (roomFit == ROOM_BEST_FIT)
+					return room->getAvailableSlots();
+				if (roomFit == ROOM_WORST_FIT)
+					return -room->getAvailableSlots();
+				return room->getAvailableSlots() - room->getCapacity();
 			}
+			if (allocationOrder == ALLOC_LEAST_USED)
+				return ((long long)r->getUsage(currentTime).sessions << 32) + r->getID();
+			return r->getID();
+		};
+
+		//the free set against the resources and the lists
+		int free = 0;
+		long long promised = 0;
+		resources.Traverse([&](Resource* r)
+		{
+			if (r->getLane() != i)
+				return;
 
-			temp.enqueue(tempPatient);
-		}
+			bool ready;
+			if (roomLane)
+			{
+				const GymRoom* room = static_cast<const GymRoom*>(r);
+				int inside = room->getCapacity() - room->getAvailableSlots();
+				if (inside < 0 || inside > room->getCapacity())
+					fail(i, "a room holds more patients than its capacity");
+				if (inside != occupants[r->getHandle()])
+					fail(i, "the occupancy of a room does not match the patients treated in it");
+
+				ready = room->getAvailableSlots() > 0;
+				if (lane.rooms.contains(r) != ready)
+					fail(i, ready ? "a room with a free slot is not listed" : "a full room is listed");
+			}
+			else
+			{
+				ready = !occupants[r->getHandle()] && !maintained[r->getHandle()];
+				if (lane.devices.contains(r) != ready)
+					fail(i, ready ? "a free device is not in the set" : "a busy or maintained device is in the set");
+				if (ready && !static_cast<Device*>(r)->isWorking())
+					fail(i, "a free device is not working");
+			}
+			if (!ready)
+				return;
 
-		// If myPatient has the latest arrival time, insert it at the end
-		if (!inserted)
-			temp.enqueue(myPatient);
+			long long key = keyOf(r);
+			promised = (free == 0 || key < promised) ? key : promised;
+			free++;
+		});
 
-		// Copy back to AllPatients
-		while (temp.dequeue(tempPatient))
+		int listed = 0;
+		Resource* next = nullptr;
+		if (roomLane)
+		{
+			lane.rooms.Traverse([&](Resource*) { listed++; });
+			lane.rooms.peek(next);
+		}
+		else
 		{
-			ALL_patients.enqueue(tempPatient);
+			lane.devices.Traverse([&](Resource*) { listed++; });
+			lane.devices.peek(next);
 		}
+		if (free != lane.getFreeCount() || listed != free)
+			fail(i, "the free count does not match the free resources");
+
+		if (ordered && next && keyOf(next) != promised)
+			fail(i, "the resource handed out next is not the one the order or fit promises");
 	}
+	return passed;
 }
 
-void Schedular::AddResource(Resource* resource)
+template <class Policy>
+void BasicSchedular<Policy>::setRoomFit(RoomFit fit)
 {
-	if (!resource)
-		return;
+	roomFit = fit;
+	for (int i = 0; i < laneCount; i++)
+		lanes[i].rooms.setFit(fit);
+}
 
-	ResType type = resource->getType();
+template <class Policy>
+RoomFit BasicSchedular<Policy>::getRoomFit() const { return roomFit; }
 
-	switch (type)
+template <class Policy>
+TreatmentType BasicSchedular<Policy>::getLane(char code) const
+{
+	for (int i = 0; i < laneCount; i++)
 	{
-	case _Edevice:
-		E_Devices.enqueue(resource);
-		break;
-	case _Udevice:
-		U_Devices.enqueue(resource);
-		break;
-	case _Xdevice:
-		X_Devices.enqueue(resource);
-		break;
+		if (lanes[i].code == code)
+			return (TreatmentType)i;
 	}
+	return DUMMY_THERAPY;
 }
 
-void Schedular::UpdateNumberResources()
-{
-	NumEdevices = E_Devices.getCount();
-	NumUdevices = U_Devices.getCount();
-	NumXdevices = X_Devices.getCount();
+template <class Policy>
+int BasicSchedular<Policy>::getLaneCount() const { return laneCount; }
 
-}
+template <class Policy>
+char BasicSchedular<Policy>::getLaneCode(TreatmentType lane) const { return lanes[lane].code; }
 
-void Schedular::CheckAllPatientList()
+template <class Policy>
+void BasicSchedular<Policy>::CheckAllPatientList()
 {
+	typename Instrumentation::Scope profile(PROFILE_CHECK_ALL_PATIENTS);
+
 	Patient* myPatient = nullptr;
 
+	//streamed input: bring in every patient arriving by now
+	if (patientStream)
+		patientStream->Feed(*this);
+
 	while (ALL_patients.peek(myPatient))
 	{
 		int arr_time = myPatient->getArrivalTime();
@@ -510,8 +712,11 @@ void Schedular::CheckAllPatientList()
 	}
 }
 
-void  Schedular::CheckInterrupted()
+template <class Policy>
+void  BasicSchedular<Policy>::CheckInterrupted()
 {
+	typename Instrumentation::Scope profile(PROFILE_CHECK_INTERRUPTED);
+
 	Patient* myPatient = nullptr;
 	int app_time = 0;
 
@@ -532,40 +737,23 @@ void  Schedular::CheckInterrupted()
 	}
 }
 
-void  Schedular::CheckMaintainanceList()
+template <class Policy>
+void  BasicSchedular<Policy>::CheckMaintainanceList()
 {
-	Resource* tempRes = nullptr;
+	typename Instrumentation::Scope profile(PROFILE_CHECK_MAINTAINANCE);
 
-	int maintainanceFinishTime = 0;
-	while (MaintenanceE.peek(tempRes, maintainanceFinishTime))
+	for (int i = 0; i < laneCount; i++)
 	{
-		if (maintainanceFinishTime == currentTime)
-		{
-			MaintenanceE.dequeue(tempRes, maintainanceFinishTime);
-			AddResource(tempRes);
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	while (MaintenanceU.peek(tempRes, maintainanceFinishTime))
-	{
-		if (maintainanceFinishTime == currentTime)
-		{
-			MaintenanceU.dequeue(tempRes, maintainanceFinishTime);
-			AddResource(tempRes);
-		}
-		else
-		{
-			break;
-		}
+		if (lanes[i].kind == DEVICE_LANE)
+			CheckMaintainance(lanes[i]);
 	}
 }
 
-void Schedular::EarlyToWait()
+template <class Policy>
+void BasicSchedular<Policy>::EarlyToWait()
 {
+	typename Instrumentation::Scope profile(PROFILE_EARLY_TO_WAIT);
+
 	Patient* myPatient = nullptr;
 	int TreatmentStartTimeStep;
 
@@ -626,8 +814,7 @@ void Schedular::EarlyToWait()
 			}
 			else
 			{
-				//which Waiting list is determind by which treatment this function is being called on
-				//POLYMORPHISM BABY!!!
+				//which Waiting list is determind by the lane of the treatment
 				myTreatment->MoveToWait(*this, myPatient);
 			}
 		}
@@ -647,8 +834,11 @@ void Schedular::EarlyToWait()
 	}
 }
 
-void Schedular::LateToWait()
+template <class Policy>
+void BasicSchedular<Policy>::LateToWait()
 {
+	typename Instrumentation::Scope profile(PROFILE_LATE_TO_WAIT);
+
 	Patient* myPatient = nullptr;
 	int TreatmentStartTimeStep;
 
@@ -692,158 +882,60 @@ void Schedular::LateToWait()
 }
 
 //*******************************************************//
-//next 3 functions are called by Treatment.MoveToWait(..)
-bool Schedular::addToEWait(Patient* myPatient)
+//called by Treatment.MoveToWait(..)
+template <class Policy>
+bool BasicSchedular<Policy>::addToWait(TreatmentType lane, Patient* myPatient)
 {
-	PatientStatus status = myPatient->getStatus();
-	int priority;
-
-	switch (status)
-	{
-	case EARLY:
-		Ewaiting.enqueue(myPatient);
-		break;
-	case LATE:
-		priority = myPatient->getAppointmentTime() + ((myPatient->getArrivalTime() - myPatient->getAppointmentTime()) / 2);
-		Ewaiting.insertSorted(myPatient, priority);
-		break;
-	case SERV:
-		priority = myPatient->getAppointmentTime();
-		Ewaiting.insertSorted(myPatient, priority);
-		break;
-	}
+	typename Policy::WaitList& waiting = lanes[lane].waiting;
 
-	myPatient->setStatus(WAIT);
-	return true;
-}
-
-bool Schedular::addToUWait(Patient* myPatient)
-{
 	PatientStatus status = myPatient->getStatus();
 	int priority;
 
 	switch (status)
 	{
 	case EARLY:
-		Uwaiting.enqueue(myPatient);
+		waiting.enqueue(myPatient);
 		break;
 	case LATE:
 		priority = myPatient->getAppointmentTime() + ((myPatient->getArrivalTime() - myPatient->getAppointmentTime()) / 2);
-		Uwaiting.insertSorted(myPatient, priority);
+		waiting.insertSorted(myPatient, priority);
 		break;
 	case SERV:
 		priority = myPatient->getAppointmentTime();
-		Uwaiting.insertSorted(myPatient, priority);
-		break;
-	}
-
-	myPatient->setStatus(WAIT);
-	return true;
-}
-
-bool Schedular::addToXWait(Patient* myPatient)
-{
-	PatientStatus status = myPatient->getStatus();
-	int priority;
-
-	switch (status)
-	{
-	case EARLY:
-		Xwaiting.enqueue(myPatient);
-		break;
-	case LATE:
-		priority = myPatient->getAppointmentTime() + ((myPatient->getArrivalTime() - myPatient->getAppointmentTime()) / 2);
-		Xwaiting.insertSorted(myPatient, priority);
-		break;
-	case SERV:
-		priority = myPatient->getAppointmentTime();
-		Xwaiting.insertSorted(myPatient, priority);
+		waiting.insertSorted(myPatient, priority);
 		break;
 	}
 
 	myPatient->setStatus(WAIT);
+	LogEvent(lanes[lane].waitEvent, myPatient);
+	registry.Move(myPatient, PLACE_WAIT, lane, -1, currentTime);
 	return true;
 }
 //*******************************************************//
 
-//the next 3 functions are called by Treatment :: CanAssign()
-bool Schedular::CanAssignE() const  {  return !(E_Devices.isEmpty());  }
-bool Schedular::CanAssignU() const  {  return !(U_Devices.isEmpty());  }
-bool Schedular::CanAssignX() const  {  return !(X_Devices.isEmpty());  }
+//called by Treatment :: CanAssign()
+template <class Policy>
+bool BasicSchedular<Policy>::CanAssign(TreatmentType lane) const  {  return lanes[lane].getFreeCount() != 0;  }
 
 //*******************************************************//
 
 
-void Schedular::WaitToTreatment()
+template <class Policy>
+void BasicSchedular<Policy>::WaitToTreatment()
 {
-	Patient* myPatient = nullptr;
-	Resource* ReadyResource = nullptr;
-
-	//for E-treatment patients
-	while (Ewaiting.peek(myPatient))
-	{
-		//check if there were no devices in the list
-		if (!E_Devices.peek(ReadyResource))
-			break;
-
-		//if we reach this line, the resource is available
-		Ewaiting.dequeue(myPatient);
-
-		//add the waiting time in the waitinglist to total wait time of the patient
-		myPatient->addWaitingTime(currentTime - myPatient->getLastChange());
-
-		//keep track of last change time stamp
-		myPatient->TrackLastChange(currentTime);
-
-		//call to add to proper treatment lists
-		AddToTreatmentList(myPatient, ReadyResource);
-	}
+	typename Instrumentation::Scope profile(PROFILE_WAIT_TO_TREATMENT);
 
-	//for E-treatment patients
-	while (Uwaiting.peek(myPatient))
+	for (int i = 0; i < laneCount; i++)
 	{
-		//check if there were no devices in the list
-		if (!U_Devices.peek(ReadyResource))
-			break;
-
-		//if we reach this line, the resource is available
-		Uwaiting.dequeue(myPatient);
-
-		//add the waiting time in the waitinglist to total wait time of the patient
-		myPatient->addWaitingTime(currentTime - myPatient->getLastChange());
-
-		//keep track of last change time stamp
-		myPatient->TrackLastChange(currentTime);
-
-		//call to add to proper treatment lists
-		AddToTreatmentList(myPatient, ReadyResource);
-	}
-
-	//for X-treatment patients
-	while (Xwaiting.peek(myPatient))
-	{
-		//check if there were no devices in the list
-		if (!X_Devices.peek(ReadyResource))
-			break;
-
-		if (Xwaiting.RandomCancel(*this))
-			continue;
-
-		//if we reach this line, the resource is available
-		Xwaiting.dequeue(myPatient);
-
-		//add the waiting time in the waitinglist to total wait time
-		myPatient->addWaitingTime(currentTime - myPatient->getLastChange());
-
-		//keep track of last change time stamp
-		myPatient->TrackLastChange(currentTime);
-
-		//call to add to proper treatment lists
-		AddToTreatmentList(myPatient, ReadyResource);
+		if (lanes[i].kind == DEVICE_LANE)
+			WaitToTreatment<DEVICE_LANE>(lanes[i]);
+		else
+			WaitToTreatment<ROOM_LANE>(lanes[i]);
 	}
 }
 
-void Schedular::AddToTreatmentList(Patient* myPatient, Resource* myResource)
+template <class Policy>
+void BasicSchedular<Policy>::AddToTreatmentList(Patient* myPatient, Resource* myResource)
 {
 	//get pointer to treatment to be healed
 	Treatment* treatment = myPatient->getNextTreatment();
@@ -856,25 +948,22 @@ void Schedular::AddToTreatmentList(Patient* myPatient, Resource* myResource)
 	// 1.2) track assignment time data member
 	treatment->setAssignmentTime(currentTime);
 
+	// 1.3) count the session in the resource usage
+	myResource->TrackAssign(currentTime);
+	LogEvent(EVENT_SERVE, myPatient, myResource);
+
 	// 2) process resource
 	// 
 	//dequeue from available devices of the schedular
-	if (!myResource->isAvailable())
+	TreatmentLane& lane = lanes[myResource->getLane()];
+	if (lane.kind == DEVICE_LANE)
 	{
-		ResType type = myResource->getType();
-
-		switch (type)
-		{
-		case _Edevice:
-			E_Devices.dequeue(myResource);
-			break;
-		case _Udevice:
-			U_Devices.dequeue(myResource);
-			break;
-		case _Xdevice:
-			X_Devices.dequeue(myResource);
-			break;
-		}
+		lane.devices.dequeue(myResource);
+	}
+	else
+	{
+		//a room moves by its free slots left, and leaves the index when full
+		lane.rooms.Taken(myResource);
 	}
 
 	// 3) process patient
@@ -886,10 +975,14 @@ void Schedular::AddToTreatmentList(Patient* myPatient, Resource* myResource)
 	int TreatmentDuration = treatment->getDuration();
 
 	inTreatment.enqueue(myPatient, currentTime + TreatmentDuration);
+	registry.Move(myPatient, PLACE_TREATMENT, myResource->getLane(), currentTime + TreatmentDuration, currentTime);
 }
 
-void Schedular::MoveToNextTreatment() 
+template <class Policy>
+void BasicSchedular<Policy>::MoveToNextTreatment() 
 {
+	typename Instrumentation::Scope profile(PROFILE_MOVE_TO_NEXT_TREATMENT);
+
 	Patient* myPatient = nullptr;
 	int Treatment_finishTime;
 	Resource* FreeResource = nullptr;
@@ -899,37 +992,25 @@ void Schedular::MoveToNextTreatment()
 		//process the patient and its assigned resource
 		if (currentTime >= Treatment_finishTime)
 		{
-			// 1) process resource
+			// 1) process current treatment, completing it releases the resource
+			//(releasing it here as well freed a second slot of a room)
 			FreeResource = myPatient->getNextTreatment()->getAssignedResource();
+			TreatmentLane& lane = lanes[FreeResource->getLane()];
+			myPatient->completeCurrentTreatment(currentTime);
 
-			//prepare a pointer with gymRoom functionality
-			GymRoom* device = dynamic_cast<GymRoom*>(FreeResource);
-
-			//set its status
-			FreeResource->releasePatient();
-
-			ResType type = FreeResource->getType();
+			// 2) process resource
+			FreeResource->TrackRelease(currentTime);
+			LogEvent(EVENT_RELEASE, myPatient, FreeResource);
 
-			switch (type)
+			if (lane.kind == DEVICE_LANE)
 			{
-			case _Edevice:
-				E_Devices.enqueue(FreeResource);
-				break;
-			case _Udevice:
-				U_Devices.enqueue(FreeResource);
-				break;
-			case _Xdevice:
-				if (device->getAvailableSlots() == 1) 
-				//this indicates the room was previously 0 and now only has 1 available slot
-				//which indicates it was previously dequeued from the X_Devices
-				{
-					X_Devices.enqueue(FreeResource);
-				}
-				break;
+				lane.devices.enqueue(FreeResource);
+			}
+			else
+			{
+				//listed again with its free slots, whether it was full or not
+				lane.rooms.enqueue(FreeResource);
 			}
-
-			// 2) process current treatment
-			myPatient->completeCurrentTreatment(currentTime);
 
 			// 3) process patient
 			inTreatment.dequeue(myPatient, Treatment_finishTime);
@@ -950,17 +1031,8 @@ void Schedular::MoveToNextTreatment()
 		}
 		else
 		{
-			ResType type = _handle_busy_failure();
-
-			switch (type)
-			{
-			case _Edevice:
-				TotalBusyFail_E++;
-				break;
-			case _Udevice:
-				TotalBusyFail_U++;
-				break;
-			}
+			//the failed device counts in its lane
+			_handle_busy_failure();
 
 			return;
 		}
@@ -968,124 +1040,310 @@ void Schedular::MoveToNextTreatment()
 }
 
 
-bool Schedular::IsPatientFinished(Patient* myPatient) 
+template <class Policy>
+void BasicSchedular<Policy>::SimulateTimeStep()
+{
+	//same order as the main simulation loop, devices and finished treatments are freed first
+	CheckMaintainanceList();
+	MoveToNextTreatment();
+
+	CheckAllPatientList();
+	CheckInterrupted();
+	EarlyToWait();
+	LateToWait();
+	WaitToTreatment();
+
+	if (telemetry)
+		telemetry->Record(*this);
+}
+
+template <class Policy>
+bool BasicSchedular<Policy>::IsPatientFinished(Patient* myPatient) 
 {
 	if (myPatient->getStatus() == FINISHED)
 	{
-		Finished_patients.push(myPatient);
 		TotalTimeSteps = currentTime;
 		myPatient->setFinishTime(currentTime);
+
+		int _wait_time = myPatient->getTotalWaitingTime();
+		int _treatment_time = myPatient->getTotalTreatmentTime();
+
+		FinishedCount++;
+		TotalWait += _wait_time;
+		TotalTreatment += _treatment_time;
+
+		if (myPatient->getType() == NORMAL)
+		{
+			TotalWait_N += _wait_time;
+			TotalTreatment_N += _treatment_time;
+		}
+		else
+		{
+			TotalWait_R += _wait_time;
+			TotalTreatment_R += _treatment_time;
+		}
+
+		if (myPatient->isCancelled())
+			TotalCancelled++;
+
+		if (myPatient->isRescheduled())
+			TotalReschduled++;
+
+		LogEvent(myPatient->isCancelled() ? EVENT_CANCELLED : EVENT_FINISHED, myPatient);
+		registry.Move(myPatient, PLACE_FINISHED, -1, -1, currentTime);
+
+		if (outputSink)
+			outputSink->PatientFinished(myPatient);
+
+		if (reclaimFinished)
+		{
+			registry.Release(myPatient->getPID());
+			delete myPatient;
+		}
+		else
+			Finished_patients.push(myPatient);
 		return true;
 	}
 
 	return false;
 }
 
-int Schedular::getCurrentTime() const { return currentTime; }
+template <class Policy>
+int BasicSchedular<Policy>::getCurrentTime() const { return currentTime; }
 
-int Schedular::getLastArrivalTime() const { return lastArrivalTime; }
+template <class Policy>
+int BasicSchedular<Policy>::getLastArrivalTime() const { return lastArrivalTime; }
 
-int Schedular::getEarlyPatientsCount() const { return EARLY_patients.getCount(); }
+template <class Policy>
+int BasicSchedular<Policy>::getEarlyPatientsCount() const { return EARLY_patients.getCount(); }
 
-int Schedular::getLatePatientsCount() const { return LATE_patients.getCount(); }
+template <class Policy>
+int BasicSchedular<Policy>::getLatePatientsCount() const { return LATE_patients.getCount(); }
 
-int Schedular::getEWaitCount() const { return Ewaiting.getCount(); }
+template <class Policy>
+int BasicSchedular<Policy>::getEWaitCount() const { return getWaitCount(E_THERAPY); }
 
-int Schedular::getUWaitCount() const { return Uwaiting.getCount(); }
+template <class Policy>
+int BasicSchedular<Policy>::getUWaitCount() const { return getWaitCount(U_THERAPY); }
 
-int Schedular::getXWaitCount() const { return Xwaiting.getCount(); }
+template <class Policy>
+int BasicSchedular<Policy>::getXWaitCount() const { return getWaitCount(X_THERAPY); }
 
-int Schedular::getInTreatmentCount() const { return inTreatment.getCount(); }
+template <class Policy>
+int BasicSchedular<Policy>::getWaitCount(TreatmentType lane) const { return lanes[lane].waiting.getCount(); }
 
-int Schedular::getInterruptedCount() const { return interruptedPatients.getCount(); }
+template <class Policy>
+int BasicSchedular<Policy>::getInTreatmentCount() const { return inTreatment.getCount(); }
 
-bool Schedular::isThereMaintainance() const { return (MaintenanceE.getCount() || MaintenanceU.getCount()); }
+template <class Policy>
+int BasicSchedular<Policy>::getInterruptedCount() const { return interruptedPatients.getCount(); }
 
-void Schedular::printResources() const
+template <class Policy>
+bool BasicSchedular<Policy>::isThereMaintainance() const
+{
+	for (int i = 0; i < laneCount; i++)
+	{
+		if (lanes[i].maintenance.getCount())
+			return true;
+	}
+	return false;
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::printResources() const
 {
 	cout << "\n=========== Resource Counts ===========\n";
-	cout << "E-Devices: " << E_Devices.getCount() << endl;
-	cout << "U-Devices: " << U_Devices.getCount() << endl;
-	cout << "X - Rooms: " << X_Devices.getCount() << endl;
+	cout << "E-Devices: " << lanes[E_THERAPY].getFreeCount() << endl;
+	cout << "U-Devices: " << lanes[U_THERAPY].getFreeCount() << endl;
+	cout << "X - Rooms: " << lanes[X_THERAPY].getFreeCount() << endl;
+	for (int i = X_THERAPY + 1; i < laneCount; i++)
+		cout << lanes[i].code << (lanes[i].kind == DEVICE_LANE ? "-Devices: " : " - Rooms: ") << lanes[i].getFreeCount() << endl;
 	cout << "=======================================\n";
 }
 
-void Schedular::printEarlyPatients() const {  EARLY_patients.printQueue();  }
+template <class Policy>
+void BasicSchedular<Policy>::printEarlyPatients() const {  EARLY_patients.printQueue();  }
 
-void Schedular::printLatePatients() const { LATE_patients.printQueue(); }
+template <class Policy>
+void BasicSchedular<Policy>::printLatePatients() const { LATE_patients.printQueue(); }
 
-void Schedular::printEWait() const { Ewaiting.printQueue(); }
+template <class Policy>
+void BasicSchedular<Policy>::printEWait() const { printWait(E_THERAPY); }
 
-void Schedular::printUWait() const { Uwaiting.printQueue(); }
+template <class Policy>
+void BasicSchedular<Policy>::printUWait() const { printWait(U_THERAPY); }
 
-void Schedular::printXWait() const { Xwaiting.printQueue(); }
+template <class Policy>
+void BasicSchedular<Policy>::printXWait() const { printWait(X_THERAPY); }
 
-void Schedular::printInTreatment() const { inTreatment.printQueue(); }
+template <class Policy>
+void BasicSchedular<Policy>::printWait(TreatmentType lane) const { lanes[lane].waiting.printQueue(); }
 
-void Schedular::printInterruptedList() const { interruptedPatients.printQueue(); }
+template <class Policy>
+void BasicSchedular<Policy>::printInTreatment() const { inTreatment.printQueue(); }
 
-void Schedular::printMaintainance() const 
+template <class Policy>
+void BasicSchedular<Policy>::printInterruptedList() const { interruptedPatients.printQueue(); }
+
+template <class Policy>
+void BasicSchedular<Policy>::printMaintainance() const 
 {
-	if (!MaintenanceE.isEmpty())
+	for (int i = 0; i < laneCount; i++)
 	{
-		MaintenanceE.printQueue();	
+		if (!lanes[i].maintenance.isEmpty())
+		{
+			lanes[i].maintenance.printQueue();
+		}
 	}
-	if (!MaintenanceU.isEmpty())
+}
+
+template <class Policy>
+void BasicSchedular<Policy>::printUtilization(ostream& os) const
+{
+	//free, maintained and busy resources alike, all of them are in the pool
+	vector<Resource*> byID;
+	byID.reserve(resources.getCount());
+	resources.Traverse([&](Resource* r) { byID.push_back(r); });
+	sort(byID.begin(), byID.end(), [](Resource* a, Resource* b) { return a->getID() < b->getID(); });
+
+	ResourceUsage totals[MAX_LANES] = {};
+	long long capacityTicks[MAX_LANES] = {};
+	int counts[MAX_LANES] = {};
+	long long elapsed = (currentTime > 0) ? currentTime : 1;
+	streamsize precision = os.precision();
+
+	os << "\n=========== Resource Utilization ===========\n" << left << fixed << setprecision(1)
+		<< setw(6) << "ID" << setw(6) << "Type" << setw(10) << "Sessions" << setw(10) << "Busy"
+		<< setw(10) << "Idle" << setw(10) << "Maint" << setw(10) << "BusyFail" << setw(10) << "FreeFail"
+		<< setw(10) << "Busy %" << "Occupancy %\n";
+
+	for (Resource* r : byID)
 	{
-		MaintenanceU.printQueue(); 
+		int t = r->getLane();
+		if (t < 0 || t >= laneCount)
+			continue;
+
+		//a room is occupied per slot, a device holds one patient
+		long long capacity = elapsed * (lanes[t].kind == ROOM_LANE ? static_cast<GymRoom*>(r)->getCapacity() : 1);
+		ResourceUsage u = r->getUsage(currentTime);
+
+		os << setw(6) << r->getID() << setw(6) << lanes[t].code << setw(10) << u.sessions << setw(10) << u.busyTicks
+			<< setw(10) << u.idleTicks << setw(10) << u.maintenanceTicks << setw(10) << u.busyFailures
+			<< setw(10) << u.freeFailures << setw(10) << 100.0 * u.busyTicks / elapsed
+			<< 100.0 * u.occupancyTicks / capacity << "\n";
+
+		ResourceUsage& total = totals[t];
+		total.busyTicks += u.busyTicks;
+		total.idleTicks += u.idleTicks;
+		total.maintenanceTicks += u.maintenanceTicks;
+		total.occupancyTicks += u.occupancyTicks;
+		total.sessions += u.sessions;
+		total.busyFailures += u.busyFailures;
+		total.freeFailures += u.freeFailures;
+		capacityTicks[t] += capacity;
+		counts[t]++;
+	}
+
+	os << "\n" << setw(6) << "Type" << setw(8) << "Count" << setw(10) << "Sessions" << setw(10) << "Busy %"
+		<< setw(10) << "Idle %" << setw(10) << "Maint %" << setw(10) << "Failures" << "Occupancy %\n";
+	for (int t = 0; t < laneCount; t++)
+	{
+		if (!counts[t])
+			continue;
+
+		const ResourceUsage& total = totals[t];
+		double deviceTicks = (double)elapsed * counts[t];
+		os << setw(6) << lanes[t].code << setw(8) << counts[t] << setw(10) << total.sessions
+			<< setw(10) << 100.0 * total.busyTicks / deviceTicks << setw(10) << 100.0 * total.idleTicks / deviceTicks
+			<< setw(10) << 100.0 * total.maintenanceTicks / deviceTicks << setw(10) << total.busyFailures + total.freeFailures
+			<< 100.0 * total.occupancyTicks / capacityTicks[t] << "\n";
 	}
+	os << "============================================\n" << defaultfloat << setprecision(precision) << right;
 }
 
-int Schedular::getpCancel() const { return pCancel; }
+template <class Policy>
+int BasicSchedular<Policy>::getpCancel() const { return pCancel; }
 
-int Schedular::getpResc() const { return pResc; }
+template <class Policy>
+int BasicSchedular<Policy>::getpResc() const { return pResc; }
 
-int Schedular::getTotalPatients() const { return TotalPatients; }
+template <class Policy>
+int BasicSchedular<Policy>::getTotalPatients() const { return TotalPatients; }
 
-int Schedular::getTotalResources() const 
+template <class Policy>
+int BasicSchedular<Policy>::getTotalResources() const 
 {
-	return E_Devices.getCount() + U_Devices.getCount() + X_Devices.getCount(); 
+	int total = 0;
+	for (int i = 0; i < laneCount; i++)
+		total += lanes[i].getFreeCount();
+	return total;
 }
 
-int Schedular::getTotalTimeSteps() const { return TotalTimeSteps; }
+template <class Policy>
+int BasicSchedular<Policy>::getTotalTimeSteps() const { return TotalTimeSteps; }
+
+template <class Policy>
+int BasicSchedular<Policy>::getTotal_N_Patient() const { return N_patients; }
 
-int Schedular::getTotal_N_Patient() const { return N_patients; }
+template <class Policy>
+int BasicSchedular<Policy>::getTotal_R_Patient() const { return R_patients; }
 
-int Schedular::getTotal_R_Patient() const { return R_patients; }
+template <class Policy>
+int BasicSchedular<Policy>::getTotal_BusyFail_E() const { return getTotal_BusyFail(E_THERAPY);  }
 
-int Schedular::getTotal_BusyFail_E() const { return TotalBusyFail_E;  }
+template <class Policy>
+int BasicSchedular<Policy>::getTotal_BusyFail_U() const { return getTotal_BusyFail(U_THERAPY);  }
 
-int Schedular::getTotal_BusyFail_U() const { return TotalBusyFail_U;  }
+template <class Policy>
+int BasicSchedular<Policy>::getTotal_BusyFail(TreatmentType lane) const { return lanes[lane].totalBusyFail; }
 
-double Schedular::get_AvgWait() const { return AvgWaitTime_all; }
+template <class Policy>
+double BasicSchedular<Policy>::get_AvgWait() const { return AvgWaitTime_all; }
 
-double Schedular::get_AvgWait_N() const { return AvgWaitTime_N; }
+template <class Policy>
+double BasicSchedular<Policy>::get_AvgWait_N() const { return AvgWaitTime_N; }
 
-double Schedular::get_AvgWait_R() const { return AvgWaitTime_R; }
+template <class Policy>
+double BasicSchedular<Policy>::get_AvgWait_R() const { return AvgWaitTime_R; }
 
-double Schedular::get_AvgTimeTreatment() const { return AvgTreatmentTime_all; }
+template <class Policy>
+double BasicSchedular<Policy>::get_AvgTimeTreatment() const { return AvgTreatmentTime_all; }
 
-double Schedular::get_AvgTimeTreatment_N() const { return AvgTreatmentTime_N; }
+template <class Policy>
+double BasicSchedular<Policy>::get_AvgTimeTreatment_N() const { return AvgTreatmentTime_N; }
 
-double Schedular::get_AvgTimeTreatment_R() const { return AvgTreatmentTime_R; }
+template <class Policy>
+double BasicSchedular<Policy>::get_AvgTimeTreatment_R() const { return AvgTreatmentTime_R; }
 
-double Schedular::get_Perc_Accepted_Cancel() const { return perc_accepted_cancell; }
+template <class Policy>
+double BasicSchedular<Policy>::get_Perc_Accepted_Cancel() const { return perc_accepted_cancell; }
 
-double Schedular::get_Perc_Accepted_Resch() const { return perc_accepted_resch; }
+template <class Policy>
+double BasicSchedular<Policy>::get_Perc_Accepted_Resch() const { return perc_accepted_resch; }
 
-double Schedular::get_Perc_Early_Patients() const { return perc_early_patients; }
+template <class Policy>
+double BasicSchedular<Policy>::get_Perc_Early_Patients() const { return perc_early_patients; }
 
-double Schedular::get_Perc_Late_Patients() const { return perc_late_patients; }
+template <class Policy>
+double BasicSchedular<Policy>::get_Perc_Late_Patients() const { return perc_late_patients; }
 
-double Schedular::get_Avg_Late_Penalty() const { return AvgLatePenalty; }
+template <class Policy>
+double BasicSchedular<Policy>::get_Avg_Late_Penalty() const { return AvgLatePenalty; }
 
-double Schedular::get_Perc_FreeFail_E() const { return perc_freefail_E; }
+template <class Policy>
+double BasicSchedular<Policy>::get_Perc_FreeFail_E() const { return perc_freefail_E; }
 
-double Schedular::get_Perc_FreeFail_U() const { return perc_freefail_U; }
+template <class Policy>
+double BasicSchedular<Policy>::get_Perc_FreeFail_U() const { return perc_freefail_U; }
 
-bool Schedular::SimulationEnded() 
+template <class Policy>
+bool BasicSchedular<Policy>::SimulationEnded() 
 { 
-	if (TotalPatients == Finished_patients.getCount() && MaintenanceE.isEmpty() && MaintenanceU.isEmpty())
+	//with streamed input, more patients may still be on their way
+	if (patientStream && !patientStream->Exhausted())
+		return false;
+
+	if (TotalPatients == FinishedCount && !isThereMaintainance())
 	{
 		CalcPatientStatistics();
 		return true;
@@ -1093,13 +1351,69 @@ bool Schedular::SimulationEnded()
 	return false;
 }
 
-LinkedQueue<Patient*> Schedular::getHistory() const { return history;  }
+template <class Policy>
+const PatientRegistry& BasicSchedular<Policy>::getRegistry() const { return registry; }
+
+template <class Policy>
+const PatientEntry* BasicSchedular<Policy>::findPatient(int PID) const { return registry.Find(PID); }
+
+template <class Policy>
+const StatusIndex& BasicSchedular<Policy>::getStatusIndex() const { return byStatus; }
 
-priQueue <Resource*>  Schedular::getE_MaintainanceList() const { return MaintenanceE; }
-priQueue <Resource*>  Schedular::getU_MaintainanceList() const { return MaintenanceU; }
+template <class Policy>
+typename BasicSchedular<Policy>::template PriorityQueue<Resource*> BasicSchedular<Policy>::getE_MaintainanceList() const { return lanes[E_THERAPY].maintenance; }
+template <class Policy>
+typename BasicSchedular<Policy>::template PriorityQueue<Resource*> BasicSchedular<Policy>::getU_MaintainanceList() const { return lanes[U_THERAPY].maintenance; }
 
-ArrayStack<Patient*> Schedular::getFinishedPatients() const { return Finished_patients; }
+template <class Policy>
+ArrayStack<Patient*> BasicSchedular<Policy>::getFinishedPatients() const { return Finished_patients; }
 
-LinkedQueue<Patient*> Schedular::getAllPatientList() const { return ALL_patients; }
+template <class Policy>
+int BasicSchedular<Policy>::getFinishedCount() const { return Finished_patients.getCount(); }
+
+template <class Policy>
+int BasicSchedular<Policy>::getTotalFinished() const { return FinishedCount; }
+
+template <class Policy>
+Patient* BasicSchedular<Policy>::getFinishedPatient(int index) const
+{
+	Patient* myPatient = nullptr;
+	Finished_patients.peekAt(index, myPatient);
+	return myPatient;
+}
+
+template <class Policy>
+LinkedQueue<Patient*> BasicSchedular<Policy>::getAllPatientList() const { return ALL_patients.toQueue(); }
+
+template <class Policy>
+BasicSchedular<Policy>::~BasicSchedular()
+{
+	//every patient is in exactly one of these lists (the registry only refers to them). This is
+	//not the O(1) teardown of releasing the arena alone: a patient leaves the status index in its
+	//destructor and the list nodes are on the heap, so every list is walked once
+	Patient* myPatient = nullptr;
+	int priority = 0;
+
+	while (ALL_patients.dequeue(myPatient))
+		delete myPatient;
+	while (EARLY_patients.dequeue(myPatient, priority))
+		delete myPatient;
+	while (LATE_patients.dequeue(myPatient, priority))
+		delete myPatient;
+	for (int i = 0; i < laneCount; i++)
+	{
+		while (lanes[i].waiting.dequeue(myPatient))
+			delete myPatient;
+	}
+	while (interruptedPatients.dequeue(myPatient, priority))
+		delete myPatient;
+	while (inTreatment.dequeue(myPatient, priority))
+		delete myPatient;
+	while (Finished_patients.pop(myPatient))
+		delete myPatient;
+
+	//resources hold no memory of their own, the pool takes them with its storage
+}
 
-Schedular::~Schedular() {}
+#define INSTANTIATE_SCHEDULAR(Policy) template class BasicSchedular<Policy>;
+SCHEDULAR_POLICIES(INSTANTIATE_SCHEDULAR)
@@ -9,14 +9,20 @@
  * usage, and failure rates, enabling comprehensive simulation and analysis of the scheduling process.
  *
  * Internally, it manages separate queues and priority queues for patients and resources,
- * including early and late patient lists, waiting lists for various treatment types,
- * devices undergoing maintenance, and currently active treatments. Utility functions
+ * including early and late patient lists, one lane per treatment type (free devices,
+ * devices undergoing maintenance and the waiting list), and currently active treatments.
+ * E, U and X are always lanes 0 to 2, the input file may declare more (TreatmentLane.h). Utility functions
  * support the simulation time advancement and rescheduling logic.
  *
  * The class exposes a wide range of accessor and utility functions for external interaction,
  * including adding patients and resources, querying simulation status, and retrieving
  * detailed statistics for output.
  *
+ * BasicSchedular takes its priority queues, waiting lists, random source, instrumentation and
+ * constants from a compile-time policy (SchedularPolicy.h), so container and generator
+ * alternatives are built side by side from the same code. Schedular is the default policy
+ * and the only one the programs use, the benchmarks compare the others against it.
+ *
  * @authors Abdelrahman Samir & Ibrahim Mohsen
  * @date May 2025
  */
@@ -25,12 +31,18 @@
 
 // Lists
 #include "TreatmentList.h"
+#include "ArrivalList.h"
+#include "PatientRegistry.h"
+#include "StatusIndex.h"
 #include "ArrayStack.h"
 #include "EarlyPlist.h"
 #include "X_WaitList.h"
+#include "TreatmentLane.h"
 
 // Resources
+#include "ResourcePool.h"
 #include "Resource.h"
+#include "Device.h"
 #include "Edevice.h"
 #include "Udevice.h"
 #include "GymRoom.h"
@@ -44,38 +56,51 @@
 // Patient
 #include "Patient.h"
 
+#include "SchedularPolicy.h"
+#include "EventLog.h"
+
+class PatientStream;
+class OutputSink;
+class Telemetry;
+
 /**
- * @class Schedular
+ * @class BasicSchedular
  * @brief Main scheduling system responsible for managing patient flow, resource allocation,
  * treatment execution, rescheduling, cancellations, and simulation statistics.
+ * @tparam Policy Types and constants of this schedular (SchedularPolicy.h).
  */
-class Schedular
+template <class Policy>
+class BasicSchedular
 {
-private:
-    // ===================== Resource & Patient Structures =====================
+public:
+    // ===================== Policy Types =====================
 
-    LinkedQueue<Patient*> history;                   ///< Queue for patient history (processed patients)
-    LinkedQueue<Patient*> ALL_patients;              ///< Queue of all patients
-    LinkedQueue<Resource*> E_Devices;                ///< Queue of E devices
-    LinkedQueue<Resource*> U_Devices;                ///< Queue of U devices
-    LinkedQueue<Resource*> X_Devices;                ///< Queue of X rooms
+    template <typename T>
+    using PriorityQueue = typename Policy::template PriorityQueue<T>;  ///< Priority queue of the lists below
+    typedef typename Policy::Random Random;                             ///< Random source
+    typedef typename Policy::Instrumentation Instrumentation;           ///< Phase timing
+    typedef BasicTreatmentLane<Policy> TreatmentLane;                   ///< Lane holding the policy's queues
 
-    int NumEdevices;                                 ///< Number of E devices
-    int NumUdevices;                                 ///< Number of U devices
-    int NumXdevices;                                 ///< Number of X rooms
+private:
+    // ===================== Resource & Patient Structures =====================
 
-    priQueue<Resource*> MaintenanceE;                ///< Maintenance queue for E devices
-    priQueue<Resource*> MaintenanceU;                ///< Maintenance queue for U devices
+    SimulationArena ownArena;                        ///< Memory of the patients, treatments and resources (unless a shared arena is set)
+    SimulationArena* arena;                          ///< Arena the objects of this simulation are created in
+    ResourcePool resources;                          ///< Storage, handles and ids of the resources of this simulation
 
-    EarlyPlist EARLY_patients;                       ///< Priority list for early patients
-    priQueue<Patient*> LATE_patients;                ///< Priority queue for late patients
+    PatientRegistry registry;                        ///< Status, list and transition summary of every patient, by PID
+    StatusIndex byStatus;                            ///< Patients held by status and type, kept by Patient::setStatus
+    ArrivalList ALL_patients;                        ///< Patients not arrived yet, by arrival time
+    TreatmentLane lanes[MAX_LANES];                  ///< Devices, maintenance and waiting list of each treatment type, by TreatmentType
+    int laneCount;                                   ///< Lanes in use (E, U, X and the declared ones)
+    AllocationOrder allocationOrder;                 ///< Which free device or room of a lane is taken first
+    RoomFit roomFit;                                 ///< Which room with a free slot a patient is given
 
-    EU_WaitList Ewaiting;                            ///< Waiting list for E treatments
-    EU_WaitList Uwaiting;                            ///< Waiting list for U treatments
-    X_WaitList Xwaiting;                             ///< Waiting list for X treatments
+    BasicEarlyPlist<Policy> EARLY_patients;          ///< Priority list for early patients
+    PriorityQueue<Patient*> LATE_patients;           ///< Priority queue for late patients
 
-    priQueue<Patient*> interruptedPatients;          ///< Priority queue for interrupted patients
-    TreatmentList inTreatment;                       ///< Queue of patients currently undergoing treatment
+    PriorityQueue<Patient*> interruptedPatients;     ///< Priority queue for interrupted patients
+    BasicTreatmentList<Policy> inTreatment;          ///< Queue of patients currently undergoing treatment
     ArrayStack<Patient*> Finished_patients;          ///< Stack of completed patients
 
     // ===================== Simulation Time and Logic =====================
@@ -90,6 +115,14 @@ private:
     int pFreeFailure;                                ///< Probability of free resource failure
     int pBusyFailure;                                ///< Probability of busy resource failure
 
+    Random rng;                                      ///< Random source of this simulation (failures, cancellation, rescheduling)
+
+    PatientStream* patientStream;                    ///< Streamed input feeding the all list while the simulation runs (nullptr if fully loaded)
+    OutputSink* outputSink;                          ///< Receives every patient when they finish (nullptr if none)
+    bool reclaimFinished;                            ///< Delete finished patients once the sink has them instead of keeping them
+    Telemetry* telemetry;                            ///< Samples the list counts after every time step (nullptr if none)
+    EventLog* eventLog;                              ///< Receives every patient and device transition (nullptr if none)
+
     // ===================== Simulation Statistics =====================
 
     int TotalTimeSteps;
@@ -99,10 +132,13 @@ private:
     int TotalEarly;
     int TotalLate;
     int TotalLatePenalty;
-    int TotalFreeFail_E;
-    int TotalFreeFail_U;
-    int TotalBusyFail_E;
-    int TotalBusyFail_U;
+
+    // running totals over the finished patients, kept as they finish
+    int FinishedCount;
+    long long TotalWait, TotalWait_N, TotalWait_R;
+    long long TotalTreatment, TotalTreatment_N, TotalTreatment_R;
+    int TotalCancelled;
+    int TotalReschduled;
 
     double AvgWaitTime_all, AvgWaitTime_N, AvgWaitTime_R;
     double AvgTreatmentTime_all, AvgTreatmentTime_N, AvgTreatmentTime_R;
@@ -125,6 +161,13 @@ private:
      */
     Resource* ReadyResource(Treatment* required_treatment);
 
+    // ===================== Per Lane Paths (TreatmentTraits.h) =====================
+
+    template <LaneKind K> Resource* ReadyResource(TreatmentLane& lane, bool WasInterrupted); ///< Free resource of the lane if nobody waits for it (may free fail one)
+    template <LaneKind K> void WaitToTreatment(TreatmentLane& lane);                        ///< Serve the waiting list of the lane while it has resources
+    void CheckMaintainance(TreatmentLane& lane);                                            ///< Return the repaired devices of a device lane
+    void BusyFailure(TreatmentLane& lane, Patient* patient, Resource* resource);            ///< Send the failed device to the maintenance of its lane
+
     /**
      * @brief Adjusts treatment queue for recovering patients.
      * @param rec Pointer to the recovering patient.
@@ -139,9 +182,17 @@ private:
 
     /**
      * @brief Handles failure of busy resources and processes any required logic.
-     * @return Resource type that failed.
+     * @return True if a device failed.
+     */
+    bool _handle_busy_failure();
+
+    /**
+     * @brief Appends a transition to the event log, if one is attached.
+     * @param type Transition.
+     * @param patient Patient concerned (nullptr for device events).
+     * @param resource Resource concerned (nullptr if none).
      */
-    ResType _handle_busy_failure();
+    void LogEvent(EventType type, const Patient* patient, const Resource* resource = nullptr);
 
     /**
      * @brief Computes final simulation statistics.
@@ -173,7 +224,7 @@ private:
 
 public:
     /** @brief Default constructor. */
-    Schedular();
+    BasicSchedular();
 
     // ===================== Time and Parameter Setup =====================
 
@@ -184,13 +235,93 @@ public:
     void setpResch(int p_resch);                ///< Set rescheduling chance
     void setpFreeFail(int pFF);                 ///< Set free device failure chance
     void setpBusyFail(int pBF);                 ///< Set busy device failure chance
+    void setSeed(unsigned long long seed);      ///< Restart the random sequence of this simulation
+
+    Random& getRandomGenerator();               ///< Random source shared by the lists and devices of this simulation
+
+    /**
+     * @brief Creates the objects of this simulation in a shared arena instead of its own.
+     * Call before anything is loaded. The arena must outlive the schedular, and may be Reset
+     * for the next run once the schedular is destroyed (replication workers reuse its memory).
+     * @param shared Arena to use, nullptr for the schedular's own arena.
+     */
+    void setArena(SimulationArena* shared);
+
+    /** @brief Arena new patients are created in ("new (getArena()) Patient(...)"), resources come from CreateResource. */
+    SimulationArena& getArena();
 
     // ===================== Initialization Functions =====================
 
     void AddToAllList(Patient* myPatient);      ///< Add a patient to the master list
-    void AddResource(Resource* resource);       ///< Register a resource into the appropriate list
+    void AddResource(Resource* resource);       ///< Register a resource into the list of its lane
+
+    /**
+     * @brief Creates a resource in the pool of this simulation and adds it to its lane.
+     * @tparam T Edevice, Udevice, GymRoom or Device.
+     * @param args Constructor arguments.
+     * @return The resource, numbered in this simulation.
+     */
+    template <class T, class... Args>
+    T* CreateResource(Args&&... args)
+    {
+        T* resource = resources.template Create<T>(std::forward<Args>(args)...);
+        AddResource(resource);
+        return resource;
+    }
+
+    const ResourcePool& getResourcePool() const; ///< Every resource of the simulation, by handle
     void UpdateNumberResources();               ///< Recalculate the total number of devices/rooms
 
+    /**
+     * @brief Adds a treatment type served by its own devices or rooms, after E, U and X.
+     * @param code Letter of the treatment in the input file.
+     * @param kind Devices (can fail) or rooms (several patients each).
+     * @return The new lane, DUMMY_THERAPY if the code is taken or MAX_LANES are in use.
+     */
+    TreatmentType DeclareLane(char code, LaneKind kind);
+
+    /**
+     * @brief Selects which free device or room of every lane is taken first.
+     * ALLOC_FIFO (the default) keeps the results of earlier versions.
+     */
+    void setAllocationOrder(AllocationOrder order);
+    AllocationOrder getAllocationOrder() const;
+
+    /**
+     * @brief Self-check of the free devices and rooms of every lane. The set of a device lane
+     * holds exactly the devices neither treating a patient nor under maintenance, all of them
+     * working. A room holds the patients treated in it, never more than its capacity, and is
+     * listed while it has a free slot. The counts match, and the resource handed out next is
+     * the one the room fit promises (fewest or most free slots, most patients) or else the
+     * allocation order (lowest id, or fewest sessions then lowest id).
+     * Walks every resource, meant for tests and checked benchmark runs.
+     * @return false (one error printed per violation) if a lane is inconsistent.
+     */
+    bool CheckAllocation() const;
+
+    /**
+     * @brief Selects which room with a free slot a patient of a room lane is given (RoomIndex.h).
+     * ROOM_FIRST_FREE (the default) takes the rooms in the allocation order.
+     */
+    void setRoomFit(RoomFit fit);
+    RoomFit getRoomFit() const;
+
+    TreatmentType getLane(char code) const;     ///< Lane of a treatment letter, DUMMY_THERAPY if none
+    int getLaneCount() const;                   ///< Lanes in use, built-in ones included
+    char getLaneCode(TreatmentType lane) const; ///< Letter of a lane
+    void setPatientStream(PatientStream* stream); ///< Read arrivals from a stream as time advances (the stream must outlive the run)
+
+    /**
+     * @brief Hands every patient to the sink as soon as they finish.
+     * @param sink Receiver of the finished patients (must outlive the run).
+     * @param reclaim If true, finished patients are deleted right after the sink and only their
+     *        registry entry is kept, so memory follows the active patients only.
+     */
+    void setOutputSink(OutputSink* sink, bool reclaim = true);
+
+    void setTelemetry(Telemetry* recorder);     ///< Sample the list counts at the end of every SimulateTimeStep (nullptr to stop)
+    void setEventLog(EventLog* log);            ///< Append every transition to an open log (nullptr to stop)
+
     // ===================== Core Simulation Logic =====================
 
     void CheckAllPatientList();                 ///< Move patients from all list to early/late
@@ -200,16 +331,12 @@ public:
     void LateToWait();                          ///< Transfer late patients to waiting lists
     void WaitToTreatment();                     ///< Assign waiting patients to free devices
     void MoveToNextTreatment();                 ///< Complete current treatment and process next
+    void SimulateTimeStep();                    ///< Run all the above phases once, in simulation order
 
     // ===================== Waitlist Management =====================
 
-    bool addToEWait(Patient* patient);          ///< Queue patient in E waiting list
-    bool addToUWait(Patient* patient);          ///< Queue patient in U waiting list
-    bool addToXWait(Patient* patient);          ///< Queue patient in X waiting list
-
-    bool CanAssignE() const;                    ///< Check if an E device is available
-    bool CanAssignU() const;                    ///< Check if a U device is available
-    bool CanAssignX() const;                    ///< Check if a X room is available
+    bool addToWait(TreatmentType lane, Patient* patient);   ///< Queue patient in the waiting list of a lane
+    bool CanAssign(TreatmentType lane) const;               ///< Check if a device or room of a lane is available
 
     // ===================== Treatment & Completion =====================
 
@@ -224,9 +351,11 @@ public:
     void printEWait() const;
     void printUWait() const;
     void printXWait() const;
+    void printWait(TreatmentType lane) const;
     void printInTreatment() const;
     void printInterruptedList() const;
     void printMaintainance() const;
+    void printUtilization(ostream& os) const;   ///< Per device and per type usage up to the current time
 
     // ===================== Accessors =====================
 
@@ -237,6 +366,7 @@ public:
     int getEWaitCount() const;
     int getUWaitCount() const;
     int getXWaitCount() const;
+    int getWaitCount(TreatmentType lane) const;
     int getInTreatmentCount() const;
     int getInterruptedCount() const;
     bool isThereMaintainance() const;
@@ -251,6 +381,7 @@ public:
     int getTotal_R_Patient() const;
     int getTotal_BusyFail_E() const;
     int getTotal_BusyFail_U() const;
+    int getTotal_BusyFail(TreatmentType lane) const;
 
     double get_AvgWait() const;
     double get_AvgWait_N() const;
@@ -274,12 +405,24 @@ public:
 
     // ===================== Output File Access =====================
 
-    LinkedQueue<Patient*> getHistory() const;                   ///< Get history of processed patients
-    priQueue<Resource*> getE_MaintainanceList() const;          ///< Get E device maintenance queue
-    priQueue<Resource*> getU_MaintainanceList() const;          ///< Get U device maintenance queue
+    const PatientRegistry& getRegistry() const;                 ///< Every patient so far by PID, with their transition summary
+    const PatientEntry* findPatient(int PID) const;             ///< Status, list and next event time of a patient, nullptr if unknown
+    const StatusIndex& getStatusIndex() const;                  ///< Counts and lists of the patients held, by status and type
+    PriorityQueue<Resource*> getE_MaintainanceList() const;     ///< Get E device maintenance queue
+    PriorityQueue<Resource*> getU_MaintainanceList() const;     ///< Get U device maintenance queue
     ArrayStack<Patient*> getFinishedPatients() const;           ///< Stack of completed patients
+    int getFinishedCount() const;                               ///< Number of completed patients kept on the finished stack
+    int getTotalFinished() const;                               ///< Number of completed patients, reclaimed ones included
+    Patient* getFinishedPatient(int index) const;               ///< Completed patient by finishing order (0 = first), no copy
     LinkedQueue<Patient*> getAllPatientList() const;            ///< Original list of all patients
 
-    /** @brief Destructor. */
-    ~Schedular();
+    /**
+     * @brief Destroys the patients still held, finished ones included, then the memory of every
+     * patient and resource goes with the arena at once. This walks every list, O(patients).
+     */
+    ~BasicSchedular();
+
+    /** @brief Checkpoint saves and restores the complete simulation state. */
+    friend class Checkpoint;
+    friend class Telemetry;                     ///< Samples the list counts without a call per count
 };
@@ -0,0 +1,19 @@
+/**
+ * @file SchedularFwd.h
+ * @brief Forward declaration of the schedular template and of its default instantiation.
+ *
+ * Headers that only pass a schedular by reference include this instead of Schedular.h.
+ * Schedular is BasicSchedular<DefaultSchedularPolicy> (SchedularPolicy.h).
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+
+struct DefaultSchedularPolicy;
+
+template <class Policy>
+class BasicSchedular;
+
+/** @brief The schedular of the programs, every other instantiation is for the benchmarks. */
+typedef BasicSchedular<DefaultSchedularPolicy> Schedular;
@@ -0,0 +1,87 @@
+/**
+ * @file SchedularPolicy.h
+ * @brief Compile-time bundles of the types and constants a BasicSchedular is built from.
+ *
+ * A policy supplies:
+ * - PriorityQueue<T>: the priority queue of the in-treatment, early, late, interrupted and
+ *   maintenance lists (EarlyPlist and TreatmentList derive from it),
+ * - WaitList: the waiting list of every lane,
+ * - Random: the random source (failures, cancellation, rescheduling, generated patients),
+ * - Instrumentation: the PhaseProfiler timing the phases and the random list operations,
+ * - the maintenance and generation constants that used to be macros.
+ *
+ * Policies derive from DefaultSchedularPolicy and replace one member, so every variant
+ * differs from the default in a single choice. Templates parameterised on the policy keep
+ * their definitions in their .cpp file and are instantiated there for each entry of
+ * SCHEDULAR_POLICIES, so adding a policy means adding it to that list.
+ *
+ * Checkpoint, UI, Output, ResultWriter and CapacityOptimizer only work on the default
+ * Schedular (SchedularFwd.h).
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include "priQueue.h"
+#include "HeapPriQueue.h"
+#include "X_WaitList.h"
+#include "RandomGenerator.h"
+#include "MersenneGenerator.h"
+#include "Profiler.h"
+#include "SchedularFwd.h"
+
+/**
+ * @struct DefaultSchedularPolicy
+ * @brief Sorted linked lists, xorshift128+ and the Profiler of the build.
+ */
+struct DefaultSchedularPolicy
+{
+    template <typename T>
+    using PriorityQueue = priQueue<T>;                      ///< Sorted linked list, O(n) insertion
+    typedef X_WaitList WaitList;                            ///< Linked list sorted on insertion, with cancellation
+    typedef RandomGenerator Random;                         ///< xorshift128+, its state fits a checkpoint
+    typedef Profiler Instrumentation;                       ///< Empty unless PHASE_PROFILING is 1
+
+    static constexpr int maintainanceDuration = 6;          ///< A failed device is repaired after 1 to this many time steps
+    static constexpr int maintainanceCooldown = 3;          ///< Free failure checks a device survives after a failure
+    static constexpr int newPatientPTRange = 5;             ///< Appointment of a generated patient, within this many steps
+    static constexpr int newPatientVTRange = 5;             ///< Arrival of a generated patient, within this many steps
+    static constexpr int newTreatmentDurationRange = 5;     ///< Durations of a generated patient's treatments are below this
+    static constexpr int reschedulePTRange = 12;            ///< New appointment of a rescheduled patient, after the last arrival
+    static constexpr int rescheduleVTRange = 10;            ///< New arrival of a rescheduled patient, after the last arrival
+};
+
+/**
+ * @struct HeapSchedularPolicy
+ * @brief Binary heaps instead of sorted lists, same order and therefore the same results.
+ */
+struct HeapSchedularPolicy : DefaultSchedularPolicy
+{
+    template <typename T>
+    using PriorityQueue = HeapPriQueue<T>;
+};
+
+/**
+ * @struct MersenneSchedularPolicy
+ * @brief std::mt19937_64 instead of xorshift128+, a different but equally seeded run.
+ */
+struct MersenneSchedularPolicy : DefaultSchedularPolicy
+{
+    typedef MersenneGenerator Random;
+};
+
+/**
+ * @struct ProfiledSchedularPolicy
+ * @brief Phase timing on whatever PHASE_PROFILING is, to measure the profiler overhead.
+ */
+struct ProfiledSchedularPolicy : DefaultSchedularPolicy
+{
+    typedef PhaseProfiler<true> Instrumentation;
+};
+
+// every policy a schedular is built for, X(Policy) once each
+#define SCHEDULAR_POLICIES(X) \
+    X(DefaultSchedularPolicy) \
+    X(HeapSchedularPolicy) \
+    X(MersenneSchedularPolicy) \
+    X(ProfiledSchedularPolicy)
@@ -0,0 +1,120 @@
+#include "SimulationArena.h"
+#include <new>
+
+//every object starts after a header holding its arena (nullptr for the heap)
+#define ARENA_HEADER sizeof(SimulationArena*)
+
+SimulationArena::SimulationArena(size_t chunkSize) : current(0), offset(0), usedBytes(0), chunkBytes(chunkSize)
+{
+	for (void*& list : freeLists)
+		list = nullptr;
+}
+
+SimulationArena::~SimulationArena() { Release(); }
+
+void* SimulationArena::Allocate(size_t size)
+{
+	size = (size + 7) & ~(size_t)7;
+	size_t sizeClass = size / 8 - 1;
+
+	// 1) reuse a block of the same size
+	if (sizeClass < ARENA_SIZE_CLASSES && freeLists[sizeClass])
+	{
+		void* block = freeLists[sizeClass];
+		freeLists[sizeClass] = *static_cast<void**>(block);
+		return block;
+	}
+
+	// 2) bump, moving to the next chunk (kept from an earlier run, or new) when this one is full
+	while (current < chunks.size() && offset + size > chunkSizes[current])
+	{
+		current++;
+		offset = 0;
+	}
+	if (current == chunks.size())
+	{
+		size_t chunkSize = (size > chunkBytes) ? size : chunkBytes;
+		chunks.push_back(static_cast<char*>(::operator new(chunkSize)));
+		chunkSizes.push_back(chunkSize);
+		offset = 0;
+	}
+
+	void* block = chunks[current] + offset;
+	offset += size;
+	usedBytes += size;
+	return block;
+}
+
+void SimulationArena::Deallocate(void* block, size_t size)
+{
+	size = (size + 7) & ~(size_t)7;
+	size_t sizeClass = size / 8 - 1;
+
+	//larger blocks are only given back by Reset
+	if (!block || sizeClass >= ARENA_SIZE_CLASSES)
+		return;
+
+	*static_cast<void**>(block) = freeLists[sizeClass];
+	freeLists[sizeClass] = block;
+}
+
+void SimulationArena::Reset()
+{
+	current = 0;
+	offset = 0;
+	usedBytes = 0;
+	for (void*& list : freeLists)
+		list = nullptr;
+}
+
+void SimulationArena::Release()
+{
+	for (char* chunk : chunks)
+		::operator delete(chunk);
+	chunks.clear();
+	chunkSizes.clear();
+	Reset();
+}
+
+size_t SimulationArena::getReservedBytes() const
+{
+	size_t total = 0;
+	for (size_t chunkSize : chunkSizes)
+		total += chunkSize;
+	return total;
+}
+
+size_t SimulationArena::getUsedBytes() const { return usedBytes; }
+
+//----------------------------------------------------------------------------------
+// ARENA OBJECTS
+//----------------------------------------------------------------------------------
+
+void* ArenaObject::operator new(size_t size)
+{
+	char* block = static_cast<char*>(::operator new(size + ARENA_HEADER));
+	*reinterpret_cast<SimulationArena**>(block) = nullptr;
+	return block + ARENA_HEADER;
+}
+
+void* ArenaObject::operator new(size_t size, SimulationArena& arena)
+{
+	char* block = static_cast<char*>(arena.Allocate(size + ARENA_HEADER));
+	*reinterpret_cast<SimulationArena**>(block) = &arena;
+	return block + ARENA_HEADER;
+}
+
+void ArenaObject::operator delete(void* object, size_t size)
+{
+	if (!object)
+		return;
+
+	char* block = static_cast<char*>(object) - ARENA_HEADER;
+	SimulationArena* arena = *reinterpret_cast<SimulationArena**>(block);
+	if (arena)
+		arena->Deallocate(block, size + ARENA_HEADER);
+	else
+		::operator delete(block);
+}
+
+void ArenaObject::operator delete(void*, SimulationArena&) {}
@@ -0,0 +1,91 @@
+/**
+ * @file SimulationArena.h
+ * @brief Per-simulation memory arena owning the patients and resources of a run.
+ *
+ * A SimulationArena hands out memory from large chunks with a bump pointer, so the objects of
+ * one simulation sit next to each other and are given back all at once: Reset rewinds the
+ * chunks for the next run without returning them to the system, and the destructor frees them.
+ * Objects deleted during the run (finished patients when reclaiming) go to a free list of
+ * their size and are reused by the next allocation of that size, so a streamed run stays
+ * bounded by its active patients.
+ *
+ * Patient and Resource derive from ArenaObject, which places them in an arena with
+ * "new (arena) T(...)"; treatments are stored inline in their patient. A plain "new T(...)" still uses the heap. Every object remembers where
+ * it came from in a one pointer header, so "delete" works the same for both.
+ *
+ * An arena belongs to one thread at a time and is not locked.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+#define ARENA_CHUNK_SIZE (1 << 20)      // bytes per chunk, unless the arena is given another size
+#define ARENA_SIZE_CLASSES 64           // sizes 8, 16, ... 512 bytes are recycled
+
+/**
+ * @class SimulationArena
+ * @brief Chunked bump allocator with per size free lists.
+ */
+class SimulationArena
+{
+private:
+    vector<char*> chunks;                   ///< Chunks reserved so far (kept across Reset)
+    vector<size_t> chunkSizes;              ///< Size of every chunk
+    size_t current;                         ///< Chunk the bump pointer is in
+    size_t offset;                          ///< Bytes used in the current chunk
+    size_t usedBytes;                       ///< Bytes handed out since the last Reset
+    size_t chunkBytes;                      ///< Size of a new chunk
+    void* freeLists[ARENA_SIZE_CLASSES];    ///< Deallocated blocks by size, linked through their first word
+
+public:
+    /** @param chunkSize Size of a new chunk, smaller for an arena holding few objects. */
+    explicit SimulationArena(size_t chunkSize = ARENA_CHUNK_SIZE);
+
+    /** @brief Frees every chunk. */
+    ~SimulationArena();
+
+    SimulationArena(const SimulationArena&) = delete;
+    SimulationArena& operator=(const SimulationArena&) = delete;
+
+    /** @brief Returns size bytes aligned on 8, from the free list of that size or the current chunk. */
+    void* Allocate(size_t size);
+
+    /** @brief Puts a block back on the free list of its size (the memory stays in the arena). */
+    void Deallocate(void* block, size_t size);
+
+    /**
+     * @brief Forgets every allocation in O(1), keeping the chunks for the next run.
+     * Objects still in the arena are not destroyed, nothing may use them afterwards.
+     */
+    void Reset();
+
+    /** @brief Frees every chunk. */
+    void Release();
+
+    size_t getReservedBytes() const;        ///< Bytes held in chunks
+    size_t getUsedBytes() const;            ///< Bytes handed out since the last Reset
+};
+
+/**
+ * @class ArenaObject
+ * @brief Base of the classes a simulation allocates, routes new/delete to an arena or the heap.
+ */
+class ArenaObject
+{
+public:
+    /** @brief Heap allocation ("new T(...)"). */
+    static void* operator new(size_t size);
+
+    /** @brief Arena allocation ("new (arena) T(...)"). */
+    static void* operator new(size_t size, SimulationArena& arena);
+
+    /** @brief Gives the memory back to the arena or the heap it came from. */
+    static void operator delete(void* object, size_t size);
+
+    /** @brief Called if a constructor throws, the block stays in the arena until Reset. */
+    static void operator delete(void* object, SimulationArena& arena);
+};
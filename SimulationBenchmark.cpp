@@ -0,0 +1,405 @@
+#include "SimulationBenchmark.h"
+#include "Schedular.h"
+#include "Checkpoint.h"
+#include "Load.h"
+#include "OutputSink.h"
+#include "WorkloadGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+const char* SimulationBenchmark::PhaseNames[SIM_PHASES] =
+{
+	"CheckMaintainanceList",
+	"MoveToNextTreatment",
+	"CheckAllPatientList",
+	"CheckInterrupted",
+	"EarlyToWait",
+	"LateToWait",
+	"WaitToTreatment",
+	"SimulationEnded"
+};
+
+//finished patients are deleted right away, so the memory of a scenario follows its active patients
+class DiscardSink : public OutputSink
+{
+public:
+	void PatientFinished(const Patient*) override {}
+};
+
+SimulationBenchmark::SimulationBenchmark()
+{
+	//same devices and arrival rate for every size, only the length of the run grows
+	scenarios.push_back({ "1k", 1000, 5, 5, 3, 11 });
+	scenarios.push_back({ "10k", 10000, 5, 5, 3, 12 });
+	scenarios.push_back({ "100k", 100000, 5, 5, 3, 13 });
+	scenarios.push_back({ "1m", 1000000, 5, 5, 3, 14 });
+
+	//the default keeps the bare scenario names, so older result files stay usable as baselines
+	variants.push_back({ "", &RunScenario<DefaultSchedularPolicy>, ALLOC_FIFO, ROOM_FIRST_FREE, false, false });
+	variants.push_back({ "heap", &RunScenario<HeapSchedularPolicy>, ALLOC_FIFO, ROOM_FIRST_FREE, false, false });
+	variants.push_back({ "mt", &RunScenario<MersenneSchedularPolicy>, ALLOC_FIFO, ROOM_FIRST_FREE, false, false });
+	variants.push_back({ "profiled", &RunScenario<ProfiledSchedularPolicy>, ALLOC_FIFO, ROOM_FIRST_FREE, false, false });
+
+	//the other allocation orders and room fits, checked after every time step
+	variants.push_back({ "lowest-id", &RunScenario<DefaultSchedularPolicy>, ALLOC_LOWEST_ID, ROOM_FIRST_FREE, true, false });
+	variants.push_back({ "least-used", &RunScenario<DefaultSchedularPolicy>, ALLOC_LEAST_USED, ROOM_FIRST_FREE, true, false });
+	variants.push_back({ "best-fit", &RunScenario<DefaultSchedularPolicy>, ALLOC_FIFO, ROOM_BEST_FIT, true, false });
+	variants.push_back({ "worst-fit", &RunScenario<DefaultSchedularPolicy>, ALLOC_FIFO, ROOM_WORST_FIT, true, false });
+	variants.push_back({ "consolidate", &RunScenario<DefaultSchedularPolicy>, ALLOC_FIFO, ROOM_CONSOLIDATE, true, false });
+
+	//a run saved half way and resumed ends the same
+	variants.push_back({ "checkpoint", &RunScenario<DefaultSchedularPolicy>, ALLOC_FIFO, ROOM_FIRST_FREE, false, true });
+}
+
+void SimulationBenchmark::setLargestScenario(int patients)
+{
+	vector<BenchmarkScenario> kept;
+	for (const BenchmarkScenario& scenario : scenarios)
+	{
+		if (scenario.patients <= patients)
+			kept.push_back(scenario);
+	}
+	scenarios = kept;
+}
+
+bool SimulationBenchmark::setVariant(const string& name)
+{
+	for (const BenchmarkVariant& variant : variants)
+	{
+		if (variant.name == name || (variant.name.empty() && name == "default"))
+		{
+			variants = { variant };
+			return true;
+		}
+	}
+
+	cout << "Error: Unknown schedular variant " << name << endl;
+	return false;
+}
+
+const vector<ScenarioResult>& SimulationBenchmark::getResults() const { return results; }
+
+bool SimulationBenchmark::ChecksPassed() const
+{
+	for (const ScenarioResult& result : results)
+	{
+		if (result.checkFailures)
+			return false;
+	}
+	return true;
+}
+
+long long SimulationBenchmark::PeakRssKB()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return (long long)(counters.PeakWorkingSetSize / 1024);
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024;     //bytes on macOS
+#else
+	return usage.ru_maxrss;            //KB on Linux
+#endif
+#endif
+}
+
+//only a Schedular is checkpointed, the other policies are never resumed
+template <class Policy>
+static void SaveSnapshot(const BasicSchedular<Policy>&, vector<char>&) {}
+
+static void SaveSnapshot(const Schedular& hospitalSystem, vector<char>& snapshot)
+{
+	Checkpoint::SaveToBuffer(hospitalSystem, snapshot);
+}
+
+template <class Policy>
+static bool ResumesTheSame(BasicSchedular<Policy>&, const vector<char>&) { return true; }
+
+//resumes a snapshot to its end and compares it with the run that went on uninterrupted
+static bool ResumesTheSame(Schedular& finished, const vector<char>& snapshot)
+{
+	Schedular resumed;
+	DiscardSink sink;
+	resumed.setOutputSink(&sink);
+	if (!Checkpoint::RestoreFromBuffer(resumed, snapshot))
+		return false;
+
+	while (!resumed.SimulationEnded())
+	{
+		resumed.SimulateTimeStep();
+		resumed.IncrementTime();
+	}
+
+	bool same = resumed.getCurrentTime() == finished.getCurrentTime()
+		&& resumed.getTotalFinished() == finished.getTotalFinished()
+		&& resumed.get_AvgWait() == finished.get_AvgWait()
+		&& resumed.get_AvgTimeTreatment() == finished.get_AvgTimeTreatment()
+		&& resumed.get_Avg_Late_Penalty() == finished.get_Avg_Late_Penalty()
+		&& resumed.get_Perc_Accepted_Cancel() == finished.get_Perc_Accepted_Cancel()
+		&& resumed.get_Perc_Accepted_Resch() == finished.get_Perc_Accepted_Resch();
+	if (!same)
+		cout << "Error: the run resumed from its checkpoint ended at " << resumed.getCurrentTime()
+			<< " instead of " << finished.getCurrentTime() << " or with other statistics" << endl;
+	return same;
+}
+
+template <class Policy>
+ScenarioResult SimulationBenchmark::RunScenario(const BenchmarkScenario& scenario, const BenchmarkVariant& variant)
+{
+	ScenarioResult result = {};
+	result.name = scenario.name;
+	result.patients = scenario.patients;
+
+	// 1) generate and load the input
+	auto start = chrono::steady_clock::now();
+
+	string fileName = "sim_bench_" + scenario.name;
+	WorkloadGenerator generator;
+	generator.setPatients(scenario.patients, 50);
+	generator.setDevices(scenario.numE, scenario.numU, scenario.numX, 4, 6);
+	generator.setSeed(scenario.seed);
+	if (!generator.Generate(fileName))
+		return result;
+
+	BasicSchedular<Policy> hospitalSystem;
+	hospitalSystem.setSeed(scenario.seed);
+	hospitalSystem.setAllocationOrder(variant.order);
+	hospitalSystem.setRoomFit(variant.fit);
+	DiscardSink sink;
+	hospitalSystem.setOutputSink(&sink);
+
+	Load loader(fileName);
+	loader.LoadDataFromMappedFile(hospitalSystem);
+	remove((fileName + ".txt").c_str());
+
+	result.loadSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	// 2) the main loop, headless, every phase timed on its own
+	typedef void (BasicSchedular<Policy>::*Phase)();
+	static const Phase phases[SIM_PHASES - 1] =
+	{
+		&BasicSchedular<Policy>::CheckMaintainanceList,
+		&BasicSchedular<Policy>::MoveToNextTreatment,
+		&BasicSchedular<Policy>::CheckAllPatientList,
+		&BasicSchedular<Policy>::CheckInterrupted,
+		&BasicSchedular<Policy>::EarlyToWait,
+		&BasicSchedular<Policy>::LateToWait,
+		&BasicSchedular<Policy>::WaitToTreatment
+	};
+
+	//the checkpoint is taken half way, the arrivals of a scenario span about one tick per patient
+	vector<char> snapshot;
+	int checkpointTime = scenario.patients / 2;
+
+	while (true)
+	{
+		if (variant.resumed && hospitalSystem.getCurrentTime() == checkpointTime)
+			SaveSnapshot(hospitalSystem, snapshot);
+
+		auto before = chrono::steady_clock::now();
+		bool ended = hospitalSystem.SimulationEnded();
+		auto after = chrono::steady_clock::now();
+		result.phaseSeconds[SIM_PHASES - 1] += chrono::duration<double>(after - before).count();
+		if (ended)
+			break;
+
+		for (int i = 0; i < SIM_PHASES - 1; i++)
+		{
+			before = after;
+			(hospitalSystem.*phases[i])();
+			after = chrono::steady_clock::now();
+			result.phaseSeconds[i] += chrono::duration<double>(after - before).count();
+		}
+
+		//untimed, the next phase is timed from a new start
+		if (variant.checked && !hospitalSystem.CheckAllocation())
+			result.checkFailures++;
+
+		hospitalSystem.IncrementTime();
+	}
+
+	for (int i = 0; i < SIM_PHASES; i++)
+		result.seconds += result.phaseSeconds[i];
+
+	result.ticks = hospitalSystem.getCurrentTime();
+	result.ticksPerSecond = (result.seconds > 0) ? result.ticks / result.seconds : 0;
+	result.patientsPerSecond = (result.seconds > 0) ? result.patients / result.seconds : 0;
+	result.peakRssKB = PeakRssKB();
+
+	//after the measurements, the resumed run is not part of them
+	if (variant.resumed && (snapshot.empty() || !ResumesTheSame(hospitalSystem, snapshot)))
+		result.checkFailures++;
+	return result;
+}
+
+void SimulationBenchmark::Run()
+{
+	results.clear();
+	for (const BenchmarkScenario& scenario : scenarios)
+	{
+		//every variant of a size before the next size, the peak memory stays in scenario order
+		for (const BenchmarkVariant& variant : variants)
+		{
+			ScenarioResult result = variant.run(scenario, variant);
+			if (!variant.name.empty())
+				result.name += "/" + variant.name;
+			results.push_back(result);
+
+			cout << left << setw(14) << result.name
+				<< " patients = " << setw(8) << result.patients
+				<< " ticks = " << setw(8) << result.ticks
+				<< " ticks/s = " << setw(12) << result.ticksPerSecond
+				<< " patients/s = " << setw(12) << result.patientsPerSecond
+				<< " peak RSS = " << result.peakRssKB << " KB" << endl;
+			if (variant.checked && result.checkFailures)
+				cout << "       allocation check FAILED at " << result.checkFailures << " time steps" << endl;
+			else if (variant.checked)
+				cout << "       allocation check passed" << endl;
+			else if (variant.resumed)
+				cout << "       resumed from the checkpoint at tick " << result.patients / 2
+					<< (result.checkFailures ? ": FAILED" : ": same end") << endl;
+
+			for (int i = 0; i < SIM_PHASES; i++)
+			{
+				double share = (result.seconds > 0) ? 100 * result.phaseSeconds[i] / result.seconds : 0;
+				cout << "       " << left << setw(24) << PhaseNames[i]
+					<< setw(12) << result.phaseSeconds[i] << " s  (" << share << " %)" << endl;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------
+// BASELINES
+//----------------------------------------------------------------------------------
+
+bool SimulationBenchmark::ExportJson(const string& fileName) const
+{
+	ofstream outFile(fileName);
+	if (!outFile.is_open())
+	{
+		cout << "Error: Unable to create file " << fileName << endl;
+		return false;
+	}
+
+	//one scenario per line, ReadJson relies on it
+	outFile << setprecision(10) << "{\n  \"scenarios\": [\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const ScenarioResult& r = results[i];
+		outFile << "    { \"name\": \"" << r.name << "\", \"patients\": " << r.patients
+			<< ", \"ticks\": " << r.ticks << ", \"load_seconds\": " << r.loadSeconds
+			<< ", \"seconds\": " << r.seconds << ", \"ticks_per_second\": " << r.ticksPerSecond
+			<< ", \"patients_per_second\": " << r.patientsPerSecond
+			<< ", \"peak_rss_kb\": " << r.peakRssKB << ", \"check_failures\": " << r.checkFailures << ", \"phases\": { ";
+		for (int p = 0; p < SIM_PHASES; p++)
+			outFile << (p ? ", \"" : "\"") << PhaseNames[p] << "\": " << r.phaseSeconds[p];
+		outFile << " } }" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	outFile << "  ]\n}\n";
+
+	return (bool)outFile;
+}
+
+//value following "key": on a line, 0 if the key is missing
+static double FindNumber(const string& line, const string& key)
+{
+	size_t at = line.find("\"" + key + "\": ");
+	return (at == string::npos) ? 0 : strtod(line.c_str() + at + key.size() + 4, nullptr);
+}
+
+bool SimulationBenchmark::ReadJson(const string& fileName, vector<ScenarioResult>& baseline)
+{
+	ifstream inFile(fileName);
+	if (!inFile.is_open())
+	{
+		cout << "Error: Unable to open file " << fileName << endl;
+		return false;
+	}
+
+	baseline.clear();
+	string line;
+	while (getline(inFile, line))
+	{
+		size_t at = line.find("\"name\": \"");
+		if (at == string::npos)
+			continue;
+
+		ScenarioResult r = {};
+		at += 9;
+		r.name = line.substr(at, line.find('"', at) - at);
+		r.patients = (int)FindNumber(line, "patients");
+		r.ticks = (int)FindNumber(line, "ticks");
+		r.loadSeconds = FindNumber(line, "load_seconds");
+		r.seconds = FindNumber(line, "seconds");
+		r.ticksPerSecond = FindNumber(line, "ticks_per_second");
+		r.patientsPerSecond = FindNumber(line, "patients_per_second");
+		r.peakRssKB = (long long)FindNumber(line, "peak_rss_kb");
+		r.checkFailures = (int)FindNumber(line, "check_failures");
+		for (int p = 0; p < SIM_PHASES; p++)
+			r.phaseSeconds[p] = FindNumber(line, PhaseNames[p]);
+		baseline.push_back(r);
+	}
+	return true;
+}
+
+bool SimulationBenchmark::CompareWithBaseline(const vector<ScenarioResult>& baseline, double tolerance) const
+{
+	bool passed = true;
+	for (const ScenarioResult& current : results)
+	{
+		const ScenarioResult* base = nullptr;
+		for (const ScenarioResult& candidate : baseline)
+		{
+			if (candidate.name == current.name)
+				base = &candidate;
+		}
+		if (!base || base->ticksPerSecond <= 0)
+		{
+			cout << left << setw(14) << current.name << " no baseline" << endl;
+			continue;
+		}
+
+		double speed = current.ticksPerSecond / base->ticksPerSecond - 1;
+		bool slower = current.ticksPerSecond < base->ticksPerSecond * (1 - tolerance);
+		bool bigger = base->peakRssKB > 0 && current.peakRssKB > base->peakRssKB * (1 + tolerance);
+
+		cout << left << setw(14) << current.name << " ticks/s " << base->ticksPerSecond << " -> " << current.ticksPerSecond
+			<< " (" << showpos << 100 * speed << noshowpos << " %)"
+			<< ", peak RSS " << base->peakRssKB << " -> " << current.peakRssKB << " KB"
+			<< (slower || bigger ? "  REGRESSION" : "  ok") << endl;
+
+		//equal seeds replay the same run, the speed comparison is only fair if they still do
+		if (base->ticks != current.ticks)
+			cout << "       behaviour changed: " << base->ticks << " -> " << current.ticks << " ticks" << endl;
+
+		for (int p = 0; p < SIM_PHASES; p++)
+		{
+			if (base->phaseSeconds[p] > 0 && current.phaseSeconds[p] > base->phaseSeconds[p] * (1 + tolerance))
+				cout << "       " << left << setw(24) << PhaseNames[p] << base->phaseSeconds[p] << " -> " << current.phaseSeconds[p] << " s" << endl;
+		}
+
+		if (slower || bigger)
+			passed = false;
+	}
+	return passed;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file SimulationBenchmark.h
+ * @brief End-to-end simulation benchmark with regression checks against a stored baseline.
+ *
+ * Every scenario is a seeded WorkloadGenerator input of growing size. It is loaded, then
+ * simulated headless with the phases of the main loop (CheckMaintainanceList through
+ * WaitToTreatment, then SimulationEnded) timed one by one. A scenario reports ticks per
+ * second, patients per second, the time of every phase and the peak resident memory of the
+ * process once the scenario ended (scenarios run from the smallest to the largest).
+ *
+ * Every scenario runs once per schedular variant (SchedularPolicy.h) in the same binary: the
+ * default Schedular, then binary heap queues, the Mersenne Twister and the profiled phases.
+ * Results of a variant are named "<scenario>/<variant>", the default keeps the bare scenario
+ * name. The heap variant must give the default's tick count, the Mersenne variant draws other
+ * random numbers and simulates a different run.
+ *
+ * The allocation variants run the default Schedular with another allocation order of the
+ * free devices (lowest-id, least-used) or room fit (best-fit, worst-fit, consolidate). They
+ * call CheckAllocation after every time step, outside the timed phases, and count the time
+ * steps at which it failed. The checkpoint variant saves the default Schedular half way through
+ * the run, resumes the snapshot in a second Schedular once the run ended and counts a failure
+ * if the resumed run ends differently.
+ *
+ * Results are written as JSON, one scenario per line, so a result file can be kept and used as
+ * the baseline of later runs. A scenario regresses when its throughput falls, or its peak
+ * memory grows, by more than the tolerance. Equal seeds replay the same simulation, so a
+ * different tick count means the behaviour changed, not only the speed.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include "RoomIndex.h"
+using namespace std;
+
+#define SIM_PHASES 8
+
+/**
+ * @struct BenchmarkScenario
+ * @brief One generated workload.
+ */
+struct BenchmarkScenario
+{
+    string name;                ///< Name used in the results and the baseline
+    int patients;               ///< Number of patients
+    int numE;                   ///< Number of E devices
+    int numU;                   ///< Number of U devices
+    int numX;                   ///< Number of gym rooms
+    unsigned long long seed;    ///< Seed of the workload and of the simulation
+};
+
+/**
+ * @struct ScenarioResult
+ * @brief Measurements of one simulated scenario.
+ */
+struct ScenarioResult
+{
+    string name;                        ///< Scenario name, followed by "/<variant>" for every variant but the default
+    int patients;                       ///< Number of patients
+    int ticks;                          ///< Simulated time steps
+    double loadSeconds;                 ///< Time to generate and load the input
+    double seconds;                     ///< Time spent in the simulation phases
+    double ticksPerSecond;              ///< Simulated time steps per second
+    double patientsPerSecond;           ///< Patients simulated per second
+    long long peakRssKB;                ///< Peak resident memory of the process (KB), 0 if unknown
+    double phaseSeconds[SIM_PHASES];    ///< Time spent in each phase
+    int checkFailures;                  ///< Failed self-checks (allocation and checkpoint variants only)
+};
+
+struct BenchmarkVariant;
+
+/** @brief Generates, loads and simulates one scenario on the schedular of one policy. */
+typedef ScenarioResult (*ScenarioRunner)(const BenchmarkScenario& scenario, const BenchmarkVariant& variant);
+
+/**
+ * @struct BenchmarkVariant
+ * @brief One schedular policy the scenarios run on.
+ */
+struct BenchmarkVariant
+{
+    string name;                ///< Suffix of the result names ("" for the default Schedular)
+    ScenarioRunner run;         ///< RunScenario of the policy
+    AllocationOrder order;      ///< Allocation order of the free devices and rooms
+    RoomFit fit;                ///< Room given to a patient of a room lane
+    bool checked;               ///< Call CheckAllocation after every time step
+    bool resumed;               ///< Save half way, resume the snapshot and compare the ends (default Schedular only)
+};
+
+/**
+ * @class SimulationBenchmark
+ * @brief Runs the scenarios and compares the results with a baseline.
+ */
+class SimulationBenchmark
+{
+private:
+    vector<BenchmarkScenario> scenarios;    ///< Scenarios, smallest first
+    vector<BenchmarkVariant> variants;      ///< Schedular policies, the default first
+    vector<ScenarioResult> results;         ///< Results of the last run
+
+    /** @brief Generates, loads and simulates one scenario on a BasicSchedular<Policy>. */
+    template <class Policy>
+    static ScenarioResult RunScenario(const BenchmarkScenario& scenario, const BenchmarkVariant& variant);
+
+    /** @brief Peak resident memory of the process in KB (0 if the platform can't tell). */
+    static long long PeakRssKB();
+
+public:
+    /** @brief Constructs a benchmark with the scenarios of 1e3 to 1e6 patients, on every variant. */
+    SimulationBenchmark();
+
+    /** @brief Names of the timed phases, in simulation order. */
+    static const char* PhaseNames[SIM_PHASES];
+
+    /** @brief Keeps only the scenarios with at most the given number of patients. */
+    void setLargestScenario(int patients);
+
+    /**
+     * @brief Keeps only one variant.
+     * @param name "default", "heap", "mt", "profiled", "lowest-id", "least-used", "best-fit",
+     *        "worst-fit", "consolidate" or "checkpoint".
+     * @return false (variants unchanged) if there is no such variant.
+     */
+    bool setVariant(const string& name);
+
+    /** @brief Runs every scenario on every variant, printing one summary per result. */
+    void Run();
+
+    /** @brief Results of the last run. */
+    const vector<ScenarioResult>& getResults() const;
+
+    /** @brief True if no self-check failed in the last run. */
+    bool ChecksPassed() const;
+
+    /**
+     * @brief Writes the results as JSON (usable as a baseline).
+     * @return false if the file could not be written.
+     */
+    bool ExportJson(const string& fileName) const;
+
+    /**
+     * @brief Reads results written by ExportJson.
+     * @return false if the file could not be read.
+     */
+    static bool ReadJson(const string& fileName, vector<ScenarioResult>& baseline);
+
+    /**
+     * @brief Compares the last run with a baseline and prints every difference beyond the tolerance.
+     * @param baseline Results of the reference run.
+     * @param tolerance Allowed relative slowdown / memory growth (0.1 = 10%).
+     * @return false if any scenario regressed.
+     */
+    bool CompareWithBaseline(const vector<ScenarioResult>& baseline, double tolerance) const;
+};
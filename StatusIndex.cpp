@@ -0,0 +1,98 @@
+#include "StatusIndex.h"
+
+StatusIndex::StatusIndex()
+{
+	for (int s = 0; s < STATUS_CLASSES; s++)
+	{
+		for (int t = 0; t < 2; t++)
+			classes[s][t] = { nullptr, nullptr, 0 };
+	}
+}
+
+StatusIndex::~StatusIndex()
+{
+	for (int s = 0; s < STATUS_CLASSES; s++)
+	{
+		for (int t = 0; t < 2; t++)
+		{
+			Patient* p = classes[s][t].head;
+			while (p)
+			{
+				Patient* next = p->statusNext;
+				p->statusPrev = p->statusNext = nullptr;
+				p->statusIndex = nullptr;
+				p = next;
+			}
+		}
+	}
+}
+
+void StatusIndex::Link(Patient* myPatient)
+{
+	StatusClass& c = of(myPatient->status, myPatient->pType);
+
+	myPatient->statusPrev = c.tail;
+	myPatient->statusNext = nullptr;
+	if (c.tail)
+		c.tail->statusNext = myPatient;
+	else
+		c.head = myPatient;
+	c.tail = myPatient;
+	c.count++;
+}
+
+void StatusIndex::Unlink(Patient* myPatient, PatientStatus status)
+{
+	StatusClass& c = of(status, myPatient->pType);
+
+	if (myPatient->statusPrev)
+		myPatient->statusPrev->statusNext = myPatient->statusNext;
+	else
+		c.head = myPatient->statusNext;
+
+	if (myPatient->statusNext)
+		myPatient->statusNext->statusPrev = myPatient->statusPrev;
+	else
+		c.tail = myPatient->statusPrev;
+
+	myPatient->statusPrev = myPatient->statusNext = nullptr;
+	c.count--;
+}
+
+void StatusIndex::Attach(Patient* myPatient)
+{
+	if (!myPatient || myPatient->statusIndex == this)
+		return;
+
+	//a patient is counted by one index only
+	if (myPatient->statusIndex)
+		myPatient->statusIndex->Detach(myPatient);
+
+	myPatient->statusIndex = this;
+	Link(myPatient);
+}
+
+void StatusIndex::Detach(Patient* myPatient)
+{
+	if (!myPatient || myPatient->statusIndex != this)
+		return;
+
+	Unlink(myPatient, myPatient->status);
+	myPatient->statusIndex = nullptr;
+}
+
+void StatusIndex::Moved(Patient* myPatient, PatientStatus from)
+{
+	Unlink(myPatient, from);
+	Link(myPatient);
+}
+
+int StatusIndex::getCount(PatientStatus status) const
+{
+	return of(status, NORMAL).count + of(status, RECOVERING).count;
+}
+
+int StatusIndex::getCount(PatientStatus status, PatientType type) const
+{
+	return of(status, type).count;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file StatusIndex.h
+ * @brief Declares the StatusIndex class, the patients of a simulation grouped by status and type.
+ *
+ * Every status (IDLE to FINISHED) and patient type (N or R) is a class, held as a doubly
+ * linked list threaded through the patients themselves, so joining or leaving a class is a
+ * few pointer stores and needs no memory. Patient::setStatus moves the patient between the
+ * classes of the index they are attached to, so the classes follow every transition without
+ * the schedular doing anything more. Counts are O(1), listing a class is O(k) for its k
+ * patients ("every interrupted R patient") instead of a pass over every list.
+ *
+ * Patients join the index when they are added to the schedular, and leave it when they are
+ * deleted; finished patients reclaimed by an output sink are no longer counted.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include "Patient.h"
+
+#define STATUS_CLASSES (FINISHED + 2)   // IDLE to FINISHED
+
+/**
+ * @class StatusIndex
+ * @brief Intrusive lists of patients by status and type, O(1) counts and moves.
+ */
+class StatusIndex
+{
+private:
+    /** @brief Patients of one status and type, in the order they entered it. */
+    struct StatusClass
+    {
+        Patient* head;
+        Patient* tail;
+        int count;
+    };
+
+    StatusClass classes[STATUS_CLASSES][2];     ///< By status + 1, then 0 for N and 1 for R
+
+    /** @brief Class of a status and type, every type but NORMAL counts as R like the schedular does. */
+    StatusClass& of(PatientStatus status, PatientType type) { return classes[status + 1][type == NORMAL ? 0 : 1]; }
+    const StatusClass& of(PatientStatus status, PatientType type) const { return classes[status + 1][type == NORMAL ? 0 : 1]; }
+
+    void Link(Patient* myPatient);                              ///< Append to the class of the patient's status
+    void Unlink(Patient* myPatient, PatientStatus status);      ///< Remove from the class of a status
+
+public:
+    /** @brief Constructs an empty index. */
+    StatusIndex();
+
+    /** @brief Detaches the patients still attached, so none refers to the index. */
+    ~StatusIndex();
+
+    StatusIndex(const StatusIndex&) = delete;
+    StatusIndex& operator=(const StatusIndex&) = delete;
+
+    /** @brief Adds a patient to the class of their status, nothing if already attached here. */
+    void Attach(Patient* myPatient);
+
+    /** @brief Removes a patient from the index. */
+    void Detach(Patient* myPatient);
+
+    /**
+     * @brief Moves a patient to the class of their new status, called by Patient::setStatus.
+     * @param myPatient Patient, their new status already set.
+     * @param from Status they had.
+     */
+    void Moved(Patient* myPatient, PatientStatus from);
+
+    int getCount(PatientStatus status) const;                       ///< Patients with a status, both types
+    int getCount(PatientStatus status, PatientType type) const;     ///< Patients with a status and type
+
+    /**
+     * @brief Calls visit(patient) for every patient with a status and type, in the order they got it.
+     * visit must not change the status of a patient.
+     */
+    template <typename Visitor>
+    void Traverse(PatientStatus status, PatientType type, Visitor visit) const
+    {
+        for (Patient* p = of(status, type).head; p; p = p->statusNext)
+            visit(p);
+    }
+
+    /** @brief Calls visit(patient) for every patient with a status, N patients first. */
+    template <typename Visitor>
+    void Traverse(PatientStatus status, Visitor visit) const
+    {
+        Traverse(status, NORMAL, visit);
+        Traverse(status, RECOVERING, visit);
+    }
+};
@@ -0,0 +1,122 @@
+#include "Telemetry.h"
+#include "Schedular.h"
+#include "BufferedWriter.h"
+
+const char* Telemetry::ColumnNames[TELEMETRY_COLUMNS] =
+{
+	"time", "early", "late", "e_wait", "u_wait", "x_wait", "in_treatment", "interrupted",
+	"free_e", "free_u", "free_x", "maintenance_e", "maintenance_u"
+};
+
+Telemetry::Telemetry(int capacity, int every) : recorded(0), sampleEvery((every > 0) ? every : 1)
+{
+	//a power of two capacity turns the wrap around into a mask, a ring keeps at least one sample
+	uint32_t wanted = (capacity > 0) ? (uint32_t)capacity : 1;
+	uint32_t size = 1;
+	while (size < wanted && size < (1u << 30))
+		size <<= 1;
+	mask = size - 1;
+
+	for (vector<int32_t>& column : columns)
+		column.assign(size, 0);
+}
+
+template <class Policy>
+void Telemetry::Record(const BasicSchedular<Policy>& s)
+{
+	if (s.currentTime % sampleEvery)
+		return;
+
+	uint32_t at = (uint32_t)recorded & mask;
+	recorded++;
+
+	//read the lists directly (friend), every count is an inline member read
+	//the columns follow the built-in lanes, declared lanes are not sampled
+	columns[TELEMETRY_TIME][at] = s.currentTime;
+	columns[TELEMETRY_EARLY][at] = s.EARLY_patients.getCount();
+	columns[TELEMETRY_LATE][at] = s.LATE_patients.getCount();
+	columns[TELEMETRY_E_WAIT][at] = s.lanes[E_THERAPY].waiting.getCount();
+	columns[TELEMETRY_U_WAIT][at] = s.lanes[U_THERAPY].waiting.getCount();
+	columns[TELEMETRY_X_WAIT][at] = s.lanes[X_THERAPY].waiting.getCount();
+	columns[TELEMETRY_IN_TREATMENT][at] = s.inTreatment.getCount();
+	columns[TELEMETRY_INTERRUPTED][at] = s.interruptedPatients.getCount();
+	columns[TELEMETRY_FREE_E][at] = s.lanes[E_THERAPY].devices.getCount();
+	columns[TELEMETRY_FREE_U][at] = s.lanes[U_THERAPY].devices.getCount();
+	columns[TELEMETRY_FREE_X][at] = s.lanes[X_THERAPY].rooms.getCount();
+	columns[TELEMETRY_MAINTENANCE_E][at] = s.lanes[E_THERAPY].maintenance.getCount();
+	columns[TELEMETRY_MAINTENANCE_U][at] = s.lanes[U_THERAPY].maintenance.getCount();
+}
+
+#define INSTANTIATE_TELEMETRY_RECORD(Policy) template void Telemetry::Record(const BasicSchedular<Policy>&);
+SCHEDULAR_POLICIES(INSTANTIATE_TELEMETRY_RECORD)
+
+void Telemetry::Reset() { recorded = 0; }
+
+int Telemetry::getCount() const
+{
+	return (recorded > mask) ? (int)mask + 1 : (int)recorded;
+}
+
+long long Telemetry::getDropped() const
+{
+	return (long long)recorded - getCount();
+}
+
+int32_t Telemetry::getSample(TelemetryColumn column, int index) const
+{
+	//the oldest held sample sits right after the newest once the ring wrapped
+	uint64_t oldest = recorded - getCount();
+	return columns[column][(uint32_t)(oldest + index) & mask];
+}
+
+bool Telemetry::ExportCsv(const string& fileName) const
+{
+	BufferedWriter writer;
+	if (!writer.Open(fileName, false))
+	{
+		cout << "Error: Unable to create file " << fileName << endl;
+		return false;
+	}
+
+	for (int c = 0; c < TELEMETRY_COLUMNS; c++)
+	{
+		writer.Put(ColumnNames[c]);
+		writer.Put(c + 1 < TELEMETRY_COLUMNS ? ',' : '\n');
+	}
+
+	int count = getCount();
+	for (int i = 0; i < count; i++)
+	{
+		for (int c = 0; c < TELEMETRY_COLUMNS; c++)
+		{
+			writer.Put(getSample((TelemetryColumn)c, i));
+			writer.Put(c + 1 < TELEMETRY_COLUMNS ? ',' : '\n');
+		}
+	}
+	return writer.Close();
+}
+
+bool Telemetry::ExportBinary(const string& fileName) const
+{
+	BufferedWriter writer;
+	if (!writer.Open(fileName))
+	{
+		cout << "Error: Unable to create file " << fileName << endl;
+		return false;
+	}
+
+	int count = getCount();
+	TelemetryHeader header = { { 'P', 'C', 'T', 'M' }, 1, TELEMETRY_COLUMNS, (uint32_t)count,
+		(uint32_t)sampleEvery, (uint32_t)getDropped() };
+	writer.Write(&header, sizeof(header));
+
+	//the ring is written in two pieces, oldest first
+	uint32_t oldest = (uint32_t)(recorded - count) & mask;
+	uint32_t firstPiece = ((uint32_t)count < mask + 1 - oldest) ? (uint32_t)count : mask + 1 - oldest;
+	for (const vector<int32_t>& column : columns)
+	{
+		writer.Write(column.data() + oldest, firstPiece * sizeof(int32_t));
+		writer.Write(column.data(), (count - firstPiece) * sizeof(int32_t));
+	}
+	return writer.Close();
+}
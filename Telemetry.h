@@ -0,0 +1,105 @@
+/**
+ * @file Telemetry.h
+ * @brief Per tick time series of queue depths, free devices and maintenance counts.
+ *
+ * A Telemetry recorder attached to a Schedular (Schedular::setTelemetry) samples the list
+ * counts at the end of every time step, or every N steps, into preallocated columns. The
+ * columns form a ring: once full, the oldest samples are overwritten, so memory never grows
+ * and a long run keeps its most recent history. A sample is a dozen counter reads and stores,
+ * cheap enough to stay on in production runs.
+ *
+ * At the end of a run the samples are exported, oldest first, as CSV or as a columnar binary
+ * file: a TelemetryHeader followed by one int32_t array per column (TELEMETRY_COLUMNS,
+ * in the order of TelemetryColumn).
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "SchedularFwd.h"
+
+/** @enum TelemetryColumn
+ *  Sampled values, in file order.
+ */
+enum TelemetryColumn
+{
+    TELEMETRY_TIME,
+    TELEMETRY_EARLY,
+    TELEMETRY_LATE,
+    TELEMETRY_E_WAIT,
+    TELEMETRY_U_WAIT,
+    TELEMETRY_X_WAIT,
+    TELEMETRY_IN_TREATMENT,
+    TELEMETRY_INTERRUPTED,
+    TELEMETRY_FREE_E,
+    TELEMETRY_FREE_U,
+    TELEMETRY_FREE_X,
+    TELEMETRY_MAINTENANCE_E,
+    TELEMETRY_MAINTENANCE_U,
+    TELEMETRY_COLUMNS
+};
+
+/**
+ * @struct TelemetryHeader
+ * @brief First record of a binary telemetry file.
+ */
+struct TelemetryHeader
+{
+    char magic[4];          ///< "PCTM"
+    uint32_t version;       ///< 1
+    uint32_t columns;       ///< TELEMETRY_COLUMNS
+    uint32_t rows;          ///< Samples per column
+    uint32_t sampleEvery;   ///< Time steps between two samples
+    uint32_t dropped;       ///< Oldest samples overwritten by the ring
+};
+
+/**
+ * @class Telemetry
+ * @brief Fixed size ring of time step samples.
+ */
+class Telemetry
+{
+private:
+    vector<int32_t> columns[TELEMETRY_COLUMNS];  ///< One preallocated array per value
+    uint32_t mask;                              ///< Capacity - 1 (the capacity is a power of two)
+    uint64_t recorded;                          ///< Samples recorded since the last Reset
+    int sampleEvery;                            ///< Time steps between two samples
+
+public:
+    /**
+     * @brief Preallocates the ring.
+     * @param capacity Number of samples kept, rounded up to a power of two (at least 1).
+     * @param every Time steps between two samples (1 = every step).
+     */
+    Telemetry(int capacity = 1 << 18, int every = 1);
+
+    /** @brief Samples the schedular (of any policy) if its current time is due. */
+    template <class Policy>
+    void Record(const BasicSchedular<Policy>& mySchedular);
+
+    /** @brief Forgets every sample, the memory stays allocated. */
+    void Reset();
+
+    /** @brief Number of samples held (at most the capacity). */
+    int getCount() const;
+
+    /** @brief Number of oldest samples overwritten so far. */
+    long long getDropped() const;
+
+    /** @brief Held sample of a column by age, 0 = oldest. */
+    int32_t getSample(TelemetryColumn column, int index) const;
+
+    /** @brief Writes the held samples as CSV, one line per sample. */
+    bool ExportCsv(const string& fileName) const;
+
+    /** @brief Writes the held samples as a columnar binary file. */
+    bool ExportBinary(const string& fileName) const;
+
+    /** @brief Column names as written in the CSV header. */
+    static const char* ColumnNames[TELEMETRY_COLUMNS];
+};
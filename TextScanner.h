@@ -0,0 +1,90 @@
+/**
+ * @file TextScanner.h
+ * @brief Whitespace separated token reader over an in-memory text, used by the fast loader.
+ *
+ * TextScanner reads integers with std::from_chars and single characters directly from a
+ * character range (for example a MappedFile). It mimics the ifstream operators the loader
+ * uses: extraction with >>, and a failed state that sticks once a read fails, so the same
+ * parsing code and error messages work on both.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <charconv>
+
+/**
+ * @class TextScanner
+ * @brief Hand-written tokenizer for the whitespace separated input file format.
+ */
+class TextScanner
+{
+private:
+    const char* cursor;     ///< Next character to read
+    const char* end;        ///< One past the last character
+    bool failed;            ///< True once a read failed, all following reads fail too
+
+    /** @brief Moves the cursor past spaces, tabs and line breaks. */
+    void SkipSpaces()
+    {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t'
+            || *cursor == '\v' || *cursor == '\f'))
+        {
+            cursor++;
+        }
+    }
+
+public:
+    TextScanner(const char* first, const char* last) : cursor(first), end(last), failed(false) {}
+
+    /** @brief Reads the next integer token (an optional sign followed by digits). */
+    TextScanner& operator>>(int& value)
+    {
+        if (failed)
+            return *this;
+
+        SkipSpaces();
+
+        //from_chars rejects a leading '+', istream accepts it
+        if (cursor < end && *cursor == '+')
+            cursor++;
+
+        std::from_chars_result result = std::from_chars(cursor, end, value);
+        if (result.ec != std::errc())
+            failed = true;
+        else
+            cursor = result.ptr;
+        return *this;
+    }
+
+    /** @brief Reads the next non-space character. */
+    TextScanner& operator>>(char& value)
+    {
+        if (failed)
+            return *this;
+
+        SkipSpaces();
+
+        if (cursor == end)
+            failed = true;
+        else
+            value = *cursor++;
+        return *this;
+    }
+
+    /** @brief Next non-space character without reading it, 0 at the end or after a failed read. */
+    char peek()
+    {
+        if (failed)
+            return 0;
+
+        SkipSpaces();
+        return (cursor < end) ? *cursor : 0;
+    }
+
+    /** @brief Returns true while no read has failed, like a stream in a condition. */
+    explicit operator bool() const { return !failed; }
+
+    /** @brief Next character to read. */
+    const char* position() const { return cursor; }
+};
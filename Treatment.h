@@ -1,133 +1,150 @@
 /**
  * @file Treatment.h
- * @brief Abstract base class representing generic medical treatments.
+ * @brief Value type describing one treatment a patient requires.
  *
- * Defines the Treatment class that manages treatment duration, resource assignment,
- * timing, and treatment type. This class serves as a base for specific treatment
- * types and includes interfaces for resource assignment and patient queue management.
+ * Defines the Treatment record that holds the treatment duration, resource assignment,
+ * timing and treatment type. Treatments are plain values stored inline in their patient:
+ * there is no class per type and no virtual call, the few operations that depend on the
+ * type (which waiting list, which device pool) switch on the type tag, so they inline into
+ * the schedular loops. E_treatment, U_treatment and X_treatment only build a typed value.
  *
  * @author Abdelrahman Samir
  * @date March 2025
  */
 #pragma once
 #include <iostream>
+#include <cstdint>
 using namespace std;
 
 class Resource;  // Forward declaration
-class Schedular; // Forward declaration
 class Patient;   // Forward declaration
 
 /** @enum TreatmentType
-    Represents the type of treatment a patient may receive. */
-enum TreatmentType { E_THERAPY, U_THERAPY, X_THERAPY, DUMMY_THERAPY};
+    Represents the type of treatment a patient may receive. The type is also the index of
+    its lane in the schedular: E, U and X are always lanes 0 to 2, the input file may
+    declare more lanes, numbered from 3 up to MAX_LANES - 1. */
+enum TreatmentType : int8_t { E_THERAPY, U_THERAPY, X_THERAPY, DUMMY_THERAPY = -1 };
+
+#define MAX_LANES 8         // treatment types a schedular can hold, built-in ones included
+#define MAX_TREATMENTS 4    // treatments a patient may require, each of a different type
 
 class Treatment
 {
 protected:
-    int duration;               ///< Duration of the treatment
     Resource* Assigned_Resource;///< Pointer to the resource assigned to this treatment
+    int duration;               ///< Duration of the treatment
     int assignmentTime;         ///< Time when the treatment was assigned
     int finishTime;             ///< Time when the treatment finishes
-    TreatmentType type;                  ///< Type of the treatment (E, U, X)
+    TreatmentType type;         ///< Type of the treatment, the lane serving it
     bool interrupted;
 
 public:
     /** @brief Default constructor. Initializes members with default values. */
-    Treatment();
+    Treatment()
+        : Assigned_Resource(nullptr), duration(0), assignmentTime(-1), finishTime(-1), type(DUMMY_THERAPY), interrupted(false) {}
 
     /**
      * @brief Parameterized constructor.
      * @param d Duration of the treatment
      * @param TreatType Type of the treatment
      */
-    Treatment(int d, TreatmentType TreatType);
+    Treatment(int d, TreatmentType TreatType)
+        : Assigned_Resource(nullptr), duration((d > 0) ? d : 0), assignmentTime(-1), finishTime(-1), type(TreatType), interrupted(false) {}
 
     /**
      * @brief Assigns a resource to the treatment.
      * @post Assigned_Resource is set and resource status is updated internally.
      * @param resource Pointer to the resource to be assigned
      */
-    virtual void assignResource(Resource* resource);
+    void assignResource(Resource* resource);
 
     /**
      * @brief Frees the resource assigned to this treatment.
      * @post Assigned_Resource is set to nullptr and the resource is marked as available.
      * @return Pointer to freed resource
      */
-    virtual Resource* FreeResource();
+    Resource* FreeResource();
 
     /**
      * @brief Sets the time at which treatment was assigned.
      * @param t Time value to be set
      */
-    virtual void setAssignmentTime(int t);
+    void setAssignmentTime(int t)
+    {
+        if ((t > finishTime && finishTime != -1) || t < 0)
+            return;
+        assignmentTime = t;
+    }
 
     /**
      * @brief Sets the duration of the treatment
      * @param t time to be set
      */
-    virtual void setDuration(int t);
+    void setDuration(int t) { duration = (t > 0) ? t : duration; }
 
     /**
      * @brief Sets the time at which treatment will finish.
      * @param t Time value to be set
      */
-    virtual void setFinishTime(int t);
+    void setFinishTime(int t)
+    {
+        if (t < assignmentTime || t < 0)
+            return;
+        finishTime = t;
+    }
 
     /**
     * @brief Sets the boolean interrupted to true.
     */
-    virtual void setInterrupted();
+    void setInterrupted() { interrupted = true; }
 
     /** @brief Gets the duration of the treatment.
      *  @return Duration in time units
      */
-    virtual int getDuration() const;
+    int getDuration() const { return duration; }
 
     /** @brief Gets the time at which the treatment was assigned.
      *  @return Assignment time
      */
-    virtual int getAssignmentTime() const;
+    int getAssignmentTime() const { return assignmentTime; }
 
     /** @brief Gets the time at which the treatment will finish.
      *  @return Finish time
      */
-    virtual int getFinishTime() const;
+    int getFinishTime() const { return finishTime; }
 
     /** @brief Gets the pointer to the assigned resource.
      *  @return Pointer to the Resource object
      */
-    virtual Resource* getAssignedResource() const;
+    Resource* getAssignedResource() const { return Assigned_Resource; }
 
     /** @brief Gets the type of the treatment.
-     *  @return Enum value of TreatmentType (E_THERAPY, U_THERAPY, X_THERAPY)
+     *  @return Enum value of TreatmentType (E_THERAPY, U_THERAPY, X_THERAPY or a declared lane)
      */
-    virtual TreatmentType getType() const;
+    TreatmentType getType() const { return type; }
 
     /** @brief Gets the type of the treatment.
      *  @return True if the treatment was previously interrupted, false otherwise
      */
-    virtual bool isInterrupted() const;
+    bool isInterrupted() const { return interrupted; }
 
     /**
-     * @brief Determines whether the treatment can be assigned to a given resource.
-     * @param resource Pointer to a candidate Resource object
+     * @brief Determines whether a device of this treatment's lane is available.
+     * @param schedular Reference to the scheduler managing the facility (any BasicSchedular)
      * @return True if assignable, false otherwise
-     * @note This is a pure virtual function to be implemented by derived classes.
+     * @note The type tag is the lane index, so the call inlines into the schedular loops.
      */
-    virtual bool CanAssign(Schedular& schedular) = 0;
+    template <class System>
+    bool CanAssign(System& schedular) const { return schedular.CanAssign(type); }
 
     /**
-     * @brief Moves a patient to the appropriate waiting list based on treatment type.
-     * @param schedular Reference to the scheduler managing the facility
+     * @brief Moves a patient to the waiting list of this treatment's lane.
+     * @param schedular Reference to the scheduler managing the facility (any BasicSchedular)
      * @param myPatient Pointer to the patient to be moved
      * @return True if the patient was successfully added to the waitlist
-     * @note This is a pure virtual function to be implemented by derived classes.
      */
-    virtual bool MoveToWait(Schedular& schedular, Patient* myPatient) = 0;
-
-    /** @brief Virtual destructor to ensure proper cleanup in derived classes. */
-    virtual ~Treatment();
+    template <class System>
+    bool MoveToWait(System& schedular, Patient* myPatient) const { return schedular.addToWait(type, myPatient); }
 
     /**
      * @brief Overloaded stream output operator.
@@ -137,9 +154,12 @@ public:
      */
     friend ostream& operator<<(ostream& os, const Treatment& t);
 
+    /** @brief Checkpoint saves and restores the complete treatment state. */
+    friend class Checkpoint;
+
     /**
-     * @brief Abstract method to print treatment-specific details to output stream.
+     * @brief Prints the treatment type and duration to output stream.
      * @param os Output stream
      */
-    virtual void print(ostream& os) const = 0;
+    void print(ostream& os) const;
 };
@@ -0,0 +1,61 @@
+/**
+ * @file TreatmentLane.h
+ * @brief Declares the TreatmentLane record, everything the schedular keeps per treatment type.
+ *
+ * A lane is one treatment modality: its free devices (a bitmap over the resources of the
+ * lane, AvailabilitySet.h) or its rooms with a free slot (by free slots, RoomIndex.h), the
+ * devices under maintenance, the waiting list, and the
+ * failure counters. The schedular holds the lanes
+ * in an array indexed by TreatmentType, E, U and X are lanes 0 to 2 and the input file may
+ * declare more. Every per tick phase loops over the lanes in index order. The maintenance
+ * queue and the waiting list are the types of the schedular policy (SchedularPolicy.h).
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include "AvailabilitySet.h"
+#include "RoomIndex.h"
+#include "priQueue.h"
+#include "X_WaitList.h"
+#include "EventLog.h"
+#include "SchedularFwd.h"
+
+class Resource;
+
+/** @enum LaneKind
+    What a lane is served by, which decides its failure model (TreatmentTraits.h). */
+enum LaneKind : int8_t
+{
+    DEVICE_LANE,    ///< One patient per device, devices fail and go to maintenance
+    ROOM_LANE       ///< Rooms hold several patients, never fail, waiting patients may cancel
+};
+
+/**
+ * @struct BasicTreatmentLane
+ * @brief Resources, waiting list and statistics of one treatment type.
+ */
+template <class Policy>
+struct BasicTreatmentLane
+{
+    char code;                          ///< Letter of the treatment in the input file ('E', 'U', 'X', ...)
+    LaneKind kind;                      ///< Devices or rooms
+    EventType waitEvent;                ///< Logged when a patient enters the waiting list
+
+    AvailabilitySet devices;            ///< Free devices (device lanes)
+    RoomIndex rooms;                    ///< Rooms with a free slot (room lanes)
+    typename Policy::template PriorityQueue<Resource*> maintenance; ///< Failed devices by the time they are repaired (empty for rooms)
+    typename Policy::WaitList waiting;  ///< Patients waiting for this treatment
+
+    int numDevices;                     ///< Devices or rooms loaded
+    int totalFreeFail;                  ///< Devices that failed while free at least once
+    int totalBusyFail;                  ///< Failures while treating a patient
+
+    BasicTreatmentLane() : code(0), kind(DEVICE_LANE), waitEvent(EVENT_WAIT_OTHER), numDevices(0), totalFreeFail(0), totalBusyFail(0) {}
+
+    /** @brief Free devices, or rooms with a free slot. */
+    int getFreeCount() const { return (kind == ROOM_LANE) ? rooms.getCount() : devices.getCount(); }
+};
+
+/** @brief Lane of the default Schedular. */
+typedef BasicTreatmentLane<DefaultSchedularPolicy> TreatmentLane;
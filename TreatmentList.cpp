@@ -1,16 +1,21 @@
 #include "TreatmentList.h"
+#include "SchedularPolicy.h"
+#include "Resource.h"
 #include <vector>
 
-Patient* TreatmentList::RandomBusyFailure(int pBusyFailure, int currentTime)
+template <class Policy>
+Patient* BasicTreatmentList<Policy>::RandomBusyFailure(int pBusyFailure, int currentTime, typename Policy::Random& rng)
 {
+    typename Policy::Instrumentation::Scope profile(PROFILE_RANDOM_BUSY_FAILURE);
+
     // Return nullptr if no patients in treatment
-    if (isEmpty()) { return nullptr; }
+    if (this->isEmpty()) { return nullptr; }
 
     // Generate random number to check for failure
-    if (rand() % 100 >= pBusyFailure) { return nullptr; } // No failure this time
+    if (rng.Next(100) >= pBusyFailure) { return nullptr; } // No failure this time
 
     // for holding original queue and restoring it later
-    TreatmentList temp;
+    BasicTreatmentList<Policy> temp;
 
     // for dequeueing and enqueueing
     Patient* tempPatient = nullptr;
@@ -22,7 +27,7 @@ Patient* TreatmentList::RandomBusyFailure(int pBusyFailure, int currentTime)
 
     //to decide when to stop searching for a patient having E or U
     //indication we don't have a patient with matching characteristics
-    int TotalPatients = getCount();
+    int TotalPatients = this->getCount();
     bool* CheckedIndices = new bool[TotalPatients];
     int CheckedPatients = 0;
 
@@ -35,7 +40,7 @@ Patient* TreatmentList::RandomBusyFailure(int pBusyFailure, int currentTime)
     while(CheckedPatients < TotalPatients)
     {
         //generate random index
-        int RandomIndex = rand() % TotalPatients;
+        int RandomIndex = rng.Next(TotalPatients);
 
         //if this index is checked previouly, generate another
         if (CheckedIndices[RandomIndex])
@@ -44,15 +49,15 @@ Patient* TreatmentList::RandomBusyFailure(int pBusyFailure, int currentTime)
         //dequeue until you reach the required patient index
         for (int i = 0; i < RandomIndex; i++)
         {
-            dequeue(tempPatient, TreatmentFinishTime);
+            this->dequeue(tempPatient, TreatmentFinishTime);
             temp.enqueue(tempPatient, TreatmentFinishTime);
         }
 
         //get pointer to required patient index
-        dequeue(InterruptedPatient, foundFinishTime);
+        this->dequeue(InterruptedPatient, foundFinishTime);
 
         //empty *this before further processing
-        while (dequeue(tempPatient, TreatmentFinishTime))
+        while (this->dequeue(tempPatient, TreatmentFinishTime))
         {
             temp.enqueue(tempPatient, TreatmentFinishTime);
         }
@@ -60,11 +65,14 @@ Patient* TreatmentList::RandomBusyFailure(int pBusyFailure, int currentTime)
         //restore the original queue
         while (temp.dequeue(tempPatient, TreatmentFinishTime))
         {
-            enqueue(tempPatient, TreatmentFinishTime);
+            this->enqueue(tempPatient, TreatmentFinishTime);
         }
 
-        //if the patient choosen doesn't have either E or U treatments (has X treatment)
-        if (InterruptedPatient->getNextTreatment()->getType() == X_THERAPY)
+        //if the patient choosen is in a room (X or a declared room lane), rooms never fail
+        //(a treatment given no resource, as in the container benchmark, goes by its type)
+        Treatment* treatment = InterruptedPatient->getNextTreatment();
+        Resource* resource = treatment->getAssignedResource();
+        if (resource ? resource->getType() == _Xdevice : treatment->getType() == X_THERAPY)
         {
             //increment number of checked patients
             CheckedPatients++;
@@ -73,14 +81,14 @@ Patient* TreatmentList::RandomBusyFailure(int pBusyFailure, int currentTime)
             CheckedIndices[RandomIndex] = true;
 
             //put them back into the original queue
-            enqueue(InterruptedPatient, foundFinishTime);
+            this->enqueue(InterruptedPatient, foundFinishTime);
 
             //continue searching
             continue;
         }
         else
         {
-            //for any other type other that X_THERAPY, we found our target
+            //the patient is on a device, we found our target
             isPatientFound = true;
             break;
         }
@@ -112,3 +120,5 @@ Patient* TreatmentList::RandomBusyFailure(int pBusyFailure, int currentTime)
 
 }
 
+#define INSTANTIATE_TREATMENT_LIST(Policy) template class BasicTreatmentList<Policy>;
+SCHEDULAR_POLICIES(INSTANTIATE_TREATMENT_LIST)
@@ -12,15 +12,18 @@
 #pragma once
 #include "priQueue.h"
 #include "Patient.h"
+#include "SchedularFwd.h"
 
  /**
-  * @class TreatmentList
+  * @class BasicTreatmentList
   * @brief Manages a queue of patients undergoing treatments.
   *
   * TreatmentList provides mechanisms for managing patients currently receiving treatment.
   * It supports random busy failure simulation that may interrupt patient treatments and adjust durations.
+  * The queue is the priority queue of the schedular policy (SchedularPolicy.h).
   */
-class TreatmentList : public priQueue <Patient*>
+template <class Policy>
+class BasicTreatmentList : public Policy::template PriorityQueue <Patient*>
 {
 public:
     /**
@@ -32,11 +35,15 @@ public:
      *
      * @param pBusyFailure Probability (0-100) of failure occurring during busy state.
      * @param currentTime The current simulation time to calculate remaining treatment duration.
+     * @param rng Random generator of the simulation.
      * @return Pointer to the Patient whose treatment was interrupted, or nullptr if no failure occurred.
      */
-    Patient* RandomBusyFailure(int pBusyFailure, int currentTime);
+    Patient* RandomBusyFailure(int pBusyFailure, int currentTime, typename Policy::Random& rng);
 
     // Other public member functions would be declared here
 
     // Note: This header assumes necessary queue functions like enqueue, dequeue, getCount, isEmpty are implemented in the class.
-};
\ No newline at end of file
+};
+
+/** @brief In-treatment list of the default Schedular. */
+typedef BasicTreatmentList<DefaultSchedularPolicy> TreatmentList;
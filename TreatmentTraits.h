@@ -0,0 +1,48 @@
+/**
+ * @file TreatmentTraits.h
+ * @brief Compile-time description of each lane kind, used by the schedular templates.
+ *
+ * The paths of the schedular that differ between devices and rooms (finding a free
+ * resource, serving a waiting list) are written once as templates on a lane kind.
+ * TreatmentTraits<K> states what differs: which class the lane holds and where its free
+ * ones are listed, whether it can fail while free, and whether waiting patients may cancel. The lane itself (lists and counters)
+ * is passed at run time, so every lane of a kind, built-in or declared, shares one copy of
+ * the code with the other kind's branches compiled out.
+ *
+ * Only Schedular.cpp includes this header.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include "Schedular.h"
+
+/**
+ * @struct TreatmentTraits
+ * @brief Policy of one lane kind, only the specialisations below exist.
+ */
+template <LaneKind K>
+struct TreatmentTraits;
+
+template <>
+struct TreatmentTraits<DEVICE_LANE>
+{
+    typedef Device Unit;                                    ///< Class of the resources in the lane
+    static const bool freeFailure = true;                   ///< Devices may fail while free, and go to maintenance
+    static const bool cancellation = false;                 ///< Waiting patients may cancel
+
+    /** @brief Free resources of the lane. */
+    template <class Lane>
+    static AvailabilitySet& Free(Lane& lane) { return lane.devices; }
+};
+
+template <>
+struct TreatmentTraits<ROOM_LANE>
+{
+    typedef GymRoom Unit;
+    static const bool freeFailure = false;                  ///< Rooms never fail, the maintenance queue stays empty
+    static const bool cancellation = true;
+
+    template <class Lane>
+    static RoomIndex& Free(Lane& lane) { return lane.rooms; }
+};
@@ -23,6 +23,15 @@ void UI::DisplaySystemStatus(const Schedular& mySchedular)
 	std::cout << "Total Patients Processed: " << mySchedular.getTotalPatients() << "\n";
 	std::cout << "Total Resources in Use: " << mySchedular.getTotalResources() << "\n";
 
+	//N/R split of every status, O(1) each
+	static const PatientStatus statuses[] = { IDLE, EARLY, LATE, WAIT, SERV, INTERRUPTED, FINISHED };
+	static const char* names[] = { "Not Arrived", "Early", "Late", "Waiting", "Serving", "Interrupted", "Finished" };
+	const StatusIndex& byStatus = mySchedular.getStatusIndex();
+	std::cout << "Patients by Status (N/R):";
+	for (int i = 0; i < 7; i++)
+		std::cout << " " << names[i] << " " << byStatus.getCount(statuses[i], NORMAL) << "/" << byStatus.getCount(statuses[i], RECOVERING);
+	std::cout << "\n";
+
 	std::cout << "\n=== Patients Lists ===\n";
 
 	std::cout << "Early Patients (" << mySchedular.getEarlyPatientsCount() << "):\n";
@@ -40,6 +49,13 @@ void UI::DisplaySystemStatus(const Schedular& mySchedular)
 	std::cout << "X-Treatment Waiting List (" << mySchedular.getXWaitCount() << "):\n";
 	mySchedular.printXWait();
 
+	//lanes declared in the input file
+	for (int i = X_THERAPY + 1; i < mySchedular.getLaneCount(); i++)
+	{
+		std::cout << mySchedular.getLaneCode((TreatmentType)i) << "-Treatment Waiting List (" << mySchedular.getWaitCount((TreatmentType)i) << "):\n";
+		mySchedular.printWait((TreatmentType)i);
+	}
+
 	std::cout << "In Treatment (" << mySchedular.getInTreatmentCount() << "):\n";
 	mySchedular.printInTreatment();
 
@@ -80,45 +96,50 @@ void UI::DisplayFinalPatient(const Schedular& mySchedular)
 
 void UI::DisplayHistory(const Schedular& mySchedular)
 {
-	LinkedQueue<Patient*> history = mySchedular.getHistory(); // or getHistory(), depending on implementation
-	Patient* p = nullptr;
-
 	cout << "---------------- Patient History ----------------" << endl;
-	cout << "PID | Type | Status   | PT  | VT  | FT  | Cancel | Resched" << endl;
+	cout << "PID | Type | Status   | List | Since | Next | FT  | Cancel | Resched" << endl;
 	cout << "-------------------------------------------------" << endl;
 
-	while (!history.isEmpty())
+	//one line per patient, in PID order, a rescheduled patient is no longer listed twice
+	mySchedular.getRegistry().Traverse([&](int PID, const PatientEntry& e)
 	{
-		history.dequeue(p);
-		if (!p) continue;
-
-		string typeStr = (p->getType() == NORMAL) ? "N" : "R";
+		string typeStr = (e.flags & PATIENT_RECOVERING) ? "R" : "N";
 
 		string statusStr;
-		switch (p->getStatus())
+		switch (e.status)
 		{
-		case EARLY:    statusStr = "EARLY"; break;
-		case LATE:     statusStr = "LATE"; break;
-		case WAIT:     statusStr = "WAIT"; break;
-		case SERV:     statusStr = "SERVING"; break;
-		case FINISHED: statusStr = "FINISHED"; break;
-		case IDLE:     statusStr = "IDLE"; break;
-		default:       statusStr = "UNKNOWN"; break;
+		case EARLY:       statusStr = "EARLY"; break;
+		case LATE:        statusStr = "LATE"; break;
+		case WAIT:        statusStr = "WAIT"; break;
+		case SERV:        statusStr = "SERVING"; break;
+		case INTERRUPTED: statusStr = "INTERRUPTED"; break;
+		case FINISHED:    statusStr = "FINISHED"; break;
+		case IDLE:        statusStr = "IDLE"; break;
+		default:          statusStr = "UNKNOWN"; break;
 		}
 
-		cout << p->getPID() << "   | "
+		string placeStr = PatientRegistry::PlaceName(e.place);
+		if (e.lane >= 0)
+			placeStr += string(" ") + mySchedular.getLaneCode((TreatmentType)e.lane);
+
+		cout << PID << "   | "
 			<< typeStr << " | "
 			<< statusStr << " | "
-			<< p->getAppointmentTime() << "  | "
-			<< p->getArrivalTime() << "  | "
-			<< p->getFinishTime() << "  | "
-			<< (p->isCancelled() ? "T" : "F") << "      | "
-			<< (p->isRescheduled() ? "T" : "F") << endl;
-		if (p->getStatus() != FINISHED)
+			<< placeStr << " | "
+			<< e.since << "  | "
+			<< e.nextEvent << "  | "
+			<< e.finishTime << "  | "
+			<< ((e.flags & PATIENT_CANCELLED) ? "T" : "F") << "      | "
+			<< (int)e.reschedules << endl;
+
+		//reclaimed patients only leave their entry
+		Patient* p = e.patient;
+		if (p && p->getStatus() != FINISHED)
 		{
-			p->getRemainingTreatments().printQueue();
+			for (int i = 0; i < p->getNumber_RemainingTreatment(); i++)
+				cout << *p->getRemainingTreatment(i) << "\n";
 		}
-	}
+	});
 
 	cout << "-------------------------------------------------" << endl;
 }
@@ -132,7 +153,7 @@ void UI::DisplayResources(const Schedular& mySchedular)
 //for Patient
 ostream& operator<<(ostream& os, Patient& myPatient)
 {
-	int treatment_number = myPatient.Required_Treatments.getCount();
+	int treatment_number = myPatient.getNumber_RemainingTreatment();
 
 	os << "[Patient " << myPatient.PID
 		<< ", PT: " << myPatient.PT
@@ -2,54 +2,28 @@
  * @file U_treatment.h
  * @brief Represents an Ultrasound (U-type) treatment derived from the Treatment base class.
  *
- * Defines the U_treatment class which manages ultrasound therapy-specific behavior,
- * including patient queuing and resource assignment.
- *
  * @author Abdelrahman Samir
  * @date March 2025
  */
 #pragma once
 #include "Treatment.h"
 
+/**
+ * @class U_treatment
+ * @brief Builds a U treatment value, stored inline in the patient like any Treatment.
+ * Adds no data and no behavior, the type tag selects the U waiting list and devices.
+ */
 class U_treatment : public Treatment
 {
 public:
     /**
      * @brief Default constructor.
      */
-    U_treatment();
+    U_treatment() : Treatment(0, U_THERAPY) {}
 
     /**
      * @brief Parameterized constructor.
      * @param d Duration of the treatment.
      */
-    U_treatment(int d);
-
-    /**
-     * @brief Moves the patient to the E wait list in the scheduler.
-     * @param scheduler Reference to the scheduler.
-     * @param patient Pointer to the patient.
-     * @return True if successfully added to wait list.
-     */
-    bool MoveToWait(Schedular& scheduler, Patient* patient) override;
-
-    /**
-     * @brief Checks if there is an available E-type resource.
-     * @param scheduler Reference to the scheduler.
-     * @return True if an E device is available.
-     */
-    bool CanAssign(Schedular& scheduler) override;
-
-    /**
-     * @brief Prints treatment information to output stream.
-     * @param os Output stream.
-     */
-    void print(ostream& os) const override;
-
-    /**
-     * @brief Destructor.
-     */
-    ~U_treatment();
+    U_treatment(int d) : Treatment(d, U_THERAPY) {}
 };
-
-
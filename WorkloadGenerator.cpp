@@ -0,0 +1,359 @@
+#include "WorkloadGenerator.h"
+#include "BufferedWriter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+static const char TreatmentLetters[3] = { 'E', 'U', 'X' };
+
+WorkloadGenerator::WorkloadGenerator() :
+	patients(1000),
+	recoveringPercent(50),
+	numE(3),
+	numU(3),
+	numX(2),
+	minRoomCapacity(2),
+	maxRoomCapacity(5),
+	pCancel(5),
+	pResc(5),
+	pFreeFailure(5),
+	pBusyFailure(5),
+	arrivals(POISSON_ARRIVALS),
+	arrivalRate(1.0),
+	dayLength(1440),
+	peakFactor(1.5),
+	burstEvery(500),
+	burstSize(50),
+	earlyPercent(30),
+	latePercent(30),
+	maxEarliness(20),
+	maxLateness(20),
+	minTreatments(1),
+	maxTreatments(3),
+	durations(UNIFORM_DURATION),
+	seed(1)
+{
+	profiles[0] = { 1, 1, 4, 10 };
+	profiles[1] = { 1, 1, 4, 10 };
+	profiles[2] = { 1, 1, 4, 10 };
+}
+
+void WorkloadGenerator::setPatients(int count, int recovering)
+{
+	patients = (count >= 0) ? count : 0;
+	recoveringPercent = (recovering <= 100 && recovering >= 0) ? recovering : 0;
+}
+
+void WorkloadGenerator::setDevices(int E, int U, int X, int minCapacity, int maxCapacity)
+{
+	numE = (E >= 0) ? E : 0;
+	numU = (U >= 0) ? U : 0;
+	numX = (X >= 0) ? X : 0;
+	minRoomCapacity = (minCapacity > 0) ? minCapacity : 1;
+	maxRoomCapacity = (maxCapacity >= minRoomCapacity) ? maxCapacity : minRoomCapacity;
+}
+
+void WorkloadGenerator::setProbabilities(int cancel, int resc, int freeFail, int busyFail)
+{
+	pCancel = (cancel <= 100 && cancel >= 0) ? cancel : 0;
+	pResc = (resc <= 100 && resc >= 0) ? resc : 0;
+	pFreeFailure = (freeFail <= 100 && freeFail >= 0) ? freeFail : 0;
+	pBusyFailure = (busyFail <= 100 && busyFail >= 0) ? busyFail : 0;
+}
+
+void WorkloadGenerator::setPoisson(double rate)
+{
+	arrivals = POISSON_ARRIVALS;
+	if (rate > 0)
+		arrivalRate = rate;
+}
+
+void WorkloadGenerator::setDiurnal(double rate, int period, double peak)
+{
+	arrivals = DIURNAL_ARRIVALS;
+	if (rate > 0)
+		arrivalRate = rate;
+	if (period > 0)
+		dayLength = period;
+
+	//the rate is a cosine around its mean, it can't go below zero
+	peakFactor = (peak < 1) ? 1 : (peak > 2) ? 2 : peak;
+}
+
+void WorkloadGenerator::setBursts(double rate, int period, int size)
+{
+	arrivals = BURST_ARRIVALS;
+	if (rate > 0)
+		arrivalRate = rate;
+	if (period > 0)
+		burstEvery = period;
+	burstSize = (size >= 0) ? size : 0;
+}
+
+void WorkloadGenerator::setPunctuality(int early, int late, int maxEarly, int maxLate)
+{
+	earlyPercent = (early <= 100 && early >= 0) ? early : 0;
+	latePercent = (late <= 100 - earlyPercent && late >= 0) ? late : 100 - earlyPercent;
+	maxEarliness = (maxEarly > 0) ? maxEarly : 1;
+	maxLateness = (maxLate > 0) ? maxLate : 1;
+}
+
+void WorkloadGenerator::setTreatmentCount(int minimum, int maximum)
+{
+	minTreatments = (minimum >= 1 && minimum <= 3) ? minimum : 1;
+	maxTreatments = (maximum >= minTreatments && maximum <= 3) ? maximum : 3;
+}
+
+void WorkloadGenerator::setTreatmentProfile(char type, const TreatmentProfile& profile)
+{
+	for (int i = 0; i < 3; i++)
+	{
+		if (TreatmentLetters[i] != type)
+			continue;
+
+		TreatmentProfile& p = profiles[i];
+		p.weight = (profile.weight >= 0) ? profile.weight : 0;
+		p.minDuration = (profile.minDuration > 0) ? profile.minDuration : 1;
+		p.maxDuration = (profile.maxDuration >= p.minDuration) ? profile.maxDuration : p.minDuration;
+		p.meanDuration = (profile.meanDuration < p.minDuration) ? p.minDuration
+			: (profile.meanDuration > p.maxDuration) ? p.maxDuration : profile.meanDuration;
+	}
+}
+
+void WorkloadGenerator::setDurationDistribution(DurationDistribution distribution) { durations = distribution; }
+
+void WorkloadGenerator::setSeed(unsigned long long randomSeed) { seed = randomSeed; }
+
+bool WorkloadGenerator::SetOption(const string& option)
+{
+	size_t equal = option.find('=');
+	if (equal == string::npos)
+		return false;
+
+	string key = option.substr(0, equal);
+	string value = option.substr(equal + 1);
+	const char* text = value.c_str();
+	int a = 0, b = 0, c = 0, d = 0;
+
+	if (key == "patients")          setPatients(atoi(text), recoveringPercent);
+	else if (key == "recovering")   setPatients(patients, atoi(text));
+	else if (key == "E")            setDevices(atoi(text), numU, numX, minRoomCapacity, maxRoomCapacity);
+	else if (key == "U")            setDevices(numE, atoi(text), numX, minRoomCapacity, maxRoomCapacity);
+	else if (key == "X")            setDevices(numE, numU, atoi(text), minRoomCapacity, maxRoomCapacity);
+	else if (key == "pcancel")      setProbabilities(atoi(text), pResc, pFreeFailure, pBusyFailure);
+	else if (key == "presc")        setProbabilities(pCancel, atoi(text), pFreeFailure, pBusyFailure);
+	else if (key == "pfreefail")    setProbabilities(pCancel, pResc, atoi(text), pBusyFailure);
+	else if (key == "pbusyfail")    setProbabilities(pCancel, pResc, pFreeFailure, atoi(text));
+	else if (key == "rate")         arrivalRate = (atof(text) > 0) ? atof(text) : arrivalRate;
+	else if (key == "day")          dayLength = (atoi(text) > 0) ? atoi(text) : dayLength;
+	else if (key == "peak")         peakFactor = (atof(text) < 1) ? 1 : (atof(text) > 2) ? 2 : atof(text);
+	else if (key == "burstevery")   burstEvery = (atoi(text) > 0) ? atoi(text) : burstEvery;
+	else if (key == "burstsize")    burstSize = (atoi(text) >= 0) ? atoi(text) : burstSize;
+	else if (key == "early")        setPunctuality(atoi(text), latePercent, maxEarliness, maxLateness);
+	else if (key == "late")         setPunctuality(earlyPercent, atoi(text), maxEarliness, maxLateness);
+	else if (key == "maxearly")     setPunctuality(earlyPercent, latePercent, atoi(text), maxLateness);
+	else if (key == "maxlate")      setPunctuality(earlyPercent, latePercent, maxEarliness, atoi(text));
+	else if (key == "seed")         setSeed(strtoull(text, nullptr, 10));
+	else if (key == "capacity")
+	{
+		if (sscanf(text, "%d:%d", &a, &b) != 2)
+			return false;
+		setDevices(numE, numU, numX, a, b);
+	}
+	else if (key == "treatments")
+	{
+		if (sscanf(text, "%d:%d", &a, &b) != 2)
+			return false;
+		setTreatmentCount(a, b);
+	}
+	else if (key == "durE" || key == "durU" || key == "durX")
+	{
+		if (sscanf(text, "%d:%d:%d:%d", &a, &b, &c, &d) != 4)
+			return false;
+		setTreatmentProfile(key[3], { a, b, c, d });
+	}
+	else if (key == "arrivals")
+	{
+		if (value == "poisson")
+			arrivals = POISSON_ARRIVALS;
+		else if (value == "diurnal")
+			arrivals = DIURNAL_ARRIVALS;
+		else if (value == "burst")
+			arrivals = BURST_ARRIVALS;
+		else
+			return false;
+	}
+	else if (key == "durations")
+	{
+		if (value == "uniform")
+			durations = UNIFORM_DURATION;
+		else if (value == "exponential")
+			durations = EXPONENTIAL_DURATION;
+		else
+			return false;
+	}
+	else
+		return false;
+
+	return true;
+}
+
+int WorkloadGenerator::Between(int low, int high)
+{
+	return low + rng.Next(high - low + 1);
+}
+
+double WorkloadGenerator::Exponential(double mean)
+{
+	return -mean * log(1.0 - rng.NextDouble());
+}
+
+double WorkloadGenerator::DiurnalRate(double time) const
+{
+	//lowest at the start of the day, highest at mid-day, the mean over a day is arrivalRate
+	const double twoPi = 6.283185307179586;
+	return arrivalRate * (1.0 - (peakFactor - 1.0) * cos(twoPi * time / dayLength));
+}
+
+double WorkloadGenerator::NextArrival(double time)
+{
+	if (arrivals != DIURNAL_ARRIVALS)
+		return time + Exponential(1.0 / arrivalRate);
+
+	//thinning: candidates at the peak rate, each kept with the ratio of the current rate to the peak
+	double peakRate = arrivalRate * peakFactor;
+	do
+	{
+		time += Exponential(1.0 / peakRate);
+	} while (rng.NextDouble() * peakRate > DiurnalRate(time));
+
+	return time;
+}
+
+int WorkloadGenerator::Duration(int type)
+{
+	const TreatmentProfile& p = profiles[type];
+	if (durations == UNIFORM_DURATION)
+		return Between(p.minDuration, p.maxDuration);
+
+	//exponential tail above the minimum, cut at the maximum
+	double duration = p.minDuration + Exponential(p.meanDuration - p.minDuration);
+	return (duration >= p.maxDuration) ? p.maxDuration : (int)(duration + 0.5);
+}
+
+void WorkloadGenerator::WritePatient(BufferedWriter& writer, int arrivalTime)
+{
+	// type and appointment time
+	bool recovering = rng.Next(100) < recoveringPercent;
+
+	int appointmentTime = arrivalTime;
+	int punctuality = rng.Next(100);
+	if (punctuality < earlyPercent)
+		appointmentTime = arrivalTime + Between(1, maxEarliness);
+	else if (punctuality < earlyPercent + latePercent)
+		appointmentTime = arrivalTime - Between(1, maxLateness);
+	if (appointmentTime < 0)
+		appointmentTime = 0;
+
+	// treatments, each type at most once, picked by weight without replacement
+	int weights[3] = { profiles[0].weight, profiles[1].weight, profiles[2].weight };
+	int available = (weights[0] > 0) + (weights[1] > 0) + (weights[2] > 0);
+	int count = Between(minTreatments, maxTreatments);
+	if (count > available)
+		count = available;
+
+	writer.Put(recovering ? 'R' : 'N');
+	writer.Put(' ');
+	writer.Put(appointmentTime);
+	writer.Put(' ');
+	writer.Put(arrivalTime);
+	writer.Put(' ');
+	writer.Put(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		int pick = rng.Next(weights[0] + weights[1] + weights[2]);
+		int type = 0;
+		while (pick >= weights[type])
+			pick -= weights[type++];
+		weights[type] = 0;
+
+		writer.Put(' ');
+		writer.Put(TreatmentLetters[type]);
+		writer.Put(' ');
+		writer.Put(Duration(type));
+	}
+	writer.Put('\n');
+}
+
+bool WorkloadGenerator::Generate(const string& fileName)
+{
+	BufferedWriter writer;
+	if (!writer.Open(fileName + ".txt"))
+	{
+		cout << "Error: Unable to create file " << fileName << ".txt" << endl;
+		return false;
+	}
+
+	rng.setSeed(seed);
+
+	// Step 1: resources
+	writer.Put(numE);
+	writer.Put(' ');
+	writer.Put(numU);
+	writer.Put(' ');
+	writer.Put(numX);
+	writer.Put('\n');
+	for (int i = 0; i < numX; i++)
+	{
+		if (i)
+			writer.Put(' ');
+		writer.Put(Between(minRoomCapacity, maxRoomCapacity));
+	}
+	writer.Put('\n');
+
+	// Step 2: probabilities
+	writer.Put(pCancel);
+	writer.Put(' ');
+	writer.Put(pResc);
+	writer.Put(' ');
+	writer.Put(pFreeFailure);
+	writer.Put(' ');
+	writer.Put(pBusyFailure);
+	writer.Put('\n');
+
+	// Step 3: patients, in increasing arrival time
+	writer.Put(patients);
+	writer.Put('\n');
+
+	double time = 0;
+	double nextBurst = burstEvery;
+	int written = 0;
+	while (written < patients)
+	{
+		double next = NextArrival(time);
+
+		//a burst comes first if it is due before the next single arrival (arrivals are memoryless,
+		//so drawing again from the burst time keeps the Poisson process intact)
+		if (arrivals == BURST_ARRIVALS && nextBurst <= next)
+		{
+			for (int i = 0; i < burstSize && written < patients; i++, written++)
+				WritePatient(writer, (int)nextBurst);
+			time = nextBurst;
+			nextBurst += burstEvery;
+			continue;
+		}
+
+		WritePatient(writer, (int)next);
+		time = next;
+		written++;
+	}
+
+	if (!writer.Close())
+	{
+		cout << "Error: Failed to write file " << fileName << ".txt" << endl;
+		return false;
+	}
+	return true;
+}
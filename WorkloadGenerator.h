@@ -0,0 +1,143 @@
+/**
+ * @file WorkloadGenerator.h
+ * @brief Writes synthetic input files (the Load format, sorted by arrival) for large benchmark runs.
+ *
+ * A workload is described by:
+ * - the number of patients and the percentage of recovering (R) patients,
+ * - the arrival process: Poisson with a constant rate, diurnal (the rate follows a daily
+ *   cosine around its mean, highest at mid-day) or bursts (Poisson plus a group of patients
+ *   arriving together at a fixed period),
+ * - the percentages of early and late patients and how early/late they may be,
+ * - the number of treatments per patient, the weight of each treatment type and the
+ *   duration range of each type, drawn uniformly or exponentially around a mean,
+ * - the device and gym room counts and the four probabilities of the input header.
+ *
+ * Equal settings and seeds always give the same file. Patients are formatted straight into a
+ * BufferedWriter, ten million patients take a few seconds.
+ *
+ * @author Seif
+ * @date October 2026
+ */
+#pragma once
+#include <string>
+#include "RandomGenerator.h"
+using namespace std;
+
+class BufferedWriter;
+
+/** @enum ArrivalProcess
+ *  How arrival times are spread over time.
+ */
+enum ArrivalProcess { POISSON_ARRIVALS, DIURNAL_ARRIVALS, BURST_ARRIVALS };
+
+/** @enum DurationDistribution
+ *  How treatment durations are drawn from a TreatmentProfile.
+ */
+enum DurationDistribution { UNIFORM_DURATION, EXPONENTIAL_DURATION };
+
+/**
+ * @struct TreatmentProfile
+ * @brief Share and durations of one treatment type.
+ */
+struct TreatmentProfile
+{
+    int weight;         ///< Relative chance of the type being required (0 = never)
+    int minDuration;    ///< Shortest duration
+    int meanDuration;   ///< Mean duration (exponential distribution only)
+    int maxDuration;    ///< Longest duration
+};
+
+/**
+ * @class WorkloadGenerator
+ * @brief Generates one input file from a set of workload settings.
+ */
+class WorkloadGenerator
+{
+private:
+    int patients;                       ///< Number of patients to write
+    int recoveringPercent;              ///< Percentage of R patients
+
+    int numE;                           ///< Number of E devices
+    int numU;                           ///< Number of U devices
+    int numX;                           ///< Number of gym rooms
+    int minRoomCapacity;                ///< Smallest gym room capacity
+    int maxRoomCapacity;                ///< Largest gym room capacity
+
+    int pCancel;                        ///< Cancellation probability written to the header
+    int pResc;                          ///< Rescheduling probability written to the header
+    int pFreeFailure;                   ///< Free device failure probability written to the header
+    int pBusyFailure;                   ///< Busy device failure probability written to the header
+
+    ArrivalProcess arrivals;            ///< Arrival process
+    double arrivalRate;                 ///< Mean arrivals per time step
+    int dayLength;                      ///< Period of the diurnal rate in time steps
+    double peakFactor;                  ///< Diurnal peak rate over the mean rate, in [1, 2]
+    int burstEvery;                     ///< Time steps between two bursts
+    int burstSize;                      ///< Patients arriving together in one burst
+
+    int earlyPercent;                   ///< Percentage of patients arriving before their appointment
+    int latePercent;                    ///< Percentage of patients arriving after their appointment
+    int maxEarliness;                   ///< Most time steps a patient may be early
+    int maxLateness;                    ///< Most time steps a patient may be late
+
+    int minTreatments;                  ///< Fewest treatments per patient (at least 1)
+    int maxTreatments;                  ///< Most treatments per patient (at most 3)
+    TreatmentProfile profiles[3];       ///< E, U and X treatment profiles
+    DurationDistribution durations;     ///< How durations are drawn
+
+    unsigned long long seed;            ///< Seed of the generated file
+    RandomGenerator rng;                ///< Random source, restarted from the seed for every file
+
+    /** @brief Random integer in [low, high]. */
+    int Between(int low, int high);
+
+    /** @brief Random exponential value with the given mean. */
+    double Exponential(double mean);
+
+    /** @brief Arrival rate at a time for the diurnal process. */
+    double DiurnalRate(double time) const;
+
+    /** @brief Continuous time of the next Poisson (or diurnal) arrival after a time. */
+    double NextArrival(double time);
+
+    /** @brief Draws one treatment duration of a type (0 = E, 1 = U, 2 = X). */
+    int Duration(int type);
+
+    /** @brief Draws and writes one patient line arriving at the given time step. */
+    void WritePatient(BufferedWriter& writer, int arrivalTime);
+
+public:
+    /** @brief Constructs a generator with a small default workload (Poisson, 1000 patients). */
+    WorkloadGenerator();
+
+    void setPatients(int count, int recovering);                    ///< Number of patients and percentage of R patients
+    void setDevices(int E, int U, int X, int minCapacity, int maxCapacity); ///< Device counts and gym room capacity range
+    void setProbabilities(int cancel, int resc, int freeFail, int busyFail); ///< Probabilities of the input header
+    void setPoisson(double rate);                                   ///< Poisson arrivals with a mean rate per time step
+    void setDiurnal(double rate, int period, double peak);          ///< Daily varying arrivals around a mean rate
+    void setBursts(double rate, int period, int size);              ///< Poisson arrivals plus periodic bursts
+    void setPunctuality(int early, int late, int maxEarly, int maxLate); ///< Early/late percentages and spreads
+    void setTreatmentCount(int minimum, int maximum);               ///< Treatments per patient, within [1, 3]
+    void setTreatmentProfile(char type, const TreatmentProfile& profile); ///< Profile of the E, U or X treatment
+    void setDurationDistribution(DurationDistribution distribution); ///< How durations are drawn
+    void setSeed(unsigned long long randomSeed);                    ///< Seed of the generated file
+
+    /**
+     * @brief Applies one "key=value" command line option.
+     *
+     * Keys: patients, recovering, E, U, X, capacity (min:max), pcancel, presc, pfreefail,
+     * pbusyfail, arrivals (poisson | diurnal | burst), rate, day, peak, burstevery, burstsize,
+     * early, late, maxearly, maxlate, treatments (min:max), durE / durU / durX
+     * (weight:min:mean:max), durations (uniform | exponential), seed.
+     *
+     * @return false if the option is unknown or its value can't be read.
+     */
+    bool SetOption(const string& option);
+
+    /**
+     * @brief Writes the workload to a file.
+     * @param fileName Name of the file (excluding the .txt extension).
+     * @return false if the file could not be written.
+     */
+    bool Generate(const string& fileName);
+};
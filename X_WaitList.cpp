@@ -3,12 +3,15 @@
 #include <assert.h>
 
 
-bool X_WaitList::RandomCancel(Schedular& hospitalsystem)
+template <class Policy>
+bool X_WaitList::RandomCancel(BasicSchedular<Policy>& hospitalsystem)
 {
+	typename Policy::Instrumentation::Scope profile(PROFILE_RANDOM_CANCEL);
+
 	int pCancel = hospitalsystem.getpCancel();
 
 	//before any thing, just check if we should cancel or not
-	int probability = rand() % 100;
+	int probability = hospitalsystem.getRandomGenerator().Next(100);
 
 	if (probability >= pCancel)
 		return false;
@@ -26,20 +29,11 @@ bool X_WaitList::RandomCancel(Schedular& hospitalsystem)
 		//inspect the patient
 		dequeue(_to_cancel);
 
-		//get copy of the patient treatment list (is it a copy?)
-		LinkedQueue <Treatment*> _this_patient_Tlist = _to_cancel->getRemainingTreatments();
-
-		Treatment* _next_treatment = nullptr;
-
-		//this first dequeue is sure to be X treatment (no need to process it)
-		_this_patient_Tlist.dequeue(_next_treatment);
-
-		assert(_next_treatment && "shallow copy");
+		//the first treatment is sure to be X treatment (no need to process it)
+		assert(_to_cancel->getNextTreatment() && "no treatment left");
 
 		//check this patient has no more treatments after the X_treatment
-		Treatment* _this_isnt_last_treatment = nullptr;
-
-		if (_this_patient_Tlist.peek(_this_isnt_last_treatment))
+		if (_to_cancel->getNumber_RemainingTreatment() > 1)
 		{
 			temp.enqueue(_to_cancel);
 			continue; //move on to another patient in the waiting list
@@ -82,4 +76,7 @@ bool X_WaitList::RandomCancel(Schedular& hospitalsystem)
 
 	return cancelled_successfully;
 
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_RANDOM_CANCEL(Policy) template bool X_WaitList::RandomCancel(BasicSchedular<Policy>&);
+SCHEDULAR_POLICIES(INSTANTIATE_RANDOM_CANCEL)
@@ -1,6 +1,6 @@
 #pragma once
 #include "EU_WaitList.h"
-class Schedular;
+#include "SchedularFwd.h"
 /**
  * @class X_WaitList
  * @brief Represents a waiting list for patients, allowing random cancellation based on probability.
@@ -17,6 +17,7 @@ public:
      * @param hospitalsystem Reference to the Schedular instance to get cancellation probability and update patient status.
      * @return true if a patient was successfully cancelled, false otherwise.
      */
-    bool RandomCancel(Schedular& hospitalsystem);
+    template <class Policy>
+    bool RandomCancel(BasicSchedular<Policy>& hospitalsystem);
 };
 
@@ -1,8 +1,21 @@
 #include "UI.h"
 #include "Load.h"
 #include "Output.h"
+#include "Profiler.h"
 
+//choose the program to build here, or define one of the modes from the build system
+//#define CAPACITY_OPTIMIZATION
+//#define STREAMED_SIMULATION
+//#define PARSE_BENCHMARK
+//#define ROSTER_CONVERTER
+//#define WORKLOAD_GENERATOR
+//#define CONTAINER_BENCHMARK
+//#define SIMULATION_BENCHMARK
+//#define EVENT_LOG_READER
+#if !defined(CAPACITY_OPTIMIZATION) && !defined(STREAMED_SIMULATION) && !defined(PARSE_BENCHMARK) && !defined(ROSTER_CONVERTER) \
+	&& !defined(WORKLOAD_GENERATOR) && !defined(CONTAINER_BENCHMARK) && !defined(SIMULATION_BENCHMARK) && !defined(EVENT_LOG_READER)
 #define FINAL_SIMULATION
+#endif
 #define MAX_NEW_APP_ACCEPTANCE_TIME 100
 
 
@@ -10,11 +23,11 @@
 
 int main()
 {
-	//call the srand function and give it the seed once
-	srand(RANDOM_ARGUMENT);
-
 	Schedular hospitalSystem;
 
+	//seed the random generator of this simulation once
+	hospitalSystem.setSeed(RANDOM_ARGUMENT);
+
 	Load loader("Miscellinious_Test_2");
 
 	// Load data from file into hospitalSystem
@@ -32,14 +45,7 @@ int main()
 			cout << endl << endl;
 		}
 		// Core processing sequence
-		hospitalSystem.CheckMaintainanceList();
-		hospitalSystem.MoveToNextTreatment();
-
-		hospitalSystem.CheckAllPatientList();
-		hospitalSystem.CheckInterrupted();
-		hospitalSystem.EarlyToWait();
-		hospitalSystem.LateToWait();
-		hospitalSystem.WaitToTreatment();
+		hospitalSystem.SimulateTimeStep();
 
 		UI::DisplaySystemStatus(hospitalSystem);
 
@@ -54,6 +60,7 @@ int main()
 
 	// ====================== Final Status Report ======================
 	UI::DisplayFinalPatient(hospitalSystem);
+	hospitalSystem.printUtilization(cout);
 
 	// ====================== Generate Output File ======================
 	Output outputHandler("Miscellinious_Test_2_output.txt");
@@ -61,7 +68,427 @@ int main()
 
 	cout << "\nOutput file 'Miscellinious_Test_2_output.txt' has been generated successfully.\n";
 
+	//empty unless built with PHASE_PROFILING=1
+	Profiler::PrintSummary(cout);
+
 	return 0;
 }
 
 #endif // end FINAL_SIMULATION
+
+#ifdef CAPACITY_OPTIMIZATION
+#include "CapacityOptimizer.h"
+
+//usage : <input file without .txt> <avg | p95> <target wait> [max E] [max U] [max rooms] [max room capacity]
+int main(int argc, char* argv[])
+{
+	string fileName = (argc > 1) ? argv[1] : "Miscellinious_Test_2";
+	SLOMetric metric = (argc > 2 && string(argv[2]) == "p95") ? P95_WAIT : AVERAGE_WAIT;
+	double target = (argc > 3) ? atof(argv[3]) : 5;
+
+	CapacityConfig lower = { 1, 1, 1, 1 };
+	CapacityConfig upper = { 10, 10, 5, 10 };
+	if (argc > 7)
+	{
+		upper = { atoi(argv[4]), atoi(argv[5]), atoi(argv[6]), atoi(argv[7]) };
+	}
+
+	CapacityOptimizer optimizer(fileName, metric, target);
+	optimizer.setSearchBounds(lower, upper);
+	optimizer.setSeed(RANDOM_ARGUMENT);
+
+	cout << "===== Capacity Optimization =====" << endl;
+	cout << "Target : " << (metric == AVERAGE_WAIT ? "average" : "p95") << " wait <= " << target << endl;
+
+	CandidateResult best;
+	if (!optimizer.Optimize(best))
+	{
+		cout << "No configuration within the search bounds meets the target." << endl;
+		return 1;
+	}
+
+	cout << "Cheapest configuration : "
+		<< best.config.numE << " E devices, "
+		<< best.config.numU << " U devices, "
+		<< best.config.numX << " gym rooms of capacity " << best.config.gymCapacity << endl;
+	cout << "Cost = " << optimizer.getCost(best.config)
+		<< " | Average wait = " << best.avgWait
+		<< " | p95 wait = " << best.p95Wait
+		<< " | Time steps = " << best.timeSteps << endl;
+	cout << "Simulations run = " << optimizer.getSimulationsRun() << endl;
+
+	return 0;
+}
+
+#endif // end CAPACITY_OPTIMIZATION
+
+#ifdef STREAMED_SIMULATION
+#include "PatientStream.h"
+#include "Telemetry.h"
+
+//usage : <input file without .txt, sorted by arrival time> [look ahead time steps] [text | csv | columnar]
+//        [telemetry file (.csv or binary) | -] [time steps between telemetry samples] [event log file]
+int main(int argc, char* argv[])
+{
+	string fileName = (argc > 1) ? argv[1] : "Miscellinious_Test_2";
+	int lookAhead = (argc > 2) ? atoi(argv[2]) : 50;
+	OutputFormat format = ResultWriter::FormatFromName((argc > 3) ? argv[3] : "text");
+	string telemetryFile = (argc > 4 && string(argv[4]) != "-") ? argv[4] : "";
+	int sampleEvery = (argc > 5) ? atoi(argv[5]) : 1;
+	string eventLogFile = (argc > 6) ? argv[6] : "";
+
+	Schedular hospitalSystem;
+	hospitalSystem.setSeed(RANDOM_ARGUMENT);
+
+	//rows are written as patients finish, then the patients are deleted
+	string outputFile = fileName + "_output" + ResultWriter::ExtensionOf(format);
+	ResultWriter results;
+	if (!results.Open(outputFile, format))
+	{
+		cout << "Error: Could not create output file " << outputFile << endl;
+		return 1;
+	}
+	results.setFlushEvery(1024);
+	hospitalSystem.setOutputSink(&results);
+
+	//queue depths of the most recent time steps, exported once the run ended
+	Telemetry telemetry(1 << 18, sampleEvery);
+	if (!telemetryFile.empty())
+		hospitalSystem.setTelemetry(&telemetry);
+
+	//every transition, replayable with the event log reader
+	EventLog eventLog;
+	if (!eventLogFile.empty())
+	{
+		if (!eventLog.Open(eventLogFile))
+		{
+			cout << "Error: Could not create event log " << eventLogFile << endl;
+			return 1;
+		}
+		hospitalSystem.setEventLog(&eventLog);
+	}
+
+	//patients are read in the background and created only when they arrive
+	PatientStream stream(fileName, lookAhead);
+	if (!stream.Open(hospitalSystem))
+		return 1;
+
+	cout << "===== Streamed Simulation =====" << endl;
+	while (!hospitalSystem.SimulationEnded())
+	{
+		hospitalSystem.SimulateTimeStep();
+		hospitalSystem.IncrementTime();
+	}
+
+	results.WriteStatistics(hospitalSystem);
+	if (!results.Close())
+		cout << "Error: Could not write output file " << outputFile << endl;
+
+	cout << "Patients = " << hospitalSystem.getTotalPatients()
+		<< " | Time steps = " << hospitalSystem.getCurrentTime() << endl;
+	cout << "Output file '" << outputFile << "' has been generated successfully." << endl;
+	hospitalSystem.printUtilization(cout);
+
+	if (!telemetryFile.empty())
+	{
+		bool csv = telemetryFile.size() > 4 && telemetryFile.compare(telemetryFile.size() - 4, 4, ".csv") == 0;
+		if (csv ? telemetry.ExportCsv(telemetryFile) : telemetry.ExportBinary(telemetryFile))
+			cout << "Telemetry: " << telemetry.getCount() << " samples (" << telemetry.getDropped()
+				<< " overwritten) written to '" << telemetryFile << "'" << endl;
+	}
+	if (!eventLogFile.empty())
+	{
+		if (eventLog.Close())
+			cout << "Event log: " << eventLog.getEventCount() << " events written to '" << eventLogFile << "'" << endl;
+		else
+			cout << "Error: Could not write event log " << eventLogFile << endl;
+	}
+	Profiler::PrintSummary(cout);
+
+	return 0;
+}
+
+#endif // end STREAMED_SIMULATION
+
+#ifdef PARSE_BENCHMARK
+#include "BinaryRoster.h"
+#include "MappedFile.h"
+#include "TextScanner.h"
+#include <chrono>
+#include <cstdio>
+
+//reads every token of an input file without creating anything, returns a checksum so nothing is optimised away
+template <typename Input>
+long long ParseOnly(Input& inFile)
+{
+	long long checksum = 0;
+	int numE = 0, numU = 0, numX = 0, value = 0, numPatients = 0;
+	char type = 0;
+
+	inFile >> numE >> numU >> numX;
+	checksum += numE + numU + numX;
+	for (int i = 0; i < numX && inFile >> value; i++)
+		checksum += value;
+	for (int i = 0; i < 4 && inFile >> value; i++)
+		checksum += value;
+
+	inFile >> numPatients;
+	for (int i = 0; i < numPatients; i++)
+	{
+		int PT = 0, VT = 0, numTreatments = 0;
+		if (!(inFile >> type >> PT >> VT >> numTreatments))
+			break;
+		checksum += type + PT + VT;
+		for (int j = 0; j < numTreatments && inFile >> type >> value; j++)
+			checksum += type + value;
+	}
+	return checksum;
+}
+
+//times one run of a function in seconds
+template <typename Function>
+double Seconds(Function run)
+{
+	auto start = chrono::steady_clock::now();
+	run();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//usage : <input file without .txt> [repetitions]
+int main(int argc, char* argv[])
+{
+	string fileName = (argc > 1) ? argv[1] : "Miscellinious_Test_2";
+	int repetitions = (argc > 2) ? atoi(argv[2]) : 5;
+	if (repetitions < 1)
+		repetitions = 1;
+
+	MappedFile probe;
+	if (!probe.Open(fileName + ".txt"))
+	{
+		cout << "Error: Unable to open file " << fileName << ".txt" << endl;
+		return 1;
+	}
+	double gigabytes = probe.getSize() / 1e9;
+	probe.Close();
+
+	//the roster is converted once, outside the timing, and removed at the end
+	bool hasRoster = BinaryRoster::ConvertToBinary(fileName + ".txt", fileName + ".bin");
+
+	//best of n runs, the first run also warms the page cache
+	double streamParse = 1e30, mappedParse = 1e30, streamLoad = 1e30, mappedLoad = 1e30, rosterLoad = 1e30;
+	long long streamSum = 0, mappedSum = 0;
+
+	for (int r = 0; r < repetitions; r++)
+	{
+		streamParse = min(streamParse, Seconds([&]()
+		{
+			ifstream inFile(fileName + ".txt", ios::in);
+			streamSum = ParseOnly(inFile);
+		}));
+
+		mappedParse = min(mappedParse, Seconds([&]()
+		{
+			MappedFile inMap;
+			inMap.Open(fileName + ".txt");
+			TextScanner inFile(inMap.begin(), inMap.end());
+			mappedSum = ParseOnly(inFile);
+		}));
+
+		streamLoad = min(streamLoad, Seconds([&]()
+		{
+			Schedular hospitalSystem;
+			Load(fileName).LoadDataFromFile(hospitalSystem);
+		}));
+
+		mappedLoad = min(mappedLoad, Seconds([&]()
+		{
+			Schedular hospitalSystem;
+			Load(fileName).LoadDataFromMappedFile(hospitalSystem);
+		}));
+
+		if (hasRoster)
+		{
+			rosterLoad = min(rosterLoad, Seconds([&]()
+			{
+				Schedular hospitalSystem;
+				Load(fileName).LoadDataFromRoster(hospitalSystem);
+			}));
+		}
+	}
+
+	if (hasRoster)
+		remove((fileName + ".bin").c_str());
+
+	if (streamSum != mappedSum)
+		cout << "Error: The two parsers read different values (" << streamSum << " vs " << mappedSum << ")" << endl;
+
+	cout << "===== Parse Benchmark : " << fileName << ".txt (" << gigabytes * 1000 << " MB, best of " << repetitions << ") =====" << endl;
+	cout << "parse only, ifstream      : " << streamParse << " s | " << gigabytes / streamParse << " GB/s" << endl;
+	cout << "parse only, mmap+scanner  : " << mappedParse << " s | " << gigabytes / mappedParse << " GB/s"
+		<< " | x" << streamParse / mappedParse << endl;
+	cout << "full load, ifstream       : " << streamLoad << " s | " << gigabytes / streamLoad << " GB/s" << endl;
+	cout << "full load, mmap+scanner   : " << mappedLoad << " s | " << gigabytes / mappedLoad << " GB/s"
+		<< " | x" << streamLoad / mappedLoad << endl;
+	if (hasRoster)
+		cout << "full load, mmap roster    : " << rosterLoad << " s | " << gigabytes / rosterLoad << " GB/s of text"
+			<< " | x" << streamLoad / rosterLoad << endl;
+	else
+		cout << "full load, mmap roster    : no roster form for this input" << endl;
+
+	return 0;
+}
+
+#endif // end PARSE_BENCHMARK
+
+#ifdef ROSTER_CONVERTER
+#include "BinaryRoster.h"
+
+//usage : <to-bin | to-txt> <input file> <output file>
+int main(int argc, char* argv[])
+{
+	if (argc < 4)
+	{
+		cout << "usage : " << argv[0] << " <to-bin | to-txt> <input file> <output file>" << endl;
+		return 1;
+	}
+
+	string direction = argv[1];
+	bool converted = false;
+
+	if (direction == "to-bin")
+		converted = BinaryRoster::ConvertToBinary(argv[2], argv[3]);
+	else if (direction == "to-txt")
+		converted = BinaryRoster::ConvertToText(argv[2], argv[3]);
+	else
+		cout << "Error: Unknown conversion " << direction << endl;
+
+	if (!converted)
+		return 1;
+
+	cout << argv[2] << " -> " << argv[3] << endl;
+	return 0;
+}
+
+#endif // end ROSTER_CONVERTER
+
+#ifdef WORKLOAD_GENERATOR
+#include "WorkloadGenerator.h"
+#include <chrono>
+
+//usage : <output file without .txt> [key=value ...], see WorkloadGenerator::SetOption for the keys
+int main(int argc, char* argv[])
+{
+	string fileName = (argc > 1) ? argv[1] : "Generated_Workload";
+
+	WorkloadGenerator generator;
+	for (int i = 2; i < argc; i++)
+	{
+		if (!generator.SetOption(argv[i]))
+		{
+			cout << "Error: Invalid option " << argv[i] << endl;
+			return 1;
+		}
+	}
+
+	auto start = chrono::steady_clock::now();
+	if (!generator.Generate(fileName))
+		return 1;
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << "File '" << fileName << ".txt' generated in " << seconds << " s" << endl;
+	return 0;
+}
+
+#endif // end WORKLOAD_GENERATOR
+
+#ifdef CONTAINER_BENCHMARK
+#include "ContainerBenchmark.h"
+
+//usage : [json result file] [largest size] [seconds per operation and size]
+int main(int argc, char* argv[])
+{
+	string jsonFile = (argc > 1) ? argv[1] : "container_benchmark.json";
+	int largest = (argc > 2) ? atoi(argv[2]) : 1000000;
+	double budget = (argc > 3) ? atof(argv[3]) : 0.5;
+
+	vector<int> sizes;
+	for (int size = 100; size <= largest && size > 0; size *= 10)
+		sizes.push_back(size);
+
+	ContainerBenchmark benchmark;
+	benchmark.setSizes(sizes);
+	benchmark.setTimeBudget(budget);
+
+	cout << "===== Container Benchmark =====" << endl;
+	benchmark.Run();
+
+	if (!benchmark.ExportJson(jsonFile))
+		return 1;
+	cout << "Results written to '" << jsonFile << "'" << endl;
+	return 0;
+}
+
+#endif // end CONTAINER_BENCHMARK
+
+#ifdef SIMULATION_BENCHMARK
+#include "SimulationBenchmark.h"
+
+//usage : [result json] [baseline json or -] [tolerance %] [largest scenario in patients] [variant or all]
+//returns 2 if a scenario regressed against the baseline or failed its allocation or checkpoint check
+int main(int argc, char* argv[])
+{
+	string resultFile = (argc > 1) ? argv[1] : "simulation_benchmark.json";
+	string baselineFile = (argc > 2) ? argv[2] : "-";
+	double tolerance = (argc > 3) ? atof(argv[3]) / 100 : 0.10;
+	int largest = (argc > 4) ? atoi(argv[4]) : 100000;
+	string variant = (argc > 5) ? argv[5] : "all";
+
+	SimulationBenchmark benchmark;
+	benchmark.setLargestScenario(largest);
+	if (variant != "all" && !benchmark.setVariant(variant))
+		return 1;
+
+	cout << "===== Simulation Benchmark =====" << endl;
+	benchmark.Run();
+
+	if (!benchmark.ExportJson(resultFile))
+		return 1;
+	cout << "Results written to '" << resultFile << "'" << endl;
+
+	bool checked = benchmark.ChecksPassed();
+	if (baselineFile == "-")
+		return checked ? 0 : 2;
+
+	vector<ScenarioResult> baseline;
+	if (!SimulationBenchmark::ReadJson(baselineFile, baseline))
+		return 1;
+
+	cout << "===== Baseline '" << baselineFile << "', tolerance " << tolerance * 100 << " % =====" << endl;
+	return (benchmark.CompareWithBaseline(baseline, tolerance) && checked) ? 0 : 2;
+}
+
+#endif // end SIMULATION_BENCHMARK
+
+#ifdef EVENT_LOG_READER
+
+//usage : <event log file> [tick, -1 = end of the log] [verbose]
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		cout << "usage : " << argv[0] << " <event log file> [tick] [verbose]" << endl;
+		return 1;
+	}
+
+	int tick = (argc > 2) ? atoi(argv[2]) : -1;
+	bool verbose = (argc > 3) && string(argv[3]) == "verbose";
+
+	EventLogState state;
+	if (!EventLog::Replay(argv[1], tick, state))
+		return 1;
+
+	EventLog::PrintState(state, cout, verbose);
+	return 0;
+}
+
+#endif // end EVENT_LOG_READER
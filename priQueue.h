@@ -49,6 +49,34 @@ public:
         count++;
     }
 
+    //replaces the content with count items already sorted by priority, in O(count) instead of O(count^2)
+    //returns false (queue left unchanged) if the priorities are not in order
+    bool assignSorted(const T* items, const int* priorities, int count)
+    {
+        for (int i = 1; i < count; i++)
+        {
+            if (priorities[i] < priorities[i - 1])
+                return false;
+        }
+
+        T tmp;
+        int p;
+        while (dequeue(tmp, p));
+
+        priNode<T>* tail = nullptr;
+        for (int i = 0; i < count; i++)
+        {
+            priNode<T>* newNode = new priNode<T>(items[i], priorities[i]);
+            if (tail)
+                tail->setNext(newNode);
+            else
+                head = newNode;
+            tail = newNode;
+        }
+        this->count = count;
+        return true;
+    }
+
     //pri stores the priority of the dequeued item
     bool dequeue(T& topEntry, int& pri) {
         if (isEmpty())
@@ -98,6 +126,18 @@ public:
         }
     }
 
+    //calls visit(item, priority) for every node from front to back, without copying the queue
+    template <typename Visitor>
+    void Traverse(Visitor visit) const
+    {
+        for (priNode<T>* temp = head; temp; temp = temp->getNext())
+        {
+            int pri = 0;
+            T item = temp->getItem(pri);
+            visit(item, pri);
+        }
+    }
+
     // Copy constructor
     priQueue(const priQueue<T>& other) : head(nullptr), count(0) 
     {